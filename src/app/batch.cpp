@@ -0,0 +1,666 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    batch.cpp
+  \brief   Offline batch processing of recorded frames (vision-batch).
+  \author  Author Name, 2026
+*/
+//========================================================================
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <dirent.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <algorithm>
+#include <map>
+#include <dc1394/conversions.h>
+#include "qgetopt.h"
+#include "VarXML.h"
+#include "multistacks.h"
+#include "image_io.h"
+#include "rawframe_file.h"
+#include "robocup_ssl_packet_file.h"
+#include "realtime_manager.h"
+#include "timer.h"
+
+/*!
+  \class   BatchOutput
+  \brief   Writes the packets to a file and optionally keeps their detections in memory
+*/
+class BatchOutput : public RoboCupSSLPacketFile {
+protected:
+  QMutex frames_mutex;
+public:
+  typedef map<pair<int,long long>,SSL_DetectionFrame> FrameMap;
+  bool collect;
+  FrameMap frames; //by camera and frame number
+
+  BatchOutput() {
+    collect=false;
+  }
+
+  using RoboCupSSLServer::send;
+  virtual bool send(const SSL_WrapperPacket & packet) {
+    if (collect && packet.has_detection()) {
+      const SSL_DetectionFrame & d=packet.detection();
+      frames_mutex.lock();
+      frames[make_pair((int)d.camera_id(),(long long)d.frame_number())]=d;
+      frames_mutex.unlock();
+    }
+    return RoboCupSSLPacketFile::send(packet);
+  }
+  virtual bool send(const SSL_DetectionFrame & frame) {
+    if (collect) {
+      frames_mutex.lock();
+      frames[make_pair((int)frame.camera_id(),(long long)frame.frame_number())]=frame;
+      frames_mutex.unlock();
+    }
+    return RoboCupSSLPacketFile::send(frame);
+  }
+};
+
+/*!
+  \class   GoldenComparison
+  \brief   Compares detections against stored golden detections within tolerances
+
+  Robots are matched by team and id, balls by distance. The largest
+  deviations of all matched objects are kept whether or not they are within
+  the tolerances, so a run shows how far an optimization moved the output.
+*/
+class GoldenComparison {
+public:
+  double pos_tolerance;   //mm
+  double angle_tolerance; //radians
+  double conf_tolerance;
+
+  long long frames;
+  long long frames_missing; //golden frames without an output
+  long long frames_extra;   //outputs without a golden frame
+  long long frames_differ;
+  long long objects;
+  long long objects_missing;
+  long long objects_extra;
+  long long objects_out_of_tolerance;
+  double max_pos;
+  double max_angle;
+  double max_conf;
+
+  GoldenComparison() {
+    pos_tolerance=1.0;
+    angle_tolerance=M_PI/180.0;
+    conf_tolerance=0.01;
+    frames=frames_missing=frames_extra=frames_differ=0;
+    objects=objects_missing=objects_extra=objects_out_of_tolerance=0;
+    max_pos=max_angle=max_conf=0.0;
+  }
+
+  /// returns the number of differences
+  int compareRobots(const ::google::protobuf::RepeatedPtrField<SSL_DetectionRobot> & golden,
+                    const ::google::protobuf::RepeatedPtrField<SSL_DetectionRobot> & actual) {
+    int differences=0;
+    vector<bool> used(actual.size(),false);
+    for (int i=0;i<golden.size();i++) {
+      const SSL_DetectionRobot & g=golden.Get(i);
+      int best=-1;
+      double best_dist=0.0;
+      for (int j=0;j<actual.size();j++) {
+        const SSL_DetectionRobot & a=actual.Get(j);
+        if (used[j] || a.has_robot_id()!=g.has_robot_id() || a.robot_id()!=g.robot_id()) continue;
+        double d=sqrt(sq(a.x()-g.x())+sq(a.y()-g.y()));
+        if (best==-1 || d < best_dist) {
+          best=j;
+          best_dist=d;
+        }
+      }
+      objects++;
+      if (best==-1) {
+        objects_missing++;
+        differences++;
+        continue;
+      }
+      used[best]=true;
+      const SSL_DetectionRobot & a=actual.Get(best);
+      double d_angle=0.0;
+      bool angle_ok=(a.has_orientation()==g.has_orientation());
+      if (angle_ok && g.has_orientation()) {
+        d_angle=fabs(angle_mod(a.orientation()-g.orientation()));
+        angle_ok=(d_angle <= angle_tolerance);
+      }
+      double d_conf=fabs(a.confidence()-g.confidence());
+      max_pos=max(max_pos,best_dist);
+      max_angle=max(max_angle,d_angle);
+      max_conf=max(max_conf,d_conf);
+      if (best_dist > pos_tolerance || angle_ok==false || d_conf > conf_tolerance) {
+        objects_out_of_tolerance++;
+        differences++;
+      }
+    }
+    for (int j=0;j<actual.size();j++) {
+      if (used[j]) continue;
+      objects_extra++;
+      differences++;
+    }
+    return differences;
+  }
+
+  int compareBalls(const SSL_DetectionFrame & golden, const SSL_DetectionFrame & actual) {
+    int differences=0;
+    vector<bool> used(actual.balls_size(),false);
+    for (int i=0;i<golden.balls_size();i++) {
+      const SSL_DetectionBall & g=golden.balls(i);
+      int best=-1;
+      double best_dist=0.0;
+      for (int j=0;j<actual.balls_size();j++) {
+        if (used[j]) continue;
+        double d=sqrt(sq(actual.balls(j).x()-g.x())+sq(actual.balls(j).y()-g.y()));
+        if (best==-1 || d < best_dist) {
+          best=j;
+          best_dist=d;
+        }
+      }
+      objects++;
+      if (best==-1) {
+        objects_missing++;
+        differences++;
+        continue;
+      }
+      used[best]=true;
+      double d_conf=fabs(actual.balls(best).confidence()-g.confidence());
+      max_pos=max(max_pos,best_dist);
+      max_conf=max(max_conf,d_conf);
+      if (best_dist > pos_tolerance || d_conf > conf_tolerance) {
+        objects_out_of_tolerance++;
+        differences++;
+      }
+    }
+    for (int j=0;j<actual.balls_size();j++) {
+      if (used[j]) continue;
+      objects_extra++;
+      differences++;
+    }
+    return differences;
+  }
+
+  void compare(const SSL_DetectionFrame & golden, const SSL_DetectionFrame & actual) {
+    frames++;
+    int differences=compareRobots(golden.robots_blue(),actual.robots_blue()) +
+                    compareRobots(golden.robots_yellow(),actual.robots_yellow()) +
+                    compareBalls(golden,actual);
+    if (differences > 0) frames_differ++;
+  }
+
+  /// compares all detections of \p filename to \p output
+  bool compareFile(const string & filename, const BatchOutput::FrameMap & output) {
+    FILE * in=fopen(filename.c_str(),"rb");
+    if (in==0) {
+      fprintf(stderr,"Unable to open golden file %s\n",filename.c_str());
+      return false;
+    }
+    SSL_WrapperPacket packet;
+    string buffer;
+    long long matched=0;
+    while (RoboCupSSLPacketFile::readPacket(in,packet,buffer)) {
+      if (packet.has_detection()==false) continue;
+      const SSL_DetectionFrame & g=packet.detection();
+      BatchOutput::FrameMap::const_iterator it=output.find(make_pair((int)g.camera_id(),(long long)g.frame_number()));
+      if (it==output.end()) {
+        frames++;
+        frames_missing++;
+        frames_differ++;
+        continue;
+      }
+      compare(g,it->second);
+      matched++;
+    }
+    fclose(in);
+    frames_extra=(long long)output.size()-matched;
+    return true;
+  }
+
+  bool passed() const {
+    return (frames > 0 && frames_differ==0 && frames_extra==0);
+  }
+
+  void print(FILE * f, const string & filename) const {
+    fprintf(f,"Golden comparison against %s: %lld frames, %lld differ, %lld missing, %lld extra\n",
+            filename.c_str(),frames,frames_differ,frames_missing,frames_extra);
+    fprintf(f,"    %lld objects: %lld missing, %lld extra, %lld out of tolerance (%.2fmm, %.2fdeg, %.3f)\n",
+            objects,objects_missing,objects_extra,objects_out_of_tolerance,pos_tolerance,angle_tolerance*180.0/M_PI,conf_tolerance);
+    fprintf(f,"    largest deviation: position %.3fmm, angle %.3fdeg, confidence %.4f\n",
+            max_pos,max_angle*180.0/M_PI,max_conf);
+  }
+};
+
+/// a preloaded input frame
+class BatchFrame {
+public:
+  RawImage video;
+  int camera_id;
+  long long number; //frame number within its camera, starting at 1
+  double t_rel;     //seconds since the first frame of the recording
+};
+
+/// the input and schedule shared by all workers
+class BatchJob {
+public:
+  vector<BatchFrame *> frames;
+  vector<long long> frames_per_camera;
+  double duration; //length of one pass over the input [s]
+  double time_base;
+  int loops;
+  bool paced;
+  double speed;
+  double t_start;
+  QAtomicInt next;
+};
+
+/*!
+  \class   BatchWorker
+  \brief   Runs a private copy of all camera stacks on frames taken from a BatchJob
+*/
+class BatchWorker : public QThread {
+protected:
+  BatchJob * job;
+  MultiStackRoboCupSSL * multi_stack;
+public:
+  vector<string> plugin_names;
+  vector<LatencyHistogram> plugin_times;
+  LatencyHistogram total;
+  LatencyHistogram lateness; //paced mode: time between a frame's due time and its start
+  long long processed;
+
+  BatchWorker(BatchJob * _job, MultiStackRoboCupSSL * _multi_stack) {
+    job=_job;
+    multi_stack=_multi_stack;
+    processed=0;
+    //all camera stacks share the same plugin layout:
+    VisionStack * s=multi_stack->threads[0]->getStack();
+    for (unsigned int j=0;j<s->stack.size();j++) {
+      plugin_names.push_back(s->stack[j]->getName());
+    }
+    plugin_times.resize(plugin_names.size());
+  }
+
+  virtual void run() {
+    long long n_frames=job->frames.size();
+    long long n_jobs=n_frames*job->loops;
+    while (true) {
+      long long n=job->next.fetchAndAddOrdered(1);
+      if (n >= n_jobs) break;
+      BatchFrame * frame=job->frames[n % n_frames];
+      long long loop=n / n_frames;
+      double t_frame=loop*job->duration + frame->t_rel;
+      double t=GetTimeSec();
+      if (job->paced) {
+        double due=job->t_start + t_frame/job->speed;
+        if (due > t) {
+          usleep((useconds_t)((due-t)*1.0E6));
+          t=GetTimeSec();
+        }
+        lateness.add(t-due);
+      }
+
+      CaptureThread * thread=multi_stack->threads[frame->camera_id];
+      FrameBuffer * rb=thread->getFrameBuffer();
+      VisionStack * stack=thread->getStack();
+      FrameData * d=rb->getPointer(rb->curWrite());
+      //the preloaded frames are only read by the stack:
+      d->borrowVideo(frame->video);
+      d->time=(job->paced ? t : job->time_base + t_frame);
+      d->number=loop*job->frames_per_camera[frame->camera_id] + frame->number;
+      d->cam_id=frame->camera_id;
+      stack->process(d);
+      d->releaseVideo();
+      rb->nextWrite(true);
+      total.add(GetTimeSec()-t);
+      for (unsigned int j=0;j<stack->stack.size() && j<plugin_times.size();j++) {
+        plugin_times[j].add(stack->stack[j]->getTimeProcessing());
+      }
+      processed++;
+    }
+  }
+};
+
+static bool isImageFileName(const string & name) {
+  string::size_type pos=name.find_last_of(".");
+  if (pos==string::npos) return false;
+  string ending=name.substr(pos+1);
+  for (unsigned int i=0;i<ending.size();i++) ending[i]=toupper(ending[i]);
+  return (ending=="PNG" || ending=="BMP" || ending=="JPG" || ending=="JPEG");
+}
+
+/// loads all images of \p dir, sorted by name, as frames of camera \p camera_id
+static bool loadDirectory(BatchJob & job, const string & dir, int camera_id, bool convert_yuv, double fps) {
+  DIR * dp;
+  struct dirent * dirp;
+  if ((dp=opendir(dir.c_str()))==0) {
+    fprintf(stderr,"Failed to open directory %s\n",dir.c_str());
+    return false;
+  }
+  vector<string> files;
+  while ((dirp=readdir(dp))) {
+    if (isImageFileName(dirp->d_name)) files.push_back(dir + "/" + dirp->d_name);
+  }
+  closedir(dp);
+  sort(files.begin(),files.end());
+  for (unsigned int i=0;i<files.size();i++) {
+    int width=-1;
+    int height=-1;
+    rgb * img=ImageIO::readRGB(width,height,files[i].c_str());
+    if (img==0) {
+      fprintf(stderr,"Unable to read image %s\n",files[i].c_str());
+      continue;
+    }
+    BatchFrame * frame=new BatchFrame();
+    if (convert_yuv) {
+      //the same conversion as the "FromFile" capture module:
+      frame->video.allocate(COLOR_YUV422_UYVY,width,height);
+      dc1394_convert_to_YUV422((unsigned char *)img, frame->video.getData(), width, height,
+                               DC1394_BYTE_ORDER_UYVY, DC1394_COLOR_CODING_RGB8, 8);
+    } else {
+      frame->video.allocate(COLOR_RGB8,width,height);
+      memcpy(frame->video.getData(),img,frame->video.getNumBytes());
+    }
+    delete[] img;
+    frame->camera_id=camera_id;
+    frame->t_rel=job.frames.size()/fps;
+    job.frames.push_back(frame);
+  }
+  job.time_base=0.0;
+  return (job.frames.empty()==false);
+}
+
+/// loads all frames of a RawFrameFile
+static bool loadRawFrames(BatchJob & job, const string & filename, double fps) {
+  RawFrameFile file;
+  if (file.openRead(filename.c_str())==false) return false;
+  RawImage img;
+  int camera_id;
+  double t_first=0.0;
+  bool has_time=true;
+  while (file.readFrame(img,camera_id)) {
+    if (camera_id < 0) {
+      fprintf(stderr,"Skipping frame with invalid camera id %d\n",camera_id);
+      continue;
+    }
+    BatchFrame * frame=new BatchFrame();
+    frame->video.deepCopyFromRawImage(img,true);
+    frame->camera_id=camera_id;
+    if (job.frames.empty()) t_first=img.getTime();
+    if (img.getTime() <= 0.0) has_time=false;
+    frame->t_rel=img.getTime()-t_first;
+    job.frames.push_back(frame);
+  }
+  img.clear();
+  if (has_time==false) {
+    for (unsigned int i=0;i<job.frames.size();i++) job.frames[i]->t_rel=i/fps;
+    t_first=0.0;
+  }
+  job.time_base=t_first;
+  return (job.frames.empty()==false);
+}
+
+/// renders \p n frames per camera of the synthetic scene of \p multi_stack
+static bool renderScene(BatchJob & job, MultiStackRoboCupSSL * multi_stack, int n, int width, int height, bool convert_yuv, double fps) {
+  FieldScene * scene=multi_stack->getScene();
+  //the scene starts at time 0, so every run renders the same frames:
+  scene->setTimeOrigin(0.0);
+  vector<FieldSceneView *> views;
+  for (unsigned int c=0;c<multi_stack->threads.size();c++) {
+    StackRoboCupSSL * stack=(StackRoboCupSSL *)multi_stack->threads[c]->getStack();
+    views.push_back(new FieldSceneView(scene,stack->getCameraParameters(),c));
+  }
+  rgbImage img;
+  img.allocate(width,height);
+  for (int i=0;i<n;i++) {
+    for (unsigned int c=0;c<views.size();c++) {
+      double t=i/fps;
+      views[c]->render(img,t);
+      BatchFrame * frame=new BatchFrame();
+      if (convert_yuv) {
+        frame->video.allocate(COLOR_YUV422_UYVY,width,height);
+        dc1394_convert_to_YUV422((unsigned char *)img.getPixelData(), frame->video.getData(), width, height,
+                                 DC1394_BYTE_ORDER_UYVY, DC1394_COLOR_CODING_RGB8, 8);
+      } else {
+        frame->video.allocate(COLOR_RGB8,width,height);
+        memcpy(frame->video.getData(),img.getPixelData(),frame->video.getNumBytes());
+      }
+      frame->camera_id=c;
+      frame->t_rel=t;
+      job.frames.push_back(frame);
+    }
+  }
+  for (unsigned int c=0;c<views.size();c++) delete views[c];
+  job.time_base=0.0;
+  return (job.frames.empty()==false);
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  GetOpt opts(argc, argv);
+  bool help=false;
+  bool paced=false;
+  bool keep_rgb=false;
+  QString input_dir;
+  QString input_file;
+  QString output_file;
+  QString golden_file;
+  QString settings_file;
+  QString s_jobs;
+  QString s_camera;
+  QString s_fps;
+  QString s_speed;
+  QString s_loops;
+  QString s_scene;
+  QString s_size;
+  QString s_pos_tolerance;
+  QString s_angle_tolerance;
+  QString s_conf_tolerance;
+  int ecode=0;
+  opts.addSwitch("help",&help);
+  opts.addOption( 'd',QString("directory"),&input_dir);
+  opts.addOption( 'f',QString("file"),&input_file);
+  opts.addOption( 'o',QString("output"),&output_file);
+  opts.addOption( 'g',QString("golden"),&golden_file);
+  opts.addOption( 'P',QString("pos-tolerance"),&s_pos_tolerance);
+  opts.addOption( 'A',QString("angle-tolerance"),&s_angle_tolerance);
+  opts.addOption( 'C',QString("conf-tolerance"),&s_conf_tolerance);
+  opts.addOption( 'S',QString("scene"),&s_scene);
+  opts.addOption( 'G',QString("geometry"),&s_size);
+  opts.addOption( 's',QString("settings"),&settings_file);
+  opts.addOption( 'j',QString("jobs"),&s_jobs);
+  opts.addOption( 'c',QString("camera"),&s_camera);
+  opts.addOption( 'l',QString("loops"),&s_loops);
+  opts.addOption( 'r',QString("fps"),&s_fps);
+  opts.addOption( 'x',QString("speed"),&s_speed);
+  opts.addSwitch( QString("paced"),&paced);
+  opts.addSwitch( QString("rgb"),&keep_rgb);
+  if (!opts.parse()) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+  if (settings_file.isEmpty()) settings_file="settings.xml";
+  int jobs=(s_jobs.isEmpty() ? 1 : s_jobs.toInt());
+  int camera_id=(s_camera.isEmpty() ? 0 : s_camera.toInt());
+  int loops=(s_loops.isEmpty() ? 1 : s_loops.toInt());
+  double fps=(s_fps.isEmpty() ? 60.0 : s_fps.toDouble());
+  double speed=(s_speed.isEmpty() ? 1.0 : s_speed.toDouble());
+  int scene_frames=(s_scene.isEmpty() ? 0 : s_scene.toInt());
+  if (s_size.isEmpty()) s_size="780x580";
+  QStringList size=s_size.split('x');
+  int width=(size.size()==2 ? size[0].toInt() : 0);
+  int height=(size.size()==2 ? size[1].toInt() : 0);
+  GoldenComparison golden;
+  if (s_pos_tolerance.isEmpty()==false) golden.pos_tolerance=s_pos_tolerance.toDouble();
+  if (s_angle_tolerance.isEmpty()==false) golden.angle_tolerance=s_angle_tolerance.toDouble()*M_PI/180.0;
+  if (s_conf_tolerance.isEmpty()==false) golden.conf_tolerance=s_conf_tolerance.toDouble();
+  int inputs=(input_dir.isEmpty() ? 0 : 1) + (input_file.isEmpty() ? 0 : 1) + (s_scene.isEmpty() ? 0 : 1);
+  if (help==false && (inputs!=1 || jobs < 1 || camera_id < 0 || loops < 1 || fps <= 0.0 || speed <= 0.0 ||
+                      (s_scene.isEmpty()==false && scene_frames < 1) || width <= 0 || height <= 0 ||
+                      golden.pos_tolerance < 0.0 || golden.angle_tolerance < 0.0 || golden.conf_tolerance < 0.0)) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+
+  if (help) {
+    printf("SSL-Vision offline batch processing command line options:\n");
+    printf(" -d DIR      Process all images (png, bmp, jpg) of DIR, sorted by name\n");
+    printf(" -f FILE     Process all frames of a raw frame file\n");
+    printf(" -S N        Process N frames per camera of the synthetic field scene, rendered\n");
+    printf("             with the calibration of the settings. The LUTs are computed from\n");
+    printf("             the color labels.\n");
+    printf(" -G WxH      Size of the scene frames (default: 780x580)\n");
+    printf(" -o FILE     Write all packets as length-delimited SSL_WrapperPackets to FILE\n");
+    printf(" -g FILE     Compare the detections to the golden packets of FILE, as written\n");
+    printf("             by -o, and exit with 2 if they differ\n");
+    printf(" -P MM       Position tolerance of the comparison (default: 1)\n");
+    printf(" -A DEG      Angle tolerance of the comparison (default: 1)\n");
+    printf(" -C CONF     Confidence tolerance of the comparison (default: 0.01)\n");
+    printf(" -s FILE     Settings to use (default: settings.xml)\n");
+    printf(" -j N        Number of parallel stacks (default: 1)\n");
+    printf(" -c ID       Camera whose LUT and calibration is used for -d (default: 0)\n");
+    printf(" -l N        Process the input N times (default: 1)\n");
+    printf(" --paced     Deliver frames at their recorded rate instead of as fast as possible\n");
+    printf(" -r FPS      Frame rate of inputs without timestamps (default: 60)\n");
+    printf(" -x FACTOR   Speed-up of the paced mode (default: 1)\n");
+    printf(" --rgb       Process images of -d as RGB instead of converting them to YUV422\n");
+    printf(" --help      Show this help\n");
+    printf("With more than one stack, packets are written in order of completion.\n");
+    exit(ecode);
+  }
+
+  BatchJob job;
+  job.loops=loops;
+  job.paced=paced;
+  job.speed=speed;
+  RenderOptions * render_opts=new RenderOptions();
+  BatchOutput output;
+  output.collect=(golden_file.isEmpty()==false);
+  MultiStackRoboCupSSL * first_stack=0;
+  bool loaded;
+  if (input_dir.isEmpty()==false) {
+    loaded=loadDirectory(job,input_dir.toStdString(),camera_id,!keep_rgb,fps);
+  } else if (input_file.isEmpty()==false) {
+    loaded=loadRawFrames(job,input_file.toStdString(),fps);
+  } else {
+    //the scene is rendered with the calibration of the first worker's stacks:
+    first_stack=new MultiStackRoboCupSSL(render_opts, 2, false, &output);
+    vector<VarType *> world;
+    world.push_back(first_stack->buildSettingsTree());
+    VarXML::read(world,settings_file.toStdString());
+    first_stack->RefreshSceneTeams();
+    loaded=renderScene(job,first_stack,scene_frames,width,height,!keep_rgb,fps);
+  }
+  if (loaded==false) {
+    fprintf(stderr,"No frames to process.\n");
+    exit(1);
+  }
+  int cameras=2;
+  for (unsigned int i=0;i<job.frames.size();i++) {
+    int c=job.frames[i]->camera_id;
+    if (c+1 > cameras) cameras=c+1;
+    if ((int)job.frames_per_camera.size() < c+1) job.frames_per_camera.resize(c+1,0);
+    job.frames[i]->number=++job.frames_per_camera[c];
+  }
+  job.frames_per_camera.resize(cameras,0);
+  job.duration=job.frames.back()->t_rel + 1.0/fps;
+
+  if (output_file.isEmpty()==false && output.openFile(output_file.toStdString().c_str())==false) {
+    exit(1);
+  }
+
+  //every worker gets its own copy of all camera stacks, so that
+  //none of the plugins is ever shared between two threads:
+  vector<BatchWorker *> workers;
+  for (int i=0;i<jobs;i++) {
+    MultiStackRoboCupSSL * multi_stack=first_stack;
+    first_stack=0;
+    if (multi_stack==0) {
+      multi_stack=new MultiStackRoboCupSSL(render_opts, cameras, false, &output);
+      vector<VarType *> world;
+      world.push_back(multi_stack->buildSettingsTree());
+      VarXML::read(world,settings_file.toStdString());
+    }
+    if (scene_frames > 0) {
+      //the scene is rendered in the draw colors of the labels:
+      for (unsigned int c=0;c<multi_stack->threads.size();c++) {
+        ((StackRoboCupSSL *)multi_stack->threads[c]->getStack())->getLUT()->computeLUTfromLabels();
+      }
+    }
+    workers.push_back(new BatchWorker(&job,multi_stack));
+  }
+
+  printf("Processing %d frames x %d with %d stacks%s...\n",(int)job.frames.size(),loops,jobs,(paced ? " (paced)" : ""));
+  fflush(stdout);
+  job.t_start=GetTimeSec();
+  for (int i=0;i<jobs;i++) {
+    workers[i]->start();
+  }
+  for (int i=0;i<jobs;i++) {
+    workers[i]->wait();
+  }
+  double elapsed=GetTimeSec()-job.t_start;
+  output.closeFile();
+
+  BatchWorker * w0=workers[0];
+  long long processed=w0->processed;
+  for (int i=1;i<jobs;i++) {
+    processed+=workers[i]->processed;
+    w0->total.merge(workers[i]->total);
+    w0->lateness.merge(workers[i]->lateness);
+    for (unsigned int j=0;j<w0->plugin_times.size();j++) {
+      w0->plugin_times[j].merge(workers[i]->plugin_times[j]);
+    }
+  }
+  printf("Processed %lld frames in %.3fs: %.1f frames/s\n",processed,elapsed,(elapsed > 0.0 ? processed/elapsed : 0.0));
+  if (output_file.isEmpty()==false) {
+    printf("Wrote %lld packets to %s\n",output.getPacketCount(),output_file.toStdString().c_str());
+  }
+  printf("Per-plugin processing time:\n");
+  for (unsigned int j=0;j<w0->plugin_times.size();j++) {
+    w0->plugin_times[j].print(stdout,w0->plugin_names[j].c_str());
+  }
+  w0->total.print(stdout,"total");
+  if (paced) {
+    w0->lateness.print(stdout,"start delay");
+  }
+  int result=0;
+  if (golden_file.isEmpty()==false) {
+    if (golden.compareFile(golden_file.toStdString(),output.frames)==false) {
+      result=1;
+    } else {
+      golden.print(stdout,golden_file.toStdString());
+      if (golden.passed()==false) result=2;
+    }
+  }
+
+  for (unsigned int i=0;i<job.frames.size();i++) {
+    job.frames[i]->video.clear();
+    delete job.frames[i];
+  }
+  return result;
+}
@@ -26,6 +26,9 @@ CaptureThread::CaptureThread(int cam_id)
 {
   camId=cam_id;
   affinity=0;
+  rt=0;
+  rt_stats=0;
+  rt_prefault_pending=false;
   settings=new VarList("Image Capture");
 
   settings->addChild( (VarType*) (control= new VarList("Capture Control")));
@@ -34,6 +37,15 @@ CaptureThread::CaptureThread(int cam_id)
   control->addChild( (VarType*) (c_reset  = new VarTrigger("reset bus","Reset")));
   control->addChild( (VarType*) (c_auto_refresh= new VarBool("auto refresh params",true)));
   control->addChild( (VarType*) (c_refresh= new VarTrigger("re-read params","Refresh")));
+  //process frames directly on the driver's buffers if no conversion is needed.
+  //note that the raw video of frames in the ringbuffer is not updated in this mode.
+  control->addChild( (VarType*) (c_zero_copy= new VarBool("zero-copy capture",false)));
+  //"Latest Frame" drains the driver queue and only processes the newest frame,
+  //which bounds latency if processing can not keep up with the camera.
+  control->addChild( (VarType*) (c_policy= new VarStringEnum("capture policy","Oldest Frame")));
+  c_policy->addFlags(VARTYPE_FLAG_NOLOAD_ENUM_CHILDREN);
+  c_policy->addItem("Oldest Frame");
+  c_policy->addItem("Latest Frame");
   control->addChild( (VarType*) (captureModule= new VarStringEnum("Capture Module","DC 1394")));
   captureModule->addFlags(VARTYPE_FLAG_NOLOAD_ENUM_CHILDREN);
   captureModule->addItem("DC 1394");
@@ -55,6 +67,8 @@ CaptureThread::CaptureThread(int cam_id)
   stack = 0;
   counter=new FrameCounter();
   capture=0;
+  lender=0;
+  stop_requests=0;
   captureDC1394 = new CaptureDC1394v2(dc1394,camId);
   captureV4L2 = new CaptureV4L2(v4l2);
   captureFiles = new CaptureFromFile(fromfile);
@@ -62,22 +76,62 @@ CaptureThread::CaptureThread(int cam_id)
   selectCaptureMethod();
   _kill =false;
   rb=0;
+  skipped=0;
 }
 
 void CaptureThread::setAffinityManager(AffinityManager * _affinity) {
   affinity=_affinity;
 }
 
+void CaptureThread::setRealTimeManager(RealTimeManager * _rt) {
+  rt=_rt;
+  if (rt!=0) {
+    rt_stats=rt->registerThread("Camera " + QString::number(camId).toStdString());
+    rt_prefault_pending=true;
+  }
+  stack_mutex.lock();
+  if (stack!=0 && rt!=0) stack->setRealTimeStats(rt_stats,rt->getInversionThreshold());
+  stack_mutex.unlock();
+}
+
 void CaptureThread::setStack(VisionStack * _stack) {
   stack_mutex.lock();
   stack=_stack;
+  if (stack!=0 && rt!=0) stack->setRealTimeStats(rt_stats,rt->getInversionThreshold());
   stack_mutex.unlock();
 }
 
+void CaptureThread::lockStack() {
+  if (rt_stats==0) {
+    stack_mutex.lock();
+  } else if (stack_mutex.tryLock()==false) {
+    double a=GetTimeSec();
+    stack_mutex.lock();
+    rt_stats->lockWaited(GetTimeSec()-a,"stack",rt->getInversionThreshold());
+  }
+}
+
+void CaptureThread::prefaultFrameBuffers(ColorFormat fmt, int width, int height) {
+  //nothing has been published to the ringbuffer yet, so we are free to touch
+  //all of its frames, except for the one the reader currently points to.
+  int skip=rb->curRead();
+  for (int i=0;i<rb->size;i++) {
+    if (i==skip) continue;
+    FrameData * f=rb->getPointer(i);
+    f->video.ensure_allocation(fmt,width,height);
+    rt_stats->prefaulted_bytes+=RealTimeManager::prefault(f->video.getData(),f->video.getNumBytes());
+    if (stack!=0) rt_stats->prefaulted_bytes+=stack->prefault(f);
+  }
+}
+
 VarList * CaptureThread::getSettings() {
   return settings;
 }
 
+void CaptureThread::setGeneratorScene(FieldScene * scene, const CameraParameters * camera) {
+  ((CaptureGenerator*)captureGenerator)->setScene(scene,camera,camId);
+}
+
 CaptureThread::~CaptureThread()
 {
   delete captureDC1394;
@@ -147,6 +201,11 @@ bool CaptureThread::init() {
 
 bool CaptureThread::stop() {
   capture_mutex.lock();
+  //the plugins may still read a borrowed driver buffer, which stopping
+  //would unmap or free. No new frame is dequeued while we wait:
+  stop_requests++;
+  while (lender!=0) frame_released.wait(&capture_mutex);
+  stop_requests--;
   bool res = capture->stopCapture();
   if (res==true) {
     c_stop->addFlags( VARTYPE_FLAG_READONLY );
@@ -179,6 +238,10 @@ void CaptureThread::run() {
     if (affinity!=0) {
       affinity->demandCore(camId);
     }
+    if (rt!=0) {
+      rt->demandCapturePriority(camId,rt_stats);
+    }
+    Tracer::setThreadName("Camera " + QString::number(camId).toStdString());
 
     while(true) {
       if (rb!=0) {
@@ -188,23 +251,64 @@ void CaptureThread::run() {
           stats=(CaptureStats *)d->map.insert("capture_stats",new CaptureStats());
         }
         capture_mutex.lock();
-        if ((capture != 0) && (capture->isCapturing())) {
-          RawImage pic_raw=capture->getFrame();
+        if ((capture != 0) && (capture->isCapturing()) && stop_requests==0) {
+          int frames_skipped=0;
+          RawImage pic_raw;
+          uint64_t t_trace=(Tracer::isEnabled() ? Tracer::now() : 0);
+          if (c_policy->getString() == "Latest Frame") {
+            pic_raw=capture->getLatestFrame(frames_skipped);
+          } else {
+            pic_raw=capture->getFrame();
+          }
+          lender=capture;
+          if (t_trace!=0) Tracer::add("capture dequeue",t_trace,Tracer::now());
+          double t_dequeued=GetTimeSec();
           d->time=pic_raw.getTime();
-          capture->copyAndConvertFrame( pic_raw,d->video);
+          if (c_zero_copy->getBool() && capture->canBorrowFrame(pic_raw)) {
+            //the driver buffer stays dequeued until releaseFrame() below
+            d->borrowVideo(pic_raw);
+          } else {
+            d->restoreVideo();
+            TRACE_SPAN("capture convert");
+            capture->copyAndConvertFrame( pic_raw,d->video);
+          }
           capture_mutex.unlock();
 
-          counter->count();
+          //skipped frames still advance the frame number, so that
+          //consumers can see the gap in the detection frame numbering:
+          counter->count(1+frames_skipped);
+          skipped+=frames_skipped;
+          stats->skipped=skipped;
           stats->total=d->number=counter->getTotal();
           d->cam_id=camId;
           stats->fps_capture=counter->getFPS(changed);
 
-          stack_mutex.lock();
+          lockStack();
           if (stack!=0) {
             stack->process(d);
             stack->postProcess(d);
           }
+          if (rt_stats!=0) {
+            double t_done=GetTimeSec();
+            rt_stats->processing.add(t_done-t_dequeued);
+            if (d->time > 0.0) rt_stats->end_to_end.add(t_done-d->time);
+          }
           stack_mutex.unlock();
+          ColorFormat fmt=d->video.getColorFormat();
+          int width=d->video.getWidth();
+          int height=d->video.getHeight();
+          //all raw-pixel consumers are done; never publish a driver buffer
+          //to the ringbuffer's readers, as it is about to be released:
+          d->releaseVideo();
+          if (rt_prefault_pending && width > 0 && height > 0) {
+            //the first frame tells us the capture format. Buffers allocated
+            //after this point are covered by mlockall(MCL_FUTURE).
+            stack_mutex.lock();
+            prefaultFrameBuffers(fmt,width,height);
+            stack_mutex.unlock();
+            rt_prefault_pending=false;
+            rt_stats->beginSteadyState();
+          }
           rb->nextWrite(true);
 
 
@@ -218,10 +322,12 @@ void CaptureThread::run() {
             stack->updateTimingStatistics();
             stack_mutex.unlock();
           }
+          //the frame goes back to the capture that lent it, even if another
+          //one was selected meanwhile:
           capture_mutex.lock();
-          if ((capture != 0) && (capture->isCapturing())) {
-            capture->releaseFrame();
-          }
+          if (lender->isCapturing()) lender->releaseFrame();
+          lender=0;
+          frame_released.wakeAll();
           capture_mutex.unlock();
 
         } else {
@@ -239,6 +345,7 @@ void CaptureThread::run() {
             if (capture->isCapturing()) capture->readAllParameterValues();
           }
           capture_mutex.unlock();
+          if (rt_stats!=0) rt_stats->endSteadyState();
           return;
         }
       }
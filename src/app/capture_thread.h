@@ -25,12 +25,14 @@
 #include "capturefromfile.h"
 #include "capture_generator.h"
 #include <QThread>
+#include <QWaitCondition>
 #include "ringbuffer.h"
 #include "framedata.h"
 #include "framecounter.h"
 #include "visionstack.h"
 #include "capturestats.h"
 #include "affinity_manager.h"
+#include "realtime_manager.h"
 
 class CaptureV4L2;
 
@@ -48,11 +50,17 @@ protected:
   VisionStack * stack;
   FrameCounter * counter;
   CaptureInterface * capture;
+  CaptureInterface * lender; //the capture whose frame is dequeued, until releaseFrame()
+  QWaitCondition frame_released; //signaled when lender becomes 0
+  int stop_requests; //stop() calls waiting for the frame to be released
   CaptureInterface * captureDC1394;
   CaptureInterface * captureV4L2;
   CaptureInterface * captureFiles;
   CaptureInterface * captureGenerator;
   AffinityManager * affinity;
+  RealTimeManager * rt;
+  RealTimeManager::ThreadStats * rt_stats;
+  bool rt_prefault_pending;
   FrameBuffer * rb;
   bool _kill;
   int camId;
@@ -67,9 +75,15 @@ protected:
   VarTrigger * c_reset;
   VarTrigger * c_refresh;
   VarBool * c_auto_refresh;
+  VarBool * c_zero_copy;
+  VarStringEnum * c_policy;
+  long long skipped;
   VarStringEnum * captureModule;
   Timer timer;
 
+  void lockStack();
+  void prefaultFrameBuffers(ColorFormat fmt, int width, int height);
+
 public slots:
   bool init();
   bool stop();
@@ -84,7 +98,10 @@ public:
   VisionStack * getStack() const;
   void kill();
   VarList * getSettings();
+  /// the scene which the generator renders when "Generate Field Scene" is on
+  void setGeneratorScene(FieldScene * scene, const CameraParameters * camera);
   void setAffinityManager(AffinityManager * _affinity);
+  void setRealTimeManager(RealTimeManager * _rt);
   CaptureThread(int cam_id);
   ~CaptureThread();
 
@@ -31,9 +31,11 @@ class CaptureStats {
   public:
   double fps_capture;
   long long total;
+  long long skipped; //total frames dropped by the latest-frame capture policy
   CaptureStats() {
     fps_capture=0.0;
     total=0;
+    skipped=0;
   }
 };
 
@@ -26,6 +26,42 @@ FrameData::FrameData()
   time=0;
   number=0;
   cam_id=0;
+  video_borrowed=false;
+  video_current=true;
+}
+
+void FrameData::borrowVideo(const RawImage & src)
+{
+  if (video_borrowed==false) {
+    video_own=video;
+    video_borrowed=true;
+  }
+  //plain assignment only copies the pointer and meta-data:
+  video=src;
+  video_current=true;
+}
+
+void FrameData::restoreVideo()
+{
+  if (video_borrowed) {
+    video=video_own;
+    video_own=RawImage();
+    video_borrowed=false;
+  }
+  video_current=true;
+}
+
+void FrameData::releaseVideo()
+{
+  if (video_borrowed) {
+    restoreVideo();
+    video_current=false;
+  }
+}
+
+bool FrameData::isVideoBorrowed() const
+{
+  return video_borrowed;
 }
 
 
@@ -62,6 +62,10 @@ public:
 */
 class FrameData
 {
+protected:
+  bool video_borrowed;
+  bool video_current; //false if the own storage does not hold this frame
+  RawImage video_own; //this frame's own video storage while video is borrowed
 public:
   long long number;
   int cam_id;
@@ -72,6 +76,28 @@ public:
 
   FrameData();
 
+  /// lets \p video point directly at a captured driver buffer, without copying it.
+  /// The buffer must stay valid until restoreVideo() is called.
+  void borrowVideo(const RawImage & src);
+
+  /// points \p video back to this frame's own storage after a borrowVideo().
+  /// The content of the own storage is whatever was last written to it.
+  /// Any plugin that wants to write to \p video must call this first.
+  void restoreVideo();
+
+  /// ends a borrowVideo() before the driver buffer is given back. The own
+  /// storage does not hold this frame, so hasVideo() is false until
+  /// restoreVideo() is called for writing a new one.
+  void releaseVideo();
+
+  bool isVideoBorrowed() const;
+
+  /// false if \p video does not show this frame, because its pixels were
+  /// only borrowed. Readers of the ring buffer skip such frames.
+  bool hasVideo() const {
+    return video_current;
+  }
+
   ~FrameData();
 };
 
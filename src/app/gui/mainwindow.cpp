@@ -21,11 +21,11 @@
 
 #include "mainwindow.h"
 
-MainWindow::MainWindow(bool start_capture, bool enforce_affinity)
+MainWindow::MainWindow(bool start_capture, AffinityManager * _affinity, RealTimeManager * _realtime)
 {
 
-  affinity=0;
-  if (enforce_affinity) affinity=new AffinityManager();
+  affinity=_affinity;
+  realtime=_realtime;
   //opt=new GetOpt();
   settings=0;
   setupUi((QMainWindow *)this);
@@ -47,7 +47,7 @@ MainWindow::MainWindow(bool start_capture, bool enforce_affinity)
   //opt->parse();
 
   //load RoboCup SSL stack by default:
-  multi_stack=new MultiStackRoboCupSSL(opts, 2);
+  multi_stack=new MultiStackRoboCupSSL(opts, 2, true, 0, true, affinity);
 
   VarExternal * stackvar;
   root->addChild(stackvar= new VarExternal((multi_stack->getSettingsFileName() + ".xml").c_str(),multi_stack->getName()));
@@ -56,6 +56,7 @@ MainWindow::MainWindow(bool start_capture, bool enforce_affinity)
   for (unsigned int i=0;i<multi_stack->threads.size();i++) {
     VisionStack * s = multi_stack->threads[i]->getStack();
     if (affinity!=0) multi_stack->threads[i]->setAffinityManager(affinity);
+    if (realtime!=0) multi_stack->threads[i]->setRealTimeManager(realtime);
 
     GLWidget * gl=new GLWidget(0,false);
     gl->setRingBuffer(multi_stack->threads[i]->getFrameBuffer());
@@ -119,7 +120,8 @@ MainWindow::MainWindow(bool start_capture, bool enforce_affinity)
     splitter2->addWidget(stack_widget);
   }
   
-  if (affinity!=0) affinity->demandCore(multi_stack->threads.size());
+  //the GUI thread does all the drawing:
+  if (affinity!=0) affinity->demandVisualization();
 
   // Set position and size of main window:
   QSettings window_settings("RoboCup", "ssl-vision");
@@ -186,6 +188,7 @@ void MainWindow::timerEvent( QTimerEvent * e) {
     }
     w->displayLoopEvent(frame_changed,opts);
   }
+  multi_stack->poll();
 }
 
 void MainWindow::init() {
@@ -211,5 +214,14 @@ MainWindow::~MainWindow() {
 
   // Stop stack:
   multi_stack->stop();
+  //wait for the capture threads, so that their statistics are final:
+  for (unsigned int i=0;i<multi_stack->threads.size();i++) {
+    multi_stack->threads[i]->wait(1000);
+  }
+  multi_stack->writeTimingReport();
+  if (realtime!=0) {
+    realtime->printReport(stdout);
+    delete realtime;
+  }
   exit(0);
 }
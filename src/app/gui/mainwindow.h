@@ -23,6 +23,7 @@
 #define MAINWINDOW_H
 
 #include "affinity_manager.h"
+#include "realtime_manager.h"
 #include <QtGui>
 #include <qmainwindow.h>
 #include "ui_mainwindow.h"
@@ -51,6 +52,7 @@ class MainWindow : public QMainWindow, public Ui_MainWindow
 
 public:
   AffinityManager * affinity;
+  RealTimeManager * realtime;
   //GetOpt * opt;
   VarList * root;
   VarTreeView * tree_view;
@@ -67,7 +69,7 @@ public:
 
   MultiVisionStack * multi_stack;
 
-  MainWindow(bool start_capture, bool enforce_affinity);
+  MainWindow(bool start_capture, AffinityManager * _affinity=0, RealTimeManager * _realtime=0);
   virtual ~MainWindow();
   void init();
 
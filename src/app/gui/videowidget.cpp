@@ -187,5 +187,5 @@ void VideoWidget::processVideoStats(VideoStats stats)
   //let's display it
   statLabel->setText(
     "Capture: "+ QString::number(stats.capture_stats.fps_capture,'f',2)  + " fps | Display: " + QString::number(stats.fps_draw,'f',2) + " fps | "
-    + QString::number(stats.fps_loop,'f',2) + " its/s");
+    + QString::number(stats.fps_loop,'f',2) + " its/s | Skipped: " + QString::number(stats.capture_stats.skipped));
 }
@@ -0,0 +1,160 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    headless.cpp
+  \brief   The entry point of the GUI-less vision server (vision-headless).
+  \author  Author Name, 2026
+*/
+//========================================================================
+
+#include <QCoreApplication>
+#include <QString>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "qgetopt.h"
+#include "VarXML.h"
+#include "multistacks.h"
+#include "affinity_manager.h"
+#include "realtime_manager.h"
+
+static volatile sig_atomic_t shutdown_requested=0;
+static volatile sig_atomic_t trace_requested=0;
+
+static void requestShutdown(int sig) {
+  (void)sig;
+  shutdown_requested=1;
+}
+
+static void requestTrace(int sig) {
+  (void)sig;
+  trace_requested=1;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  GetOpt opts(argc, argv);
+  bool help=false;
+  bool enforce_affinity=false;
+  QString camera_cpus;
+  QString housekeeping_cpus;
+  bool rt_mode=false;
+  bool rt_no_mlock=false;
+  QString rt_priorities;
+  int ecode=0;
+  opts.addSwitch("help",&help);
+  opts.addShortOptSwitch( 'a',QString("Enforce Processor Affinity"),&enforce_affinity, false);
+  opts.addOption( 'c',QString("camera-cpus"),&camera_cpus);
+  opts.addOption( 'k',QString("housekeeping-cpus"),&housekeeping_cpus);
+  opts.addSwitch( QString("rt"),&rt_mode);
+  opts.addOption( 'p',QString("rt-priority"),&rt_priorities);
+  opts.addSwitch( QString("rt-no-mlock"),&rt_no_mlock);
+  if (!opts.parse()) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+
+  if (help) {
+    printf("SSL-Vision headless server command line options:\n");
+    printf(" -a        Set Processor Affinity\n");
+    printf(" -c LIST   CPUs to use for camera threads, e.g. 2-7 (implies -a)\n");
+    printf(" -k LIST   CPUs to use for the main thread (implies -a)\n");
+    printf(" --rt      Real-time mode: run camera threads under SCHED_FIFO, lock and\n");
+    printf("           prefault memory and print a latency report at shutdown\n");
+    printf(" -p LIST   SCHED_FIFO priority per camera, e.g. 80,70 (implies --rt)\n");
+    printf(" --rt-no-mlock  Do not lock memory in real-time mode\n");
+    printf(" --help    Show this help\n");
+    printf("Capture starts immediately. Send SIGTERM or SIGINT to stop;\n");
+    printf("settings are saved to settings.xml on shutdown.\n");
+    printf("Send SIGUSR1 to dump a trace (enable Tracing in settings.xml first).\n");
+    exit(ecode);
+  }
+
+  AffinityManager * affinity=0;
+  if (enforce_affinity || camera_cpus.isEmpty()==false || housekeeping_cpus.isEmpty()==false) {
+    AffinityManager::Options affinity_options;
+    affinity_options.camera_cpus=camera_cpus.toStdString();
+    affinity_options.housekeeping_cpus=housekeeping_cpus.toStdString();
+    affinity=new AffinityManager(affinity_options);
+  }
+
+  RealTimeManager * realtime=0;
+  if (rt_mode || rt_priorities.isEmpty()==false) {
+    RealTimeManager::Options rt_options;
+    if (rt_priorities.isEmpty()==false && RealTimeManager::parsePriorityList(rt_priorities.toStdString().c_str(),rt_options.capture_priorities)==false) {
+      fprintf(stderr,"Invalid real-time priority list: %s\n",rt_priorities.toStdString().c_str());
+      exit(1);
+    }
+    rt_options.lock_memory=!rt_no_mlock;
+    realtime=new RealTimeManager(rt_options);
+    realtime->lockMemory();
+  }
+
+  RenderOptions * render_opts=new RenderOptions();
+  MultiStackRoboCupSSL * multi_stack=new MultiStackRoboCupSSL(render_opts, 2, false, 0, true, affinity);
+  for (unsigned int i=0;i<multi_stack->threads.size();i++) {
+    if (affinity!=0) multi_stack->threads[i]->setAffinityManager(affinity);
+    if (realtime!=0) multi_stack->threads[i]->setRealTimeManager(realtime);
+  }
+
+  vector<VarType *> world;
+  world.push_back(multi_stack->buildSettingsTree());
+  world=VarXML::read(world,"settings.xml");
+
+  //update network output settings from xml file
+  multi_stack->RefreshNetworkOutput();
+
+  signal(SIGTERM,requestShutdown);
+  signal(SIGINT,requestShutdown);
+  signal(SIGUSR1,requestTrace);
+
+  if (affinity!=0) affinity->demandHousekeeping();
+  multi_stack->start();
+  for (unsigned int i=0;i<multi_stack->threads.size();i++) {
+    multi_stack->threads[i]->init();
+  }
+  printf("SSL-Vision running headless with %d cameras.\n",(int)multi_stack->threads.size());
+  fflush(stdout);
+
+  while (shutdown_requested==0) {
+    app.processEvents();
+    multi_stack->poll();
+    if (trace_requested!=0) {
+      trace_requested=0;
+      multi_stack->dumpTrace();
+    }
+    usleep(100000);
+  }
+
+  printf("Shutting down...\n");
+  multi_stack->stop();
+  for (unsigned int i=0;i<multi_stack->threads.size();i++) {
+    multi_stack->threads[i]->wait();
+  }
+  //the capture threads read back the camera parameters when stopping,
+  //so the settings are written only after all of them have finished:
+  VarXML::write(world,"settings.xml");
+  multi_stack->writeTimingReport();
+
+  if (realtime!=0) {
+    realtime->printReport(stdout);
+    delete realtime;
+  }
+  if (affinity!=0) delete affinity;
+  return 0;
+}
@@ -0,0 +1,640 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    latency.cpp
+  \brief   End-to-end latency benchmark: capture timestamp to multicast receive
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include <QCoreApplication>
+#include <QThread>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <stdio.h>
+#include <unistd.h>
+#include <math.h>
+#include <vector>
+#include "qgetopt.h"
+#include "VarXML.h"
+#include "multistacks.h"
+#include "robocup_ssl_client.h"
+#include "realtime_manager.h"
+#include "timer.h"
+
+/*!
+  \class   CameraAccuracy
+  \brief   The errors of the detections of one camera against the ground truth
+
+  The histograms hold meters and radians, so that their resolution is 1um.
+*/
+class CameraAccuracy {
+public:
+  LatencyHistogram robot_error;
+  LatencyHistogram angle_error;
+  LatencyHistogram ball_error;
+  long long frames;     //detections with a ground truth
+  long long unmatched;  //detections without one
+  long long robots;
+  long long robots_found;
+  long long robots_false;
+  long long balls;
+  long long balls_found;
+  long long balls_false;
+
+  CameraAccuracy() {
+    clear();
+  }
+  void clear() {
+    robot_error.clear();
+    angle_error.clear();
+    ball_error.clear();
+    frames=unmatched=0;
+    robots=robots_found=robots_false=0;
+    balls=balls_found=balls_false=0;
+  }
+
+  void addRobots(const ::google::protobuf::RepeatedPtrField<SSL_DetectionRobot> & truth,
+                 const ::google::protobuf::RepeatedPtrField<SSL_DetectionRobot> & detected) {
+    robots+=truth.size();
+    int found=0;
+    for (int i=0;i<truth.size();i++) {
+      for (int j=0;j<detected.size();j++) {
+        if (detected.Get(j).robot_id()!=truth.Get(i).robot_id()) continue;
+        double dx=detected.Get(j).x()-truth.Get(i).x();
+        double dy=detected.Get(j).y()-truth.Get(i).y();
+        robot_error.add(sqrt(dx*dx+dy*dy)*1.0E-3);
+        if (detected.Get(j).has_orientation()) {
+          angle_error.add(fabs(angle_mod(detected.Get(j).orientation()-truth.Get(i).orientation())));
+        }
+        found++;
+        break;
+      }
+    }
+    robots_found+=found;
+    if (detected.size() > found) robots_false+=detected.size()-found;
+  }
+
+  /// matches balls by distance, as they have no id
+  void addBalls(const SSL_DetectionFrame & truth, const SSL_DetectionFrame & detected) {
+    static const double max_dist=200.0;
+    balls+=truth.balls_size();
+    int found=0;
+    for (int i=0;i<truth.balls_size();i++) {
+      double best=max_dist;
+      for (int j=0;j<detected.balls_size();j++) {
+        double dx=detected.balls(j).x()-truth.balls(i).x();
+        double dy=detected.balls(j).y()-truth.balls(i).y();
+        best=min(best,sqrt(dx*dx+dy*dy));
+      }
+      if (best < max_dist) {
+        ball_error.add(best*1.0E-3);
+        found++;
+      }
+    }
+    balls_found+=found;
+    if (detected.balls_size() > found) balls_false+=detected.balls_size()-found;
+  }
+
+  void add(const SSL_DetectionFrame & truth, const SSL_DetectionFrame & detected) {
+    frames++;
+    addRobots(truth.robots_blue(),detected.robots_blue());
+    addRobots(truth.robots_yellow(),detected.robots_yellow());
+    addBalls(truth,detected);
+  }
+
+  void print(FILE * f, int camera) const {
+    fprintf(f,"    cam %d accuracy       %lld frames (%lld without ground truth), robots %lld of %lld found, %lld false, balls %lld of %lld found, %lld false\n",
+            camera,frames,unmatched,robots_found,robots,robots_false,balls_found,balls,balls_false);
+    if (robot_error.count > 0) {
+      fprintf(f,"    cam %d robot error    mean %.1fmm  p50 %.1fmm  p99 %.1fmm  max %.1fmm\n",camera,
+              robot_error.mean()*1.0E3,robot_error.percentile(0.5)*1.0E3,robot_error.percentile(0.99)*1.0E3,robot_error.max*1.0E3);
+    }
+    if (angle_error.count > 0) {
+      fprintf(f,"    cam %d angle error    mean %.2fdeg  p50 %.2fdeg  p99 %.2fdeg  max %.2fdeg\n",camera,
+              angle_error.mean()*180.0/M_PI,angle_error.percentile(0.5)*180.0/M_PI,angle_error.percentile(0.99)*180.0/M_PI,angle_error.max*180.0/M_PI);
+    }
+    if (ball_error.count > 0) {
+      fprintf(f,"    cam %d ball error     mean %.1fmm  p50 %.1fmm  p99 %.1fmm  max %.1fmm\n",camera,
+              ball_error.mean()*1.0E3,ball_error.percentile(0.5)*1.0E3,ball_error.percentile(0.99)*1.0E3,ball_error.max*1.0E3);
+    }
+  }
+};
+
+/*!
+  \class   GroundTruthReceiver
+  \brief   Keeps the recent ground truth frames of the synthetic scene
+
+  The scene publishes the truth of a frame when it is rendered, before the
+  frame is processed, so it is usually here when the detection arrives.
+*/
+class GroundTruthReceiver : public QThread {
+protected:
+  static const unsigned int HISTORY=64;
+  RoboCupSSLClient * client;
+  volatile bool stop_requested;
+  QMutex mutex;
+  vector<vector<SSL_DetectionFrame> > frames; //a ring of HISTORY frames per camera
+  vector<unsigned int> heads;
+public:
+  GroundTruthReceiver(RoboCupSSLClient * _client, int n_cameras) {
+    client=_client;
+    stop_requested=false;
+    frames.resize(n_cameras,vector<SSL_DetectionFrame>(HISTORY));
+    heads.resize(n_cameras,0);
+  }
+
+  void requestStop() {
+    stop_requested=true;
+  }
+
+  /// finds the truth of the frame that camera \p cam captured at \p t_capture
+  bool find(int cam, double t_capture, SSL_DetectionFrame & result) {
+    bool found=false;
+    mutex.lock();
+    if (cam >= 0 && cam < (int)frames.size()) {
+      for (unsigned int i=0;i<HISTORY && !found;i++) {
+        const SSL_DetectionFrame & f=frames[cam][i];
+        if (f.has_t_capture() && fabs(f.t_capture()-t_capture) < 1.0E-7) {
+          result=f;
+          found=true;
+        }
+      }
+    }
+    mutex.unlock();
+    return found;
+  }
+
+  virtual void run() {
+    SSL_WrapperPacket packet;
+    while (stop_requested==false) {
+      if (client->wait(100)==false) continue;
+      while (client->receive(packet)) {
+        if (packet.has_detection()==false) continue;
+        int cam=packet.detection().camera_id();
+        mutex.lock();
+        if (cam >= 0 && cam < (int)frames.size()) {
+          frames[cam][heads[cam]]=packet.detection();
+          heads[cam]=(heads[cam]+1) % HISTORY;
+        }
+        mutex.unlock();
+      }
+    }
+  }
+};
+
+/// the detection packets received from one camera during a measurement
+class CameraLatency {
+public:
+  LatencyHistogram latency;    //t_capture to receive
+  LatencyHistogram processing; //t_capture to t_sent
+  LatencyHistogram jitter;     //deviation of the receive interval from the frame period
+  long long received;
+  long long first_frame;
+  long long last_frame;
+  long long out_of_order;
+  long long late;              //received after the deadline
+  double t_last;
+  CameraAccuracy accuracy;
+
+  CameraLatency() {
+    clear();
+  }
+  void clear() {
+    latency.clear();
+    processing.clear();
+    jitter.clear();
+    received=0;
+    first_frame=-1;
+    last_frame=-1;
+    out_of_order=0;
+    late=0;
+    t_last=0.0;
+    accuracy.clear();
+  }
+  /// frames that were captured but never received
+  long long lost() const {
+    if (received==0) return 0;
+    long long span=last_frame-first_frame+1;
+    return (span > received ? span-received : 0);
+  }
+};
+
+/*!
+  \class   LatencyReceiver
+  \brief   Receives the detection packets of all cameras on the multicast group
+*/
+class LatencyReceiver : public QThread {
+protected:
+  RoboCupSSLClient * client;
+  GroundTruthReceiver * truth;
+  volatile bool stop_requested;
+  double period;
+  double deadline;
+public:
+  QMutex mutex;
+  vector<CameraLatency> cameras;
+
+  /// if \p _truth is given, the detections are also compared to the ground truth
+  LatencyReceiver(RoboCupSSLClient * _client, int n_cameras, GroundTruthReceiver * _truth=0) {
+    client=_client;
+    truth=_truth;
+    stop_requested=false;
+    period=0.0;
+    deadline=0.0;
+    cameras.resize(n_cameras);
+  }
+
+  void requestStop() {
+    stop_requested=true;
+  }
+
+  /// starts a new measurement
+  void reset(double _period, double _deadline) {
+    mutex.lock();
+    period=_period;
+    deadline=_deadline;
+    for (unsigned int i=0;i<cameras.size();i++) cameras[i].clear();
+    mutex.unlock();
+  }
+
+  virtual void run() {
+    SSL_WrapperPacket packet;
+    SSL_DetectionFrame expected;
+    while (stop_requested==false) {
+      if (client->wait(100)==false) continue;
+      while (client->receive(packet)) {
+        double t=GetTimeSec();
+        if (packet.has_detection()==false) continue;
+        const SSL_DetectionFrame & detection=packet.detection();
+        int cam=detection.camera_id();
+        long long frame=detection.frame_number();
+        bool have_truth=(truth!=0 && truth->find(cam,detection.t_capture(),expected));
+        mutex.lock();
+        if (cam >= 0 && cam < (int)cameras.size()) {
+          CameraLatency & c=cameras[cam];
+          double latency=t-detection.t_capture();
+          c.latency.add(latency);
+          c.processing.add(detection.t_sent()-detection.t_capture());
+          if (latency > deadline) c.late++;
+          if (c.received==0) {
+            c.first_frame=frame;
+          } else if (frame <= c.last_frame) {
+            c.out_of_order++;
+          } else if (frame==c.last_frame+1) {
+            double d=(t-c.t_last)-period;
+            c.jitter.add(d < 0.0 ? -d : d);
+          }
+          if (frame > c.last_frame) {
+            c.last_frame=frame;
+            c.t_last=t;
+          }
+          c.received++;
+          if (have_truth) {
+            c.accuracy.add(expected,detection);
+          } else if (truth!=0) {
+            c.accuracy.unmatched++;
+          }
+        }
+        mutex.unlock();
+      }
+    }
+  }
+};
+
+/// sets a setting given by its path below \p root
+static bool setSetting(VarType * root, const string & path, const string & value) {
+  VarType * v=root;
+  string::size_type start=0;
+  while (v!=0 && start <= path.length()) {
+    string::size_type end=path.find('/',start);
+    if (end==string::npos) end=path.length();
+    v=v->findChild(path.substr(start,end-start));
+    start=end+1;
+  }
+  if (v==0) {
+    fprintf(stderr,"Unknown setting: %s/%s\n",root->getName().c_str(),path.c_str());
+    return false;
+  }
+  v->setString(value);
+  return true;
+}
+
+/// sets a capture setting given by its path below "Image Capture"
+static bool setCaptureSetting(CaptureThread * thread, const string & path, const string & value) {
+  return setSetting(thread->getSettings(),path,value);
+}
+
+/// the outcome of a measurement at one frame rate
+class LatencyStep {
+public:
+  double fps;
+  double elapsed;
+  vector<CameraLatency> cameras;
+  bool passed;
+  LatencyStep() {
+    fps=0.0;
+    elapsed=0.0;
+    passed=false;
+  }
+};
+
+/*!
+  \class   LatencyHarness
+  \brief   Drives all capture threads at a given rate and measures the packets
+*/
+class LatencyHarness {
+protected:
+  MultiStackRoboCupSSL * multi_stack;
+  LatencyReceiver * receiver;
+  string rate_setting;
+public:
+  double warmup;      //seconds before a measurement starts
+  double duration;    //seconds of each measurement
+  double deadline;    //seconds; 0 means one frame period
+  double miss_limit;  //fraction of missed or late frames still passing
+
+  bool accuracy;      //print the errors against the ground truth
+
+  LatencyHarness(MultiStackRoboCupSSL * _multi_stack, LatencyReceiver * _receiver, const string & _rate_setting) {
+    multi_stack=_multi_stack;
+    receiver=_receiver;
+    rate_setting=_rate_setting;
+    warmup=1.0;
+    duration=10.0;
+    deadline=0.0;
+    miss_limit=0.01;
+    accuracy=false;
+  }
+
+  LatencyStep measure(double fps) {
+    char s_fps[32];
+    snprintf(s_fps,sizeof(s_fps),"%g",fps);
+    //the capture modules read their frame rate when starting:
+    for (unsigned int i=0;i<multi_stack->threads.size();i++) {
+      CaptureThread * thread=multi_stack->threads[i];
+      thread->stop();
+      setCaptureSetting(thread,rate_setting,s_fps);
+      thread->init();
+    }
+    usleep((useconds_t)(warmup*1.0E6));
+
+    LatencyStep step;
+    step.fps=fps;
+    double t_deadline=(deadline > 0.0 ? deadline : 1.0/fps);
+    receiver->reset(1.0/fps,t_deadline);
+    double t_start=GetTimeSec();
+    usleep((useconds_t)(duration*1.0E6));
+    receiver->mutex.lock();
+    step.elapsed=GetTimeSec()-t_start;
+    step.cameras=receiver->cameras;
+    receiver->mutex.unlock();
+
+    //a step passes if every camera delivered (almost) all frames that were
+    //due at this rate, and (almost) all of them before the deadline:
+    step.passed=true;
+    long long expected=(long long)(step.elapsed*fps);
+    for (unsigned int i=0;i<step.cameras.size();i++) {
+      const CameraLatency & c=step.cameras[i];
+      long long missed=(expected > c.received ? expected-c.received : 0);
+      if (c.received==0 || missed > miss_limit*expected || c.late > miss_limit*c.received) step.passed=false;
+    }
+    return step;
+  }
+
+  void print(const LatencyStep & step, FILE * f) {
+    long long expected=(long long)(step.elapsed*step.fps);
+    for (unsigned int i=0;i<step.cameras.size();i++) {
+      const CameraLatency & c=step.cameras[i];
+      long long missed=(expected > c.received ? expected-c.received : 0);
+      fprintf(f,"Camera %d: %lld of %lld frames (%.1f frames/s), %lld lost, %lld out of order, %lld missed, %lld late\n",
+              i,c.received,expected,(step.elapsed > 0.0 ? c.received/step.elapsed : 0.0),c.lost(),c.out_of_order,missed,c.late);
+      char label[64];
+      snprintf(label,sizeof(label),"cam %d latency",i);
+      c.latency.print(f,label);
+      snprintf(label,sizeof(label),"cam %d processing",i);
+      c.processing.print(f,label);
+      snprintf(label,sizeof(label),"cam %d jitter",i);
+      c.jitter.print(f,label);
+      if (accuracy) c.accuracy.print(f,i);
+    }
+  }
+
+  void printRow(const LatencyStep & step, FILE * f) {
+    long long expected=(long long)(step.elapsed*step.fps);
+    fprintf(f,"%8.1f",step.fps);
+    for (unsigned int i=0;i<step.cameras.size();i++) {
+      const CameraLatency & c=step.cameras[i];
+      long long missed=(expected > c.received ? expected-c.received : 0);
+      fprintf(f," | %8.1f %8.3f %8.3f %6.2f%% %6.2f%%",(step.elapsed > 0.0 ? c.received/step.elapsed : 0.0),
+              c.latency.percentile(0.5)*1.0E3,c.latency.percentile(0.99)*1.0E3,
+              (expected > 0 ? 100.0*missed/expected : 0.0),(c.received > 0 ? 100.0*c.late/c.received : 0.0));
+    }
+    fprintf(f," | %s\n",(step.passed ? "ok" : "FAIL"));
+    fflush(f);
+  }
+
+  void printHeader(FILE * f) {
+    fprintf(f,"%8s","fps");
+    for (unsigned int i=0;i<multi_stack->threads.size();i++) {
+      fprintf(f," | %5s %d: fps   p50 ms   p99 ms  missed    late","cam",i);
+    }
+    fprintf(f," |\n");
+  }
+};
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  GetOpt opts(argc, argv);
+  bool help=false;
+  bool sweep=false;
+  bool test_image=false;
+  bool scene=false;
+  QString settings_file;
+  QString input_dir;
+  QString s_cameras;
+  QString s_fps;
+  QString s_seconds;
+  QString s_size;
+  QString s_deadline;
+  QString s_miss_limit;
+  QString s_step;
+  QString s_max_fps;
+  int ecode=0;
+  opts.addSwitch("help",&help);
+  opts.addOption( 's',QString("settings"),&settings_file);
+  opts.addOption( 'd',QString("directory"),&input_dir);
+  opts.addOption( 'n',QString("cameras"),&s_cameras);
+  opts.addOption( 'r',QString("fps"),&s_fps);
+  opts.addOption( 't',QString("time"),&s_seconds);
+  opts.addOption( 'g',QString("geometry"),&s_size);
+  opts.addOption( 'D',QString("deadline"),&s_deadline);
+  opts.addOption( 'm',QString("miss-limit"),&s_miss_limit);
+  opts.addOption( 'f',QString("factor"),&s_step);
+  opts.addOption( 'F',QString("max-fps"),&s_max_fps);
+  opts.addSwitch( QString("sweep"),&sweep);
+  opts.addSwitch( QString("test-image"),&test_image);
+  opts.addSwitch( QString("scene"),&scene);
+  if (!opts.parse()) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+  if (settings_file.isEmpty()) settings_file="settings.xml";
+  if (s_size.isEmpty()) s_size="780x580";
+  int cameras=(s_cameras.isEmpty() ? 2 : s_cameras.toInt());
+  double fps=(s_fps.isEmpty() ? 60.0 : s_fps.toDouble());
+  double seconds=(s_seconds.isEmpty() ? 10.0 : s_seconds.toDouble());
+  double deadline=(s_deadline.isEmpty() ? 0.0 : s_deadline.toDouble()*1.0E-3);
+  double miss_limit=(s_miss_limit.isEmpty() ? 1.0 : s_miss_limit.toDouble())*0.01;
+  double step=(s_step.isEmpty() ? 1.2 : s_step.toDouble());
+  double max_fps=(s_max_fps.isEmpty() ? 2000.0 : s_max_fps.toDouble());
+  QStringList size=s_size.split('x');
+  int width=(size.size()==2 ? size[0].toInt() : 0);
+  int height=(size.size()==2 ? size[1].toInt() : 0);
+  if (help==false && (cameras < 1 || fps <= 0.0 || seconds <= 0.0 || deadline < 0.0 || miss_limit < 0.0 || step <= 1.0 || width <= 0 || height <= 0 || (scene && !input_dir.isEmpty()))) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+
+  if (help) {
+    printf("SSL-Vision end-to-end latency benchmark command line options:\n");
+    printf(" -n N         Number of cameras (default: 2)\n");
+    printf(" -s FILE      Settings to use (default: settings.xml)\n");
+    printf(" -r FPS       Frame rate per camera (default: 60)\n");
+    printf(" -t SECONDS   Length of each measurement (default: 10)\n");
+    printf(" -g WxH       Size of the generated images (default: 780x580)\n");
+    printf(" --test-image Generate the color test image instead of black frames\n");
+    printf(" --scene      Generate the synthetic field scene and measure the detection\n");
+    printf("              errors against its ground truth. The LUTs are computed from\n");
+    printf("              the color labels.\n");
+    printf(" -d DIR       Capture the images of DIR instead of generating frames\n");
+    printf(" -D MS        Deadline from capture to receive (default: one frame period)\n");
+    printf(" --sweep      Raise the frame rate from -r until frames are missed or late\n");
+    printf(" -f FACTOR    Frame rate increase per sweep step (default: 1.2)\n");
+    printf(" -F FPS       Highest frame rate of the sweep (default: 2000)\n");
+    printf(" -m PERCENT   Missed or late frames that still pass a sweep step (default: 1)\n");
+    printf(" --help       Show this help\n");
+    printf("Packets are received on the multicast group of the settings, so this\n");
+    printf("must not run next to a live vision server on the same group.\n");
+    exit(ecode);
+  }
+
+  RenderOptions * render_opts=new RenderOptions();
+  MultiStackRoboCupSSL * multi_stack=new MultiStackRoboCupSSL(render_opts, cameras, false);
+  vector<VarType *> world;
+  world.push_back(multi_stack->buildSettingsTree());
+  VarXML::read(world,settings_file.toStdString());
+  multi_stack->RefreshNetworkOutput();
+
+  //all cameras are driven by the generator or the file capture:
+  string rate_setting;
+  for (unsigned int i=0;i<multi_stack->threads.size();i++) {
+    CaptureThread * thread=multi_stack->threads[i];
+    bool ok;
+    if (input_dir.isEmpty()) {
+      ok=setCaptureSetting(thread,"Capture Control/Capture Module","Generator") &&
+         setCaptureSetting(thread,"Generator/Conversion Settings/convert to mode",Colors::colorFormatToString(COLOR_YUV422_UYVY)) &&
+         setCaptureSetting(thread,"Generator/Capture Settings/Width (pixels)",QString::number(width).toStdString()) &&
+         setCaptureSetting(thread,"Generator/Capture Settings/Height (pixels)",QString::number(height).toStdString()) &&
+         setCaptureSetting(thread,"Generator/Capture Settings/Generate Color Test Image",(test_image ? "true" : "false")) &&
+         setCaptureSetting(thread,"Generator/Capture Settings/Generate Field Scene",(scene ? "true" : "false"));
+      rate_setting="Generator/Capture Settings/Framerate (FPS)";
+    } else {
+      string dir=input_dir.toStdString();
+      if (dir[dir.length()-1]!='/') dir+="/";
+      ok=setCaptureSetting(thread,"Capture Control/Capture Module","Read from files") &&
+         setCaptureSetting(thread,"Read from files/Conversion Settings/convert to mode",Colors::colorFormatToString(COLOR_YUV422_UYVY)) &&
+         setCaptureSetting(thread,"Read from files/Capture Settings/directory",dir);
+      rate_setting="Read from files/Capture Settings/Framerate (FPS)";
+    }
+    if (ok==false) exit(1);
+    thread->selectCaptureMethod();
+    //the scene is rendered in the draw colors of the labels:
+    if (scene) ((StackRoboCupSSL *)thread->getStack())->getLUT()->computeLUTfromLabels();
+  }
+
+  RoboCupSSLClient * truth_client=0;
+  GroundTruthReceiver * truth=0;
+  if (scene) {
+    VarList * scene_settings=multi_stack->getScene()->getSettings();
+    if (setSetting(scene_settings,"Ground Truth/Publish","true")==false) exit(1);
+    VarType * ground_truth=scene_settings->findChild("Ground Truth");
+    truth_client=new RoboCupSSLClient(QString::fromStdString(ground_truth->findChild("Multicast Port")->getString()).toInt(),
+                                      ground_truth->findChild("Multicast Address")->getString(),
+                                      ground_truth->findChild("Multicast Interface")->getString());
+    if (truth_client->open(false)==false) exit(1);
+    truth=new GroundTruthReceiver(truth_client,cameras);
+    truth->start();
+  }
+
+  PluginSSLNetworkOutputSettings * network=multi_stack->getNetworkOutputSettings();
+  RoboCupSSLClient client(network->multicast_port->getInt(),network->multicast_address->getString(),network->multicast_interface->getString());
+  if (client.open(false)==false) exit(1);
+  LatencyReceiver receiver(&client,cameras,truth);
+  receiver.start();
+
+  LatencyHarness harness(multi_stack,&receiver,rate_setting);
+  harness.accuracy=(truth!=0);
+  harness.duration=seconds;
+  harness.deadline=deadline;
+  harness.miss_limit=miss_limit;
+
+  multi_stack->start();
+  printf("Measuring %d cameras on %s:%d...\n",cameras,network->multicast_address->getString().c_str(),network->multicast_port->getInt());
+  fflush(stdout);
+  if (sweep) {
+    harness.printHeader(stdout);
+    double best=0.0;
+    LatencyStep last;
+    for (double r=fps;r <= max_fps;r*=step) {
+      last=harness.measure(r);
+      harness.printRow(last,stdout);
+      if (last.passed==false) break;
+      best=r;
+    }
+    if (best > 0.0) {
+      printf("Highest rate without missed deadlines: %.1f frames/s per camera (%.2fx the start rate)\n",best,best/fps);
+    } else {
+      printf("Deadlines are already missed at the start rate of %.1f frames/s\n",fps);
+    }
+    if (last.fps > 0.0) {
+      printf("Last step:\n");
+      harness.print(last,stdout);
+    }
+  } else {
+    LatencyStep s=harness.measure(fps);
+    harness.print(s,stdout);
+  }
+
+  multi_stack->stop();
+  for (unsigned int i=0;i<multi_stack->threads.size();i++) {
+    multi_stack->threads[i]->wait();
+  }
+  receiver.requestStop();
+  receiver.wait();
+  client.close();
+  if (truth!=0) {
+    truth->requestStop();
+    truth->wait();
+    truth_client->close();
+    delete truth;
+    delete truth_client;
+  }
+  return 0;
+}
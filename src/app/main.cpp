@@ -35,10 +35,22 @@ int main(int argc, char *argv[])
   bool help=false;
   bool start=false;
   bool enforce_affinity=false;
+  bool smt_vis=false;
+  QString camera_cpus;
+  QString housekeeping_cpus;
+  bool rt_mode=false;
+  bool rt_no_mlock=false;
+  QString rt_priorities;
   int ecode=0;
   opts.addSwitch("help",&help);
   opts.addShortOptSwitch( 'a',QString("Enforce Processor Affinity"),&enforce_affinity, false);
+  opts.addOption( 'c',QString("camera-cpus"),&camera_cpus);
+  opts.addOption( 'k',QString("housekeeping-cpus"),&housekeeping_cpus);
+  opts.addSwitch( QString("smt-vis"),&smt_vis);
   opts.addShortOptSwitch( 's',QString("Start Capturing Immediately"),&start, false);
+  opts.addSwitch( QString("rt"),&rt_mode);
+  opts.addOption( 'p',QString("rt-priority"),&rt_priorities);
+  opts.addSwitch( QString("rt-no-mlock"),&rt_no_mlock);
   if (!opts.parse()) {
     fprintf(stderr,"Invalid command line parameters!\n");
     help=true;
@@ -49,11 +61,42 @@ int main(int argc, char *argv[])
     printf("SSL-Vision command line options:\n");
     printf(" -s        Start capture immediately\n");
     printf(" -a        Set Processor Affinity\n");
+    printf(" -c LIST   CPUs to use for camera threads, e.g. 2-7 (implies -a)\n");
+    printf("           (default: isolated CPUs, or all but the first core)\n");
+    printf(" -k LIST   CPUs to use for GUI and network threads (implies -a)\n");
+    printf(" --smt-vis Run visualization on the SMT siblings of camera cores (implies -a)\n");
+    printf(" --rt      Real-time mode: run camera threads under SCHED_FIFO, lock and\n");
+    printf("           prefault memory (including the DVR's Max Frames) and print a\n");
+    printf("           latency report at shutdown\n");
+    printf(" -p LIST   SCHED_FIFO priority per camera, e.g. 80,70 (implies --rt)\n");
+    printf("           (default: 80; the last entry is used for all further cameras)\n");
+    printf(" --rt-no-mlock  Do not lock memory in real-time mode\n");
     printf(" --help    Show this help\n");
     exit(ecode);
   }
 
-  MainWindow mainWin(start, enforce_affinity);
+  AffinityManager * affinity=0;
+  if (enforce_affinity || smt_vis || camera_cpus.isEmpty()==false || housekeeping_cpus.isEmpty()==false) {
+    AffinityManager::Options affinity_options;
+    affinity_options.camera_cpus=camera_cpus.toStdString();
+    affinity_options.housekeeping_cpus=housekeeping_cpus.toStdString();
+    affinity_options.smt_visualization=smt_vis;
+    affinity=new AffinityManager(affinity_options);
+  }
+
+  RealTimeManager * realtime=0;
+  if (rt_mode || rt_priorities.isEmpty()==false) {
+    RealTimeManager::Options rt_options;
+    if (rt_priorities.isEmpty()==false && RealTimeManager::parsePriorityList(rt_priorities.toStdString().c_str(),rt_options.capture_priorities)==false) {
+      fprintf(stderr,"Invalid real-time priority list: %s\n",rt_priorities.toStdString().c_str());
+      exit(1);
+    }
+    rt_options.lock_memory=!rt_no_mlock;
+    realtime=new RealTimeManager(rt_options);
+    realtime->lockMemory();
+  }
+
+  MainWindow mainWin(start, affinity, realtime);
   //if desired, launch a particular style:
   // app.setStyle(new QPlastiqueStyle());
   // app.setStyle(new QCleanlooksStyle());
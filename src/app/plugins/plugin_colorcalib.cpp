@@ -60,7 +60,7 @@ void PluginColorCalibration::mouseEvent( QMouseEvent * event, pixelloc loc) {
         rb->lockRead();
         int idx=rb->curRead();
         FrameData * frame = rb->getPointer(idx);
-        if (loc.x < frame->video.getWidth() && loc.y < frame->video.getHeight() && loc.x >=0 && loc.y >=0) {
+        if (frame->hasVideo() && loc.x < frame->video.getWidth() && loc.y < frame->video.getHeight() && loc.x >=0 && loc.y >=0) {
           if (frame->video.getWidth() > 1 && frame->video.getHeight() > 1) {
             yuv color;
             //if converting entire image then blanking is not needed
@@ -116,7 +116,8 @@ void PluginColorCalibration::keyPressEvent ( QKeyEvent * event ) {
       rb->lockRead();
       int idx=rb->curRead();
       FrameData * frame = rb->getPointer(idx);
-      lutw->sampleImage(frame->video);
+      //a zero-copy frame has no pixels once it is published:
+      if (frame->hasVideo()) lutw->sampleImage(frame->video);
       rb->unlockRead();
     }
     event->accept();
@@ -69,6 +69,24 @@ ProcessResult PluginColorThreshold::process(FrameData * data, RenderOptions * op
   return ProcessingOk;
 }
 
+size_t PluginColorThreshold::prefault(FrameData * data) {
+  size_t bytes=0;
+  Image<raw8> * img_thresholded;
+  if ((img_thresholded=(Image<raw8> *)data->map.get("cmv_threshold")) == 0) {
+    img_thresholded=(Image<raw8> *)data->map.insert("cmv_threshold",new Image<raw8>());
+  }
+  img_thresholded->allocate(data->video.getWidth(),data->video.getHeight());
+  bytes+=RealTimeManager::prefault(img_thresholded->getData(),img_thresholded->getNumBytes());
+
+  //the LUT is shared among stacks and may be edited by the GUI:
+  lut->lock();
+  bytes+=RealTimeManager::prefault(lut->getTable(),lut->getTableSize());
+  RGBLUT * rgblut = (RGBLUT *) lut->getDerivedLUT(CSPACE_RGB);
+  if (rgblut!=0) bytes+=RealTimeManager::prefault(rgblut->getTable(),rgblut->getTableSize());
+  lut->unlock();
+  return bytes;
+}
+
 VarList * PluginColorThreshold::getSettings() {
   return 0;
 }
@@ -39,6 +39,8 @@ public:
 
     virtual ProcessResult process(FrameData * data, RenderOptions * options);
 
+    virtual size_t prefault(FrameData * data);
+
     virtual VarList * getSettings();
 
     virtual string getName();
@@ -26,9 +26,9 @@
 #include "messages_robocup_ssl_detection.pb.h"
 #include "camera_calibration.h"
 #include "field_filter.h"
-#include "cmvision_histogram.h"
+#include "ball_detector.h"
 #include "vis_util.h"
-#include "VarNotifier.h"
+#include "settings_snapshot.h"
 #include "lut3d.h"
 /**
 	@author Author Name
@@ -70,41 +70,70 @@ protected:
     VarBool   * _ball_in_goal_filter;
 
 public:
+  /// a plain copy of all settings, see SettingsSnapshot
+  typedef BallDetector::Settings Snapshot;
+
+  void compile(Snapshot & s) const {
+    s.max_balls = _max_balls->getInt();
+    s.color_label = _color_label->getString();
+    s.z_height = _ball_z_height->getDouble();
+    s.min_width = _ball_min_width->getInt();
+    s.max_width = _ball_max_width->getInt();
+    s.min_height = _ball_min_height->getInt();
+    s.max_height = _ball_max_height->getInt();
+    s.min_area = _ball_min_area->getInt();
+    s.max_area = _ball_max_area->getInt();
+    s.filter_gauss = _ball_gauss_enabled->getBool();
+    s.exp_area_min = _ball_gauss_min->getInt();
+    s.exp_area_max = _ball_gauss_max->getInt();
+    s.exp_area_stddev = _ball_gauss_stddev->getDouble();
+    s.near_robot_filter = _ball_too_near_robot_enabled->getBool();
+    s.near_robot_dist = _ball_too_near_robot_dist->getDouble();
+    s.filter_ball_histogram = _ball_histogram_enabled->getBool();
+    s.min_greenness = _ball_histogram_min_greenness->getDouble();
+    s.max_markeryness = _ball_histogram_max_markeryness->getDouble();
+    s.filter_ball_in_field = _ball_on_field_filter->getBool();
+    s.filter_ball_on_field_filter_threshold = _ball_on_field_filter_threshold->getDouble();
+    s.filter_ball_in_goal = _ball_in_goal_filter->getBool();
+  }
+
   PluginDetectBallsSettings() {
+  //the defaults of BallDetector:
+  Snapshot d;
 
   _settings=new VarList("Ball Detection");
 
-  _settings->addChild(_max_balls = new VarInt("Max Ball Count",10));
-  _settings->addChild(_color_label = new VarString("Ball Color","Orange"));
+  _settings->addChild(_max_balls = new VarInt("Max Ball Count",d.max_balls));
+  _settings->addChild(_color_label = new VarString("Ball Color",d.color_label));
 
   _settings->addChild(_filter_general = new VarList("Ball Properties"));
-    _filter_general->addChild(_ball_z_height = new VarDouble("Ball Z-Height", 30.0));
-    _filter_general->addChild(_ball_min_width = new VarInt("Min Width (pixels)", 3));
-    _filter_general->addChild(_ball_max_width = new VarInt("Max Width (pixels)", 30));
-    _filter_general->addChild(_ball_min_height = new VarInt("Min Height (pixels)", 3));
-    _filter_general->addChild(_ball_max_height = new VarInt("Max Height (pixels)", 30));
-    _filter_general->addChild(_ball_min_area = new VarInt("Min Area (sq-pixels)", 9));
-    _filter_general->addChild(_ball_max_area = new VarInt("Max Area (sq-pixels)", 1000));    
+    _filter_general->addChild(_ball_z_height = new VarDouble("Ball Z-Height", d.z_height));
+    _filter_general->addChild(_ball_min_width = new VarInt("Min Width (pixels)", d.min_width));
+    _filter_general->addChild(_ball_max_width = new VarInt("Max Width (pixels)", d.max_width));
+    _filter_general->addChild(_ball_min_height = new VarInt("Min Height (pixels)", d.min_height));
+    _filter_general->addChild(_ball_max_height = new VarInt("Max Height (pixels)", d.max_height));
+    _filter_general->addChild(_ball_min_area = new VarInt("Min Area (sq-pixels)", d.min_area));
+    _filter_general->addChild(_ball_max_area = new VarInt("Max Area (sq-pixels)", d.max_area));    
 
   _settings->addChild(_filter_gauss = new VarList("Gaussian Size Filter"));
-    _filter_gauss->addChild(_ball_gauss_enabled = new VarBool("Enable Filter",true));
-    _filter_gauss->addChild(_ball_gauss_min = new VarInt("Expected Min Area (sq-pixels)", 30));
-    _filter_gauss->addChild(_ball_gauss_max = new VarInt("Expected Max Area (sq-pixels)", 40));
-    _filter_gauss->addChild(_ball_gauss_stddev = new VarDouble("Expected Area StdDev (sq-pixels)", 10.0));
+    _filter_gauss->addChild(_ball_gauss_enabled = new VarBool("Enable Filter",d.filter_gauss));
+    _filter_gauss->addChild(_ball_gauss_min = new VarInt("Expected Min Area (sq-pixels)", d.exp_area_min));
+    _filter_gauss->addChild(_ball_gauss_max = new VarInt("Expected Max Area (sq-pixels)", d.exp_area_max));
+    _filter_gauss->addChild(_ball_gauss_stddev = new VarDouble("Expected Area StdDev (sq-pixels)", d.exp_area_stddev));
 
   _settings->addChild(_filter_too_near_robot = new VarList("Near Robot Filter"));
-    _filter_too_near_robot->addChild(_ball_too_near_robot_enabled = new VarBool("Enable Filter",true));
-    _filter_too_near_robot->addChild(_ball_too_near_robot_dist = new VarDouble("Distance (mm)",70));
+    _filter_too_near_robot->addChild(_ball_too_near_robot_enabled = new VarBool("Enable Filter",d.near_robot_filter));
+    _filter_too_near_robot->addChild(_ball_too_near_robot_dist = new VarDouble("Distance (mm)",d.near_robot_dist));
 
   _settings->addChild(_filter_histogram = new VarList("Histogram Filter"));
-    _filter_histogram->addChild(_ball_histogram_enabled = new VarBool("Enable Filter",true));
-    _filter_histogram->addChild(_ball_histogram_min_greenness = new VarDouble("Min Greenness",0.5));
-    _filter_histogram->addChild(_ball_histogram_max_markeryness = new VarDouble("Max Markeryness",2.0));
+    _filter_histogram->addChild(_ball_histogram_enabled = new VarBool("Enable Filter",d.filter_ball_histogram));
+    _filter_histogram->addChild(_ball_histogram_min_greenness = new VarDouble("Min Greenness",d.min_greenness));
+    _filter_histogram->addChild(_ball_histogram_max_markeryness = new VarDouble("Max Markeryness",d.max_markeryness));
 
   _settings->addChild(_filter_geometry = new VarList("Geometry Filters"));
-    _filter_geometry->addChild(_ball_on_field_filter = new VarBool("Ball-In-Field Filter",true));
-    _filter_geometry->addChild(_ball_on_field_filter_threshold = new VarDouble("Ball-In-Field Extra Space (mm)",30.0));
-    _filter_geometry->addChild(_ball_in_goal_filter = new VarBool("Ball-In-Goal Filter",true));
+    _filter_geometry->addChild(_ball_on_field_filter = new VarBool("Ball-In-Field Filter",d.filter_ball_in_field));
+    _filter_geometry->addChild(_ball_on_field_filter_threshold = new VarDouble("Ball-In-Field Extra Space (mm)",d.filter_ball_on_field_filter_threshold));
+    _filter_geometry->addChild(_ball_in_goal_filter = new VarBool("Ball-In-Goal Filter",d.filter_ball_in_goal));
 
   }
   VarList * getSettings() {
@@ -117,54 +146,30 @@ class PluginDetectBalls : public VisionPlugin
 {
 protected:
   //-----------------------------
-  //local copies of the vartypes tree for better performance
-  //these are updated automatically if a change is reported by vartypes
-  VarNotifier vnotify;
-  bool filter_ball_in_field;
-  double filter_ball_on_field_filter_threshold;
-  bool filter_ball_in_goal;
-  bool filter_ball_histogram;
-  double min_greenness;
-  double max_markeryness;
-  bool filter_gauss;
-  int exp_area_min;
-  int exp_area_max;
-  double exp_area_var;
-  double z_height;
-  bool near_robot_filter;
-  double near_robot_dist_sq;
-  int max_balls;
+  //plain copy of the vartypes tree for lock-free access during processing
+  //this is swapped in by the parent stack whenever the vartypes change
+  SettingsSnapshot<PluginDetectBallsSettings> * snapshot;
+  SettingsSnapshotBase field_snapshot;
   //-----------------------------
-  
-  
-  
-  
-  
+
   LUT3D * _lut;
   PluginDetectBallsSettings * _settings; 
   bool _have_local_settings;
-  int color_id_orange;
-  int color_id_pink;
-  int color_id_yellow;
-  int color_id_field;
 
-  CMVision::Histogram * histogram;
-
-  CMVision::RegionFilter filter;
+  BallDetector detector;
 
   const CameraParameters& camera_parameters;
   const RoboCupField& field;
 
   FieldFilter field_filter;
 
-  bool checkHistogram(const Image<raw8> * image, const CMVision::Region * reg, double min_greenness=0.5, double max_markeryness=2.0);
-
 public:
     PluginDetectBalls(FrameBuffer * _buffer, LUT3D * lut, const CameraParameters& camera_params, const RoboCupField& field, PluginDetectBallsSettings * _settings=0);
 
     ~PluginDetectBalls();
 
     virtual ProcessResult process(FrameData * data, RenderOptions * options);
+    virtual void settingsSnapshotsUpdated();
     virtual VarList * getSettings();
     virtual string getName();
 };
@@ -44,13 +44,19 @@ PluginDetectRobots::PluginDetectRobots(FrameBuffer * _buffer, LUT3D * lut, const
   global_team_selector_blue=_global_team_selector_blue;
   global_team_selector_yellow=_global_team_selector_yellow;
 
-  team_detector_blue=new CMPattern::TeamDetector(_lut,camera_params,field);
-  team_detector_yellow=new CMPattern::TeamDetector(_lut,camera_params,field);
+  team_detector_blue=new CMPattern::TeamDetector(_lut);
+  team_detector_yellow=new CMPattern::TeamDetector(_lut);
 
   _settings=new VarList("Robot Detection");
-  _notifier.addRecursive(_settings);
-  connect(_global_team_selector_blue,SIGNAL(signalTeamDataChanged()),&_notifier,SLOT(changeSlotOtherChange()));
-  connect(_global_team_selector_yellow,SIGNAL(signalTeamDataChanged()),&_notifier,SLOT(changeSlotOtherChange()));
+  _need_reinit=true;
+  _team_snapshot.watch(_settings);
+  connect(_global_team_selector_blue,SIGNAL(signalTeamDataChanged()),&_team_snapshot,SLOT(invalidate()),Qt::DirectConnection);
+  connect(_global_team_selector_yellow,SIGNAL(signalTeamDataChanged()),&_team_snapshot,SLOT(invalidate()),Qt::DirectConnection);
+  addSettingsSnapshot(&_team_snapshot);
+}
+
+void PluginDetectRobots::settingsSnapshotsUpdated() {
+  _need_reinit=true;
 }
 
 PluginDetectRobots::~PluginDetectRobots()
@@ -116,7 +122,12 @@ ProcessResult PluginDetectRobots::process(FrameData * data, RenderOptions * opti
   //TODO: lookup color label from LUT
 
   buildRegionTree(colorlist);
-  bool need_reinit=_notifier.hasChanged();
+  bool need_reinit=_need_reinit;
+  _need_reinit=false;
+  if (need_reinit) field.updateFilter(field_filter);
+
+  //the calibration is read once per frame:
+  CameraModel camera = camera_parameters.getModel();
 
   for (int team_i = 0; team_i < 2; team_i++) {
     //team_i: 0==blue, 1==yellow
@@ -137,12 +148,15 @@ ProcessResult PluginDetectRobots::process(FrameData * data, RenderOptions * opti
     }
     if (team!=0) {
       if (need_reinit) {
-        detector->init(team);
+        CMPattern::TeamSettings team_settings;
+        team->compile(team_settings);
+        detector->init(team_settings,field_filter);
+        team->loadPatterns(detector->getModel(),*_lut);
       }
 
-      detector->update(robotlist, color_id,  num_robots, image, colorlist, reg_tree);
+      detector->update(robotlist, color_id,  num_robots, image, colorlist, reg_tree, camera);
     } else {
-      _notifier.changeSlotOtherChange();
+      _need_reinit=true;
     }
 
 //    printf("DETECTED %d robots on team %d\n",robotlist->size(),team_i);
@@ -31,14 +31,14 @@
 #include "cmpattern_team.h"
 #include "vis_util.h"
 #include "lut3d.h"
-#include "VarNotifier.h"
 /**
 	@author Author Name
 */
 class PluginDetectRobots : public VisionPlugin
 {
 protected:
-  VarNotifier _notifier;
+  SettingsSnapshotBase _team_snapshot;
+  bool _need_reinit;
   LUT3D * _lut;
   VarList * _settings;
 
@@ -62,6 +62,7 @@ protected:
 
   const CameraParameters& camera_parameters;
   const RoboCupField& field;
+  FieldFilter field_filter;
 
   void buildRegionTree(CMVision::ColorRegionList * colorlist);
 
@@ -73,6 +74,7 @@ public:
     ~PluginDetectRobots();
 
     virtual ProcessResult process(FrameData * data, RenderOptions * options);
+    virtual void settingsSnapshotsUpdated();
     virtual VarList * getSettings();
     virtual string getName();
 };
@@ -410,6 +410,19 @@ void DVRFrame::getFromFrameData(FrameData * data) {
   video.deepCopyFromRawImage(data->video,true);
 }
 
+size_t PluginDVR::prefault(FrameData * data) {
+  //this is called for every frame of the ringbuffer, but the recording
+  //buffers only need to be reserved once:
+  size_t bytes=0;
+  if (pause_frame.video.getNumBytes()!=data->video.getNumBytes()) {
+    pause_frame.video.allocate(data->video.getColorFormat(),data->video.getWidth(),data->video.getHeight());
+    bytes+=RealTimeManager::prefault(pause_frame.video.getData(),pause_frame.video.getNumBytes());
+  }
+  stream.setLimit(_max_frames->getInt());
+  bytes+=stream.reserve(_max_frames->getInt(),data->video);
+  return bytes;
+}
+
 ProcessResult PluginDVR::process(FrameData * data, RenderOptions * options) {
   (void)options;
   QString status;
@@ -484,12 +497,15 @@ ProcessResult PluginDVR::process(FrameData * data, RenderOptions * options) {
   }
 
   //output data:
+  //(never write into a borrowed driver buffer, see FrameData::borrowVideo)
   if (mode==DVRModePause) {
+    data->restoreVideo();
     data->video.deepCopyFromRawImage(pause_frame.video,false);
   } else if (mode==DVRModeRecord) {
     if (seek_mode!=SeekModeLive && stream.getFrameCount() > 0) {
       DVRFrame * f = stream.getCurrentFrame();
       if (f!=0) {
+        data->restoreVideo();
         data->video.deepCopyFromRawImage(f->video,false);
       }
     }
@@ -519,24 +535,47 @@ void DVRStream::saveStream(QString directory) {
 
 void DVRStream::clear() {
   for (int i = 0; i < frames.size(); i++) {
-    delete frames[i];
+    recycleFrame(frames[i]);
   }
   frames.clear();
   current=0;
 }
 
+DVRFrame * DVRStream::takeFrame() {
+  if (pool.isEmpty()) return new DVRFrame();
+  return pool.takeLast();
+}
+
+void DVRStream::recycleFrame(DVRFrame * f) {
+  //keep at most enough frames to record up to the limit:
+  if (limit!=0 && pool.size() < limit) {
+    pool.append(f);
+  } else {
+    delete f;
+  }
+}
+
+size_t DVRStream::reserve(int num_frames, const RawImage & video) {
+  size_t bytes=0;
+  while (frames.size() + pool.size() < num_frames) {
+    DVRFrame * f = new DVRFrame();
+    f->video.allocate(video.getColorFormat(),video.getWidth(),video.getHeight());
+    bytes+=RealTimeManager::prefault(f->video.getData(),f->video.getNumBytes());
+    pool.append(f);
+  }
+  return bytes;
+}
+
 void DVRStream::appendFrame(FrameData * data, bool shift_stream_on_limit_exceed) {
   if (limit!=0 && ((getFrameCount() + 1) > limit)) {
     if (shift_stream_on_limit_exceed) {
-      DVRFrame * f = frames[0];
-      delete f;
-      frames.removeFirst();
+      recycleFrame(frames.takeFirst());
       if (current > 0) current--;
     } else {
       return;
     }
   }
-  DVRFrame * f = new DVRFrame();
+  DVRFrame * f = takeFrame();
   f->getFromFrameData(data);
   frames.append(f);
 }
@@ -564,7 +603,12 @@ DVRStream::DVRStream() {
   clear();
 }
 DVRStream::~DVRStream() {
- clear();
+  limit=0;
+  clear();
+  for (int i = 0; i < pool.size(); i++) {
+    delete pool[i];
+  }
+  pool.clear();
 }
 void DVRStream::advance(int frames, bool wrap) {
   if (getFrameCount() == 0) return;
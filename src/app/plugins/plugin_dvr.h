@@ -98,8 +98,11 @@ class DVRStream
   //TODO: add partial memory buffering for long video streams.
   protected:
     QList<DVRFrame *> frames;
+    QList<DVRFrame *> pool; //recycled frames, reused by appendFrame()
     int limit;
     int current;
+    DVRFrame * takeFrame();
+    void recycleFrame(DVRFrame * f);
   public:
     DVRStream();
     virtual ~DVRStream();
@@ -110,6 +113,9 @@ class DVRStream
     void saveStream(QString directory);
     void clear();
     void appendFrame(FrameData * data, bool shift_stream_on_limit_exceed);
+    /// pre-allocates and prefaults frames like \p video until the stream
+    /// and its pool together hold \p num_frames frames
+    size_t reserve(int num_frames, const RawImage & video);
     void seek(int frame);
     int getFrameCount();
     void advance(int frames, bool wrap);
@@ -172,6 +178,7 @@ public:
     virtual string getName();
     virtual QWidget * getControlWidget();
     virtual ProcessResult process(FrameData * data, RenderOptions * options);
+    virtual size_t prefault(FrameData * data);
 };
 
 #endif
@@ -19,29 +19,57 @@
 */
 //========================================================================
 #include "plugin_publishgeometry.h"
+#include <unistd.h>
+#include "timer.h"
 
-PluginPublishGeometry::PluginPublishGeometry(FrameBuffer * fb, RoboCupSSLServer * server, const RoboCupField & field)
+PluginPublishGeometry::PluginPublishGeometry(FrameBuffer * fb, RoboCupSSLServer * server, const RoboCupField & field, bool publisher_thread, AffinityManager * _affinity)
  : VisionPlugin(fb), _field(field)
 {
   _server=server;
+  affinity=_affinity;
   setSharedAmongStacks(true);
   _settings=new VarList("Publish Geometry");
   _settings->addChild(_pub=new VarTrigger("Publish","Publish!"));
   _settings->addChild(_pub_auto=new VarList("Auto Publish"));
   _pub_auto->addChild(_pub_auto_enable=new VarBool("Enable",true));
   _pub_auto->addChild(_pub_auto_interval=new VarDouble("Interval (seconds)",3.0));
-  last_t=0;
+  _settings->addChild(_pub_request=new VarList("Publish on Request"));
+  _pub_request->addChild(_request_enable=new VarBool("Enable",true));
+  _pub_request->addChild(_request_port=new VarInt("Request Port",10013,1,65535));
+  request_port=0;
+  cache_valid=false;
+  publish_requested=true;
   connect(_pub,SIGNAL(signalTriggered()),this,SLOT(slotPublishTriggered()));
+  //the slot only sets a flag, so it may run in the thread of the change:
+  connect(&_field,SIGNAL(calibrationChanged()),this,SLOT(slotGeometryChanged()),Qt::DirectConnection);
+  last_t=0.0;
+  running=true;
+  publisher=0;
+  if (publisher_thread) {
+    publisher=new PublishThread(this);
+    publisher->start();
+  }
 }
 
 void PluginPublishGeometry::addCameraParameters(CameraParameters * param) {
   lock();
   params.push_back(param);
   unlock();
+  VarDouble * vars[] = {param->focal_length, param->principal_point_x, param->principal_point_y, param->distortion,
+                        param->q0, param->q1, param->q2, param->q3, param->tx, param->ty, param->tz};
+  for (unsigned int i = 0; i < sizeof(vars)/sizeof(vars[0]); i++) {
+    connect(vars[i],SIGNAL(hasChanged(VarType *)),this,SLOT(slotGeometryChanged()),Qt::DirectConnection);
+  }
+  slotGeometryChanged();
 }
 
 PluginPublishGeometry::~PluginPublishGeometry()
 {
+  running=false;
+  if (publisher!=0) {
+    publisher->wait();
+    delete publisher;
+  }
   delete _settings;
   delete _pub;
 }
@@ -55,33 +83,85 @@ string PluginPublishGeometry::getName() {
 }
 
 void PluginPublishGeometry::sendGeometry() {
-  SSL_GeometryData geodata;
-  SSL_GeometryFieldSize * gfield = geodata.mutable_field();
-  _field.toProtoBuffer(*gfield);
-  for (unsigned int i = 0; i < params.size(); i++) {
-    SSL_GeometryCameraCalibration * calib = geodata.add_calib();
-    params[i]->toProtoBuffer(*calib,i);
+  if (cache_valid==false) {
+    //a change while the geometry is read invalidates the cache again:
+    cache_valid=true;
+    __sync_synchronize();
+    SSL_WrapperPacket packet;
+    SSL_GeometryData * geodata = packet.mutable_geometry();
+    SSL_GeometryFieldSize * gfield = geodata->mutable_field();
+    _field.toProtoBuffer(*gfield);
+    lock();
+    for (unsigned int i = 0; i < params.size(); i++) {
+      SSL_GeometryCameraCalibration * calib = geodata->add_calib();
+      params[i]->toProtoBuffer(*calib,i);
+    }
+    unlock();
+    packet.SerializeToString(&cache);
   }
-  _server->send(geodata);
+  _server->sendSerialized(cache.data(),cache.size());
 }
 
 void PluginPublishGeometry::slotPublishTriggered() {
-  lock();
-    sendGeometry();
-  unlock();
+  publish_requested=true;
 }
 
-ProcessResult PluginPublishGeometry::process(FrameData * data, RenderOptions * options) {
-  (void)data;
-  (void)options;
-  //TODO: check client requests in server process
-  //      if requested, call sendGeometry();
-  if (_pub_auto_enable->getBool()==true) {
-    double t = data->time - last_t;
-    if (t > _pub_auto_interval->getDouble()) {
+void PluginPublishGeometry::slotGeometryChanged() {
+  cache_valid=false;
+  publish_requested=true;
+}
+
+void PluginPublishGeometry::updateRequestSocket() {
+  int port = (_request_enable->getBool() ? _request_port->getInt() : 0);
+  if (port==request_port) return;
+  request_socket.close();
+  request_port=port;
+  if (port!=0 && request_socket.open(port)==false) {
+    //not retried until the port is changed
+    fprintf(stderr,"Publish Geometry: unable to open the request port %d\n",port);
+  }
+}
+
+void PluginPublishGeometry::runPublisher() {
+  if (affinity!=0) affinity->demandHousekeeping();
+  char request[1500];
+  while (running) {
+    updateRequestSocket();
+    bool requested=false;
+    if (request_socket.isOpen()) {
+      if (request_socket.wait(PollInterval)) {
+        //any datagram is a request. All pending requests are served by one packet.
+        Net::Address src;
+        while (request_socket.recv(request,sizeof(request),src) >= 0) requested=true;
+      }
+    } else {
+      usleep(PollInterval*1000);
+    }
+    //requests and changes wait until RefreshNetworkOutput() has opened the server:
+    if (_server->isOpen()==false) {
+      if (requested) publish_requested=true;
+      continue;
+    }
+    double t=GetTimeSec();
+    bool timer=(_pub_auto_enable->getBool() && t - last_t > _pub_auto_interval->getDouble());
+    if (requested || publish_requested || timer) {
+      publish_requested=false;
       sendGeometry();
-      last_t=data->time;
+      last_t=t;
     }
   }
+  request_socket.close();
+}
+
+ProcessResult PluginPublishGeometry::process(FrameData * data, RenderOptions * options) {
+  (void)options;
+  if (publisher!=0) return ProcessingOk;
+  publish_mutex.lock();
+  if (publish_requested || (_pub_auto_enable->getBool() && data->time - last_t > _pub_auto_interval->getDouble())) {
+    publish_requested=false;
+    sendGeometry();
+    last_t=data->time;
+  }
+  publish_mutex.unlock();
   return ProcessingOk;
 }
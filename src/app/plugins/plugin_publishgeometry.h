@@ -22,18 +22,50 @@
 #define PLUGIN_PUBLISHGEOMETRY_H
 
 #include <visionplugin.h>
+#include <QThread>
 #include "robocup_ssl_server.h"
 #include "camera_calibration.h"
 #include "messages_robocup_ssl_geometry.pb.h"
 #include "VarTypes.h"
+#include "affinity_manager.h"
 
 /**
 	@author Author Name
+
+	The geometry (field size and the calibrations of all cameras) is
+	serialized once and cached until one of its VarTypes changes.
+
+	With \p publisher_thread, it is sent by a thread of the plugin: after a
+	change, on the auto publish interval, when "Publish!" is triggered, and
+	whenever any datagram arrives on the request port, but only while the
+	server is open. So the camera threads never serialize it, and process()
+	does nothing. The thread pins itself to the housekeeping cpus of
+	\p affinity, if given.
+
+	Without, no thread is started and no request port is bound (e.g. for
+	offline processing, or next to a running vision). process() then sends
+	the geometry on the auto publish interval of the frame times, and on the
+	first frame after a change or a trigger, so that the output only
+	depends on the processed frames.
 */
 class PluginPublishGeometry : public VisionPlugin
 {
 Q_OBJECT
 protected:
+  class PublishThread : public QThread {
+  protected:
+    PluginPublishGeometry * plugin;
+  public:
+    PublishThread(PluginPublishGeometry * _plugin) {
+      plugin=_plugin;
+    }
+    virtual void run() {
+      plugin->runPublisher();
+    }
+  };
+  friend class PublishThread;
+  static const int PollInterval=100; //ms, the latency of a change or a trigger
+
   RoboCupSSLServer * _server;
   const RoboCupField & _field;
   vector<CameraParameters *> params;
@@ -42,13 +74,31 @@ protected:
   VarBool * _pub_auto_enable;
   VarDouble * _pub_auto_interval;
   VarList * _pub_auto;
-  QMutex mutex;
+  VarList * _pub_request;
+  VarBool * _request_enable;
+  VarInt * _request_port;
+
+  //owned by the publisher thread:
+  string cache; //the serialized SSL_WrapperPacket
+  Net::UDP request_socket;
+  int request_port;
+
+  volatile bool cache_valid;
+  volatile bool publish_requested;
+  volatile bool running;
+  PublishThread * publisher; //0 if process() publishes
+  AffinityManager * affinity;
+  QMutex publish_mutex; //serializes sendGeometry() of the camera threads
+  double last_t; //the frame time of the last publish by process()
+
   void sendGeometry();
-  double last_t;
+  void updateRequestSocket();
+  void runPublisher();
 protected slots:
   void slotPublishTriggered();
+  void slotGeometryChanged();
 public:
-    PluginPublishGeometry(FrameBuffer * fb, RoboCupSSLServer * server, const RoboCupField & field);
+    PluginPublishGeometry(FrameBuffer * fb, RoboCupSSLServer * server, const RoboCupField & field, bool publisher_thread=false, AffinityManager * _affinity=0);
     void addCameraParameters(CameraParameters * param);
     virtual VarList * getSettings();
     virtual ~PluginPublishGeometry();
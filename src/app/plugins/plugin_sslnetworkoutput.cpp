@@ -20,10 +20,12 @@
 //========================================================================
 #include "plugin_sslnetworkoutput.h"
 
-PluginSSLNetworkOutput::PluginSSLNetworkOutput(FrameBuffer * _fb, RoboCupSSLServer * udp_server, const CameraParameters& camera_params, const RoboCupField& field)
+PluginSSLNetworkOutput::PluginSSLNetworkOutput(FrameBuffer * _fb, RoboCupSSLServer * udp_server, const CameraParameters& camera_params, const RoboCupField& field, CameraCycleAggregator * cycle_aggregator, RoboCupSSLAsyncServer * compact_server)
  : VisionPlugin(_fb), _camera_params(camera_params), _field(field)
 {
   _udp_server=udp_server;
+  _cycle_aggregator=cycle_aggregator;
+  _compact_server=compact_server;
 }
 
 PluginSSLNetworkOutput::~PluginSSLNetworkOutput()
@@ -46,6 +48,13 @@ ProcessResult PluginSSLNetworkOutput::process(FrameData * data, RenderOptions *
     detection_frame->set_camera_id(data->cam_id);
     detection_frame->set_t_sent(GetTimeSec());
     _udp_server->send(*detection_frame);
+    if (_cycle_aggregator!=0) _cycle_aggregator->add(*detection_frame);
+    //the compact server is only enabled with "Compact Output", and queues
+    //the frame of this thread for its sender:
+    if (_compact_server!=0 && _compact_server->isEnabled()) {
+      RoboCupSSLCompact::encode(*detection_frame,compact_frame);
+      _compact_server->send(compact_frame);
+    }
   }
   return ProcessingOk;
 }
@@ -61,6 +70,42 @@ PluginSSLNetworkOutputSettings::PluginSSLNetworkOutputSettings()
   settings->addChild(multicast_address = new VarString("Multicast Address","224.5.23.2"));
   settings->addChild(multicast_port = new VarInt("Multicast Port",10002,1,65535));
   settings->addChild(multicast_interface = new VarString("Multicast Interface",""));
+  settings->addChild(asynchronous = new VarBool("Asynchronous Sender",true));
+  settings->addChild(batch_window = new VarDouble("Batch Window (ms)",0.0,0.0,10.0));
+  settings->addChild(shared_memory = new VarBool("Shared Memory Output",false));
+  settings->addChild(shared_memory_name = new VarString("Shared Memory Name","/ssl-vision"));
+  settings->addChild(compact = new VarBool("Compact Output",false));
+  settings->addChild(compact_port = new VarInt("Compact Port",10014,1,65535));
+
+  settings->addChild(sender_statistics = new VarList("Sender Statistics"));
+  sender_statistics->addFlags(VARTYPE_FLAG_NOSAVE | VARTYPE_FLAG_NOLOAD);
+  sender_statistics->addChild(sender_reset = new VarTrigger("Reset","Reset"));
+  send_latency = new LatencyStatistics("Send Latency");
+  sender_statistics->addChild(send_latency->getSettings());
+  sender_statistics->addChild(sent_packets = new VarInt("Sent Packets",0));
+  sender_statistics->addChild(sent_batches = new VarInt("Batches",0));
+  sender_statistics->addChild(dropped_packets = new VarInt("Dropped Packets",0));
+  sender_statistics->addChild(send_errors = new VarInt("Send Errors",0));
+  sender_statistics->addChild(max_queue_depth = new VarInt("Max Queue Depth",0));
+  sent_packets->addFlags(VARTYPE_FLAG_READONLY);
+  sent_batches->addFlags(VARTYPE_FLAG_READONLY);
+  dropped_packets->addFlags(VARTYPE_FLAG_READONLY);
+  send_errors->addFlags(VARTYPE_FLAG_READONLY);
+  max_queue_depth->addFlags(VARTYPE_FLAG_READONLY);
+}
+
+void PluginSSLNetworkOutputSettings::updateSenderStatistics(RoboCupSSLAsyncServer * server)
+{
+  if (sender_reset->getAndResetCounter() > 0) server->resetStatistics();
+  RoboCupSSLAsyncServer::Statistics stats;
+  server->getStatistics(stats);
+  send_latency->hist=stats.latency;
+  send_latency->update();
+  sent_packets->setInt((int)stats.packets);
+  sent_batches->setInt((int)stats.batches);
+  dropped_packets->setInt((int)stats.dropped);
+  send_errors->setInt((int)stats.errors);
+  max_queue_depth->setInt(stats.max_depth);
 }
   
 VarList * PluginSSLNetworkOutputSettings::getSettings()
@@ -23,6 +23,10 @@
 
 #include <visionplugin.h>
 #include "robocup_ssl_server.h"
+#include "robocup_ssl_async_server.h"
+#include "robocup_ssl_compact.h"
+#include "latency_statistics.h"
+#include "camera_cycle_aggregator.h"
 #include "camera_calibration.h"
 #include "field.h"
 #include "timer.h"
@@ -36,8 +40,11 @@ protected:
  const CameraParameters& _camera_params;
  const RoboCupField& _field;
  RoboCupSSLServer * _udp_server;
+ CameraCycleAggregator * _cycle_aggregator;
+ RoboCupSSLAsyncServer * _compact_server;
+ SSL_CompactDetectionFrame compact_frame;
 public:
-    PluginSSLNetworkOutput(FrameBuffer * _fb, RoboCupSSLServer * udp_server, const CameraParameters& camera_params, const RoboCupField& field);
+    PluginSSLNetworkOutput(FrameBuffer * _fb, RoboCupSSLServer * udp_server, const CameraParameters& camera_params, const RoboCupField& field, CameraCycleAggregator * cycle_aggregator=0, RoboCupSSLAsyncServer * compact_server=0);
 
     ~PluginSSLNetworkOutput();
 
@@ -51,9 +58,26 @@ public:
   VarString * multicast_address;
   VarInt * multicast_port;
   VarString * multicast_interface;
+  VarBool * asynchronous;
+  VarDouble * batch_window;
+  VarBool * shared_memory;
+  VarString * shared_memory_name;
+  VarBool * compact;
+  VarInt * compact_port;
+
+  VarList * sender_statistics;
+  VarTrigger * sender_reset;
+  LatencyStatistics * send_latency;
+  VarInt * sent_packets;
+  VarInt * sent_batches;
+  VarInt * dropped_packets;
+  VarInt * send_errors;
+  VarInt * max_queue_depth;
 
   PluginSSLNetworkOutputSettings();
   VarList * getSettings();
+  /// shows the statistics of \p server in the "Sender Statistics"
+  void updateSenderStatistics(RoboCupSSLAsyncServer * server);
 };
 
 #endif
@@ -0,0 +1,57 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    settings_snapshot.cpp
+  \brief   C++ Implementation: SettingsSnapshot
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "settings_snapshot.h"
+
+SettingsSnapshotBase::SettingsSnapshotBase() : dirty(1)
+{
+}
+
+SettingsSnapshotBase::~SettingsSnapshotBase()
+{
+}
+
+void SettingsSnapshotBase::compile() {
+}
+
+void SettingsSnapshotBase::invalidate() {
+  dirty.fetchAndStoreOrdered(1);
+}
+
+void SettingsSnapshotBase::invalidate(VarType * item) {
+  (void)item;
+  dirty.fetchAndStoreOrdered(1);
+}
+
+void SettingsSnapshotBase::watch(VarType * root) {
+  if (root==0) return;
+  connect(root,SIGNAL(hasChanged(VarType *)),this,SLOT(invalidate(VarType *)),Qt::DirectConnection);
+  vector<VarType *> children = root->getChildren();
+  for (unsigned int i=0;i<children.size();i++) {
+    watch(children[i]);
+  }
+  invalidate();
+}
+
+bool SettingsSnapshotBase::update() {
+  if (dirty.fetchAndStoreOrdered(0)==0) return false;
+  compile();
+  return true;
+}
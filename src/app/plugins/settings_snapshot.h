@@ -0,0 +1,99 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    settings_snapshot.h
+  \brief   C++ Interface: SettingsSnapshot
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef SETTINGS_SNAPSHOT_H
+#define SETTINGS_SNAPSHOT_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include "VarTypes.h"
+using namespace VarTypes;
+
+/*!
+  \class   SettingsSnapshotBase
+  \brief   Tracks changes of one or more VarTypes subtrees without locking
+  \author  Author Name, 2026
+
+  Any change of a watched VarType marks the snapshot as dirty.
+  The parent VisionStack calls update() between frames, which recompiles
+  the snapshot from the VarTypes tree only if it is dirty.
+  Checking for changes is a single atomic exchange, so plugins do not need
+  to poll a VarNotifier (and its mutex) on every frame.
+*/
+class SettingsSnapshotBase : public QObject {
+Q_OBJECT
+protected:
+  QAtomicInt dirty;
+
+  /// rebuild the snapshot from the VarTypes tree.
+  /// this is called from the processing thread, inside update().
+  virtual void compile();
+public slots:
+  /// marks the snapshot as dirty. It will be recompiled before the next frame.
+  void invalidate();
+  void invalidate(VarType * item);
+public:
+  SettingsSnapshotBase();
+  virtual ~SettingsSnapshotBase();
+
+  /// recursively watch all nodes of \p root for changes
+  void watch(VarType * root);
+
+  /// recompiles the snapshot if any watched item has changed since
+  /// the last call. Returns true if a new snapshot was swapped in.
+  bool update();
+};
+
+/*!
+  \class   SettingsSnapshot
+  \brief   A plain-struct copy of a settings VarList, compiled on change
+
+  \p SOURCE is a settings class (such as PluginDetectBallsSettings) which
+  defines a plain struct \c SOURCE::Snapshot and a method
+  \c compile(SOURCE::Snapshot &) const that copies its VarTypes into it.
+
+  The snapshot is double-buffered: compile() writes the inactive copy and then
+  flips the current index, so get() always returns a complete snapshot.
+*/
+template <class SOURCE>
+class SettingsSnapshot : public SettingsSnapshotBase {
+public:
+  typedef typename SOURCE::Snapshot Snapshot;
+protected:
+  SOURCE * source;
+  Snapshot snapshots[2];
+  volatile int current;
+  virtual void compile() {
+    int next = 1 - current;
+    source->compile(snapshots[next]);
+    current = next;
+  }
+public:
+  SettingsSnapshot(SOURCE * _source) : source(_source), current(0) {
+    watch(source->getSettings());
+  }
+  /// returns the currently active snapshot.
+  /// this reference stays valid until the next call of update()
+  const Snapshot & get() const {
+    return snapshots[current];
+  }
+};
+
+#endif
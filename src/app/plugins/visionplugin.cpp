@@ -52,6 +52,31 @@ void VisionPlugin::unlock() {
   mutex.unlock();
 }
 
+bool VisionPlugin::tryLock() {
+  return mutex.tryLock();
+}
+
+void VisionPlugin::addSettingsSnapshot(SettingsSnapshotBase * snapshot) {
+  snapshots.push_back(snapshot);
+}
+
+bool VisionPlugin::updateSettingsSnapshots() {
+  bool updated=false;
+  unsigned int n=snapshots.size();
+  for (unsigned int i=0;i<n;i++) {
+    if (snapshots[i]->update()) updated=true;
+  }
+  return updated;
+}
+
+void VisionPlugin::settingsSnapshotsUpdated() {
+}
+
+size_t VisionPlugin::prefault(FrameData * data) {
+  (void)data;
+  return 0;
+}
+
 bool VisionPlugin::isEnabled() const {
   return enabled;
 }
@@ -31,6 +31,8 @@
 #include "framedata.h"
 #include "realtimedisplaywidget.h"
 #include "pixelloc.h"
+#include "settings_snapshot.h"
+#include "realtime_manager.h"
 using namespace std;
 using namespace VarTypes;
 
@@ -58,6 +60,11 @@ protected:
     FrameBuffer * buffer;
     double time_proc;
     double time_post;
+    vector<SettingsSnapshotBase *> snapshots;
+
+    /// registers a settings snapshot which will be refreshed
+    /// by the parent-stack between frames (see SettingsSnapshot)
+    void addSettingsSnapshot(SettingsSnapshotBase * snapshot);
 public:
 
 
@@ -76,6 +83,24 @@ public:
     /// you should *NOT* need to touch them
     void lock();
     void unlock();
+    bool tryLock();
+
+    /// this function is called automatically by the parent-stack before process().
+    /// It swaps in all registered settings snapshots that have changed
+    /// and returns true if any of them did.
+    bool updateSettingsSnapshots();
+
+    /// called by the parent-stack after updateSettingsSnapshots() returned true.
+    /// overload this to rebuild any state derived from your settings snapshots.
+    virtual void settingsSnapshotsUpdated();
+
+    /// called by the parent-stack in real-time mode, once for every frame of the
+    /// ringbuffer before the first frame is published. \p data holds an
+    /// allocated video image of the current capture format.
+    /// overload this to allocate and prefault (see RealTimeManager::prefault)
+    /// any buffers that would otherwise be touched for the first time during
+    /// processing. Returns the number of bytes prefaulted.
+    virtual size_t prefault(FrameData * data);
 
     /// indicates whether this plugin will be used
     /// (e.g. whether process() will be called on it)
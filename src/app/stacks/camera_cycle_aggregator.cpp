@@ -0,0 +1,244 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    camera_cycle_aggregator.cpp
+  \brief   C++ Implementation: CameraCycleAggregator
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "camera_cycle_aggregator.h"
+#include <math.h>
+#include <stdio.h>
+#include "timer.h"
+
+const double CameraCycleAggregator::ActiveTimeout=1.0;
+
+CameraCycleAggregator::CameraCycleAggregator(AffinityManager * _affinity)
+{
+  affinity=_affinity;
+  settings=new VarList("Camera Cycle Aggregation");
+  settings->addChild(v_enable=new VarBool("Enable",false));
+  settings->addChild(v_address=new VarString("Multicast Address","224.5.23.2"));
+  settings->addChild(v_port=new VarInt("Multicast Port",10012,1,65535));
+  settings->addChild(v_interface=new VarString("Multicast Interface",""));
+  settings->addChild(v_tolerance=new VarDouble("Match Tolerance (ms)",8.0,0.0,100.0));
+  settings->addChild(v_deadline=new VarDouble("Deadline (ms)",12.0,0.0,1000.0));
+
+  settings->addChild(statistics=new VarList("Statistics"));
+  statistics->addFlags(VARTYPE_FLAG_NOSAVE | VARTYPE_FLAG_NOLOAD);
+  statistics->addChild(v_reset=new VarTrigger("Reset","Reset"));
+  cycle_latency=new LatencyStatistics("Cycle Latency");
+  statistics->addChild(cycle_latency->getSettings());
+  statistics->addChild(v_cycles=new VarInt("Cycles",0));
+  statistics->addChild(v_complete=new VarInt("Complete Cycles",0));
+  statistics->addChild(v_late_frames=new VarInt("Late Frames",0));
+  statistics->addChild(v_dropped=new VarInt("Dropped Cycles",0));
+  v_cycles->addFlags(VARTYPE_FLAG_READONLY);
+  v_complete->addFlags(VARTYPE_FLAG_READONLY);
+  v_late_frames->addFlags(VARTYPE_FLAG_READONLY);
+  v_dropped->addFlags(VARTYPE_FLAG_READONLY);
+
+  cycle_open=false;
+  cycle_t_capture=0.0;
+  cycle_t_first=0.0;
+  cycle_cameras=0;
+  cycle_number=0;
+  has_last=false;
+  last_t_capture=0.0;
+  for (int i=0;i<MaxCameras;i++) t_seen[i]=-ActiveTimeout;
+  ready=false;
+  ready_t_first=0.0;
+  cycles=complete=late_frames=dropped=0;
+
+  server=0;
+  server_port=0;
+
+  enabled=false;
+  match_tolerance=0.0;
+  deadline=0.0;
+
+  running=true;
+}
+
+CameraCycleAggregator::~CameraCycleAggregator()
+{
+  mutex.lock();
+  running=false;
+  wakeup.wakeAll();
+  mutex.unlock();
+  wait();
+  delete server;
+  statistics->removeChild(cycle_latency->getSettings());
+  delete cycle_latency;
+  statistics->deleteAllChildren();
+  settings->deleteAllChildren();
+  delete settings;
+}
+
+VarList * CameraCycleAggregator::getSettings()
+{
+  return settings;
+}
+
+unsigned int CameraCycleAggregator::activeCameras(double t) const
+{
+  unsigned int result=0;
+  for (int i=0;i<MaxCameras;i++) {
+    if (t - t_seen[i] < ActiveTimeout) result|=(1u << i);
+  }
+  return result;
+}
+
+void CameraCycleAggregator::add(const SSL_DetectionFrame & frame)
+{
+  if (enabled==false) return;
+  int camera=frame.camera_id();
+  if (camera < 0 || camera >= MaxCameras) return;
+  double tolerance=match_tolerance;
+  double t_capture=frame.t_capture();
+  double t=GetTimeSec();
+
+  mutex.lock();
+  t_seen[camera]=t;
+  if (cycle_open) {
+    if (t_capture < cycle_t_capture - tolerance) {
+      //a frame of a cycle that has been closed already
+      late_frames++;
+      mutex.unlock();
+      return;
+    }
+    if (t_capture > cycle_t_capture + tolerance || (cycle_cameras & (1u << camera)) != 0) {
+      closeCycle(t);
+    }
+  } else if (has_last && t_capture <= last_t_capture + tolerance && t_capture > last_t_capture - ActiveTimeout) {
+    //a frame of the last cycle, after its deadline. Frames from much earlier
+    //mean that the capture clock has been reset, and start a new cycle.
+    late_frames++;
+    mutex.unlock();
+    return;
+  }
+  if (cycle_open==false) {
+    open_cycle.Clear(); //keeps the frames of earlier cycles for reuse
+    cycle_open=true;
+    cycle_t_capture=t_capture;
+    cycle_t_first=t;
+    cycle_cameras=0;
+    wakeup.wakeOne(); //to wait for the deadline of this cycle
+  }
+  open_cycle.add_frames()->CopyFrom(frame);
+  cycle_cameras|=(1u << camera);
+  unsigned int active=activeCameras(t);
+  if ((cycle_cameras & active) == active) closeCycle(t);
+  mutex.unlock();
+}
+
+void CameraCycleAggregator::closeCycle(double t)
+{
+  unsigned int late=activeCameras(t) & ~cycle_cameras;
+  open_cycle.set_cycle_number(cycle_number++);
+  open_cycle.set_t_capture(cycle_t_capture);
+  open_cycle.set_t_sent(0.0);
+  for (int i=0;i<MaxCameras;i++) {
+    if ((late & (1u << i)) != 0) open_cycle.add_late_cameras(i);
+  }
+  cycles++;
+  if (late==0) complete++;
+  if (ready) dropped++;
+  ready_cycle.Swap(&open_cycle);
+  ready=true;
+  ready_t_first=cycle_t_first;
+  has_last=true;
+  last_t_capture=cycle_t_capture;
+  cycle_open=false;
+  wakeup.wakeOne();
+}
+
+void CameraCycleAggregator::sendCycle()
+{
+  int port=v_port->getInt();
+  string address=v_address->getString();
+  string interface=v_interface->getString();
+  if (server==0 || port!=server_port || address!=server_address || interface!=server_interface) {
+    delete server;
+    server=new RoboCupSSLServer(port,address,interface);
+    server_port=port;
+    server_address=address;
+    server_interface=interface;
+    if (server->open()==false) {
+      fprintf(stderr,"Camera Cycle Aggregation: unable to open the server on %s:%d\n",address.c_str(),port);
+    }
+  }
+  send_cycle.set_t_sent(GetTimeSec());
+  server->send(send_cycle);
+}
+
+void CameraCycleAggregator::run()
+{
+  if (affinity!=0) affinity->demandHousekeeping();
+  mutex.lock();
+  while (running) {
+    if (ready) {
+      send_cycle.Swap(&ready_cycle);
+      ready=false;
+      double t_first=ready_t_first;
+      mutex.unlock();
+      sendCycle();
+      double t_sent=send_cycle.t_sent();
+      mutex.lock();
+      latency.add(t_sent - t_first);
+    } else if (cycle_open) {
+      double t_deadline=cycle_t_first + deadline;
+      double t=GetTimeSec();
+      if (t >= t_deadline) {
+        closeCycle(t);
+      } else {
+        wakeup.wait(&mutex,(unsigned long)ceil((t_deadline - t)*1.0E3));
+      }
+    } else {
+      wakeup.wait(&mutex);
+    }
+  }
+  mutex.unlock();
+}
+
+void CameraCycleAggregator::poll()
+{
+  match_tolerance=v_tolerance->getDouble()*1.0E-3;
+  deadline=v_deadline->getDouble()*1.0E-3;
+  bool enable=v_enable->getBool();
+  //no thread is needed as long as nothing is aggregated:
+  if (enable && isRunning()==false) start();
+  enabled=enable;
+}
+
+void CameraCycleAggregator::updateStatistics()
+{
+  mutex.lock();
+  if (v_reset->getAndResetCounter() > 0) {
+    latency.clear();
+    cycles=complete=late_frames=dropped=0;
+  }
+  cycle_latency->hist=latency;
+  long long _cycles=cycles;
+  long long _complete=complete;
+  long long _late_frames=late_frames;
+  long long _dropped=dropped;
+  mutex.unlock();
+  cycle_latency->update();
+  v_cycles->setInt((int)_cycles);
+  v_complete->setInt((int)_complete);
+  v_late_frames->setInt((int)_late_frames);
+  v_dropped->setInt((int)_dropped);
+}
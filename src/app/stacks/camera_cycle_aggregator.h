@@ -0,0 +1,133 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    camera_cycle_aggregator.h
+  \brief   C++ Interface: CameraCycleAggregator
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef CAMERA_CYCLE_AGGREGATOR_H
+#define CAMERA_CYCLE_AGGREGATOR_H
+
+#include <string>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include "VarTypes.h"
+#include "robocup_ssl_server.h"
+#include "latency_statistics.h"
+#include "affinity_manager.h"
+using namespace std;
+using namespace VarTypes;
+
+/*!
+  \class   CameraCycleAggregator
+  \brief   Merges the detection frames of all cameras into one packet per capture cycle
+
+  The network output of every camera adds its frame. Frames whose t_capture
+  lies within the match tolerance of the first frame of the open cycle
+  belong to that cycle. The cycle is sent as an SSL_DetectionCycle as soon
+  as every active camera (one that sent a frame within the last second)
+  has contributed, or when the deadline after the arrival of its first
+  frame has passed. Active cameras that missed the deadline are listed as
+  late cameras, and their frames, when they arrive, are counted as late and
+  not sent in any cycle.
+
+  A frame that starts a newer cycle, or a second frame of a camera, closes
+  the open cycle right away. Cycles are sent by a thread of the aggregator,
+  so the camera threads only copy their frame. The thread is started by
+  poll() once the aggregation is enabled, and pins itself to the
+  housekeeping cpus of \p affinity.
+*/
+class CameraCycleAggregator : public QThread {
+protected:
+  static const int MaxCameras=32;
+  static const double ActiveTimeout;
+
+  VarList * settings;
+  VarBool * v_enable;
+  VarString * v_address;
+  VarInt * v_port;
+  VarString * v_interface;
+  VarDouble * v_tolerance;
+  VarDouble * v_deadline;
+  VarList * statistics;
+  VarTrigger * v_reset;
+  LatencyStatistics * cycle_latency; //from the first frame of a cycle to its send
+  VarInt * v_cycles;
+  VarInt * v_complete;
+  VarInt * v_late_frames;
+  VarInt * v_dropped;
+
+  QMutex mutex;
+  QWaitCondition wakeup;
+  volatile bool running;
+  AffinityManager * affinity;
+
+  //copies of the settings, so the camera threads do not lock the VarTypes:
+  volatile bool enabled;
+  volatile double match_tolerance; //s
+  volatile double deadline; //s
+
+  //the open cycle:
+  SSL_DetectionCycle open_cycle;
+  bool cycle_open;
+  double cycle_t_capture;
+  double cycle_t_first; //arrival of its first frame
+  unsigned int cycle_cameras;
+  unsigned int cycle_number;
+  bool has_last;
+  double last_t_capture; //of the last closed cycle
+  double t_seen[MaxCameras];
+
+  //the closed cycle that waits for the thread:
+  SSL_DetectionCycle ready_cycle;
+  bool ready;
+  double ready_t_first;
+
+  //statistics, under the mutex:
+  LatencyHistogram latency;
+  long long cycles;
+  long long complete;
+  long long late_frames;
+  long long dropped; //closed cycles that were replaced before they were sent
+
+  //owned by the thread:
+  SSL_DetectionCycle send_cycle;
+  RoboCupSSLServer * server;
+  int server_port;
+  string server_address;
+  string server_interface;
+
+  unsigned int activeCameras(double t) const;
+  void closeCycle(double t);
+  void sendCycle();
+  virtual void run();
+
+public:
+  CameraCycleAggregator(AffinityManager * _affinity=0);
+  virtual ~CameraCycleAggregator();
+  VarList * getSettings();
+
+  /// adds the frame of a camera, called by the network output of its stack
+  void add(const SSL_DetectionFrame & frame);
+  /// applies the settings, called regularly by the thread that owns them.
+  /// add() uses the settings of the last call.
+  void poll();
+  /// shows the statistics in the data-tree, called about once per second
+  void updateStatistics();
+};
+
+#endif
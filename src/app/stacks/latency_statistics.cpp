@@ -0,0 +1,65 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    latency_statistics.cpp
+  \brief   C++ Implementation: LatencyStatistics
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "latency_statistics.h"
+
+LatencyStatistics::LatencyStatistics(const string & _name)
+{
+  name=_name;
+  list=new VarList(name);
+  list->addFlags(VARTYPE_FLAG_NOSAVE | VARTYPE_FLAG_NOLOAD);
+  list->addChild(v_count=new VarInt("Frames",0));
+  v_count->addFlags(VARTYPE_FLAG_READONLY);
+  v_mean=addValue("Mean (ms)");
+  v_p50=addValue("p50 (ms)");
+  v_p90=addValue("p90 (ms)");
+  v_p99=addValue("p99 (ms)");
+  v_max=addValue("Max (ms)");
+}
+
+LatencyStatistics::~LatencyStatistics()
+{
+  list->deleteAllChildren();
+  delete list;
+}
+
+VarDouble * LatencyStatistics::addValue(const string & label) {
+  VarDouble * v=new VarDouble(label,0.0);
+  v->addFlags(VARTYPE_FLAG_READONLY);
+  list->addChild(v);
+  return v;
+}
+
+void LatencyStatistics::reset() {
+  hist.clear();
+}
+
+void LatencyStatistics::update() {
+  v_count->setInt((int)hist.count);
+  v_mean->setDouble(hist.mean()*1.0E3);
+  v_p50->setDouble(hist.percentile(0.5)*1.0E3);
+  v_p90->setDouble(hist.percentile(0.9)*1.0E3);
+  v_p99->setDouble(hist.percentile(0.99)*1.0E3);
+  v_max->setDouble(hist.max*1.0E3);
+}
+
+VarList * LatencyStatistics::getSettings() {
+  return list;
+}
@@ -0,0 +1,67 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    latency_statistics.h
+  \brief   C++ Interface: LatencyStatistics
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef LATENCY_STATISTICS_H
+#define LATENCY_STATISTICS_H
+
+#include <string>
+#include "VarTypes.h"
+#include "realtime_manager.h"
+using namespace std;
+using namespace VarTypes;
+
+/*!
+  \class   LatencyStatistics
+  \brief   A LatencyHistogram with a read-only view in the data-tree
+
+  add() only touches the histogram. The VarTypes are refreshed by update(),
+  which the parent stack calls about once per second.
+*/
+class LatencyStatistics {
+protected:
+  string name;
+  VarList * list;
+  VarInt * v_count;
+  VarDouble * v_mean;
+  VarDouble * v_p50;
+  VarDouble * v_p90;
+  VarDouble * v_p99;
+  VarDouble * v_max;
+  VarDouble * addValue(const string & label);
+public:
+  LatencyHistogram hist;
+
+  LatencyStatistics(const string & _name);
+  ~LatencyStatistics();
+
+  void add(double seconds) {
+    hist.add(seconds);
+  }
+  void reset();
+  void update();
+
+  VarList * getSettings();
+  /// the name, valid for the lifetime of this object (e.g. for trace spans)
+  const char * getName() const {
+    return name.c_str();
+  }
+};
+
+#endif
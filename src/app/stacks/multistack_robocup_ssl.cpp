@@ -20,7 +20,10 @@
 //========================================================================
 #include "multistack_robocup_ssl.h"
 
-MultiStackRoboCupSSL::MultiStackRoboCupSSL(RenderOptions * _opts, int cameras) : MultiVisionStack("RoboCup SSL Multi-Cam",_opts) {
+MultiStackRoboCupSSL::MultiStackRoboCupSSL(RenderOptions * _opts, int cameras, bool visualization, RoboCupSSLServer * output, bool geometry_publisher, AffinityManager * affinity) : MultiVisionStack("RoboCup SSL Multi-Cam",_opts) {
+  //the threads below pin themselves to the housekeeping cpus of this plan:
+  if (affinity!=0) affinity->planPlacement(cameras);
+
   //add global field calibration parameter
   global_field = new RoboCupField();
   settings->addChild(global_field->getSettings());
@@ -42,18 +45,42 @@ MultiStackRoboCupSSL::MultiStackRoboCupSSL(RenderOptions * _opts, int cameras) :
   connect(global_network_output_settings->multicast_port,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
   connect(global_network_output_settings->multicast_address,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
   connect(global_network_output_settings->multicast_interface,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
+  connect(global_network_output_settings->asynchronous,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
+  connect(global_network_output_settings->batch_window,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
+  connect(global_network_output_settings->shared_memory,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
+  connect(global_network_output_settings->shared_memory_name,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
+  connect(global_network_output_settings->compact,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
+  connect(global_network_output_settings->compact_port,SIGNAL(wasEdited(VarType *)),this,SLOT(RefreshNetworkOutput()));
+
+  global_scene = new FieldScene(global_field);
+  settings->addChild(global_scene->getSettings());
+  connect(global_team_selector_blue,SIGNAL(signalTeamDataChanged()),this,SLOT(RefreshSceneTeams()));
+  connect(global_team_selector_yellow,SIGNAL(signalTeamDataChanged()),this,SLOT(RefreshSceneTeams()));
+
+  global_cycle_aggregator = new CameraCycleAggregator(affinity);
+  settings->addChild(global_cycle_aggregator->getSettings());
 
-  udp_server = new RoboCupSSLServer();
+  own_udp_server = (output==0);
+  async_server = (own_udp_server ? new RoboCupSSLAsyncServer(10002,"224.5.23.2","",affinity) : 0);
+  udp_server = (own_udp_server ? async_server : output);
+  shm_server = (own_udp_server ? new RoboCupSSLShmServer() : 0);
+  if (shm_server!=0) udp_server->setSharedMemoryOutput(shm_server);
+  compact_server = (own_udp_server ? new RoboCupSSLAsyncServer(10002,"224.5.23.2","",affinity) : 0);
+  if (compact_server!=0) compact_server->setEnabled(false);
+  t_sender_statistics = 0.0;
 
-  global_plugin_publish_geometry = new PluginPublishGeometry(0,udp_server,*global_field);
+  global_plugin_publish_geometry = new PluginPublishGeometry(0,udp_server,*global_field,geometry_publisher && own_udp_server,affinity);
 
   //add parameter for number of cameras
   createThreads(cameras);
   unsigned int n = threads.size();
   for (unsigned int i = 0; i < n;i++) {
     threads[i]->setFrameBuffer(new FrameBuffer(5));
-    threads[i]->setStack(new StackRoboCupSSL(_opts,threads[i]->getFrameBuffer(),i,global_field,global_ball_settings,global_plugin_publish_geometry,global_team_selector_blue, global_team_selector_yellow,udp_server,"robocup-ssl-cam-" + QString::number(i).toStdString()));
+    StackRoboCupSSL * stack = new StackRoboCupSSL(_opts,threads[i]->getFrameBuffer(),i,global_field,global_ball_settings,global_plugin_publish_geometry,global_team_selector_blue, global_team_selector_yellow,udp_server,global_cycle_aggregator,compact_server,"robocup-ssl-cam-" + QString::number(i).toStdString(),visualization);
+    threads[i]->setStack(stack);
+    threads[i]->setGeneratorScene(global_scene,stack->getCameraParameters());
   }
+  RefreshSceneTeams();
     //TODO: make LUT widgets aware of each other for easy data-sharing
 }
 
@@ -61,10 +88,26 @@ string MultiStackRoboCupSSL::getSettingsFileName() {
   return "robocup-ssl";
 }
 
+PluginSSLNetworkOutputSettings * MultiStackRoboCupSSL::getNetworkOutputSettings() {
+  return global_network_output_settings;
+}
+
+FieldScene * MultiStackRoboCupSSL::getScene() {
+  return global_scene;
+}
+
 MultiStackRoboCupSSL::~MultiStackRoboCupSSL() {
   stop();
-  delete udp_server;
+  for (unsigned int i = 0; i < threads.size();i++) {
+    threads[i]->setGeneratorScene(0,0);
+  }
+  delete global_scene;
+  delete global_cycle_aggregator;
+  //the geometry is sent by a thread of its plugin:
   delete global_plugin_publish_geometry;
+  if (own_udp_server) delete udp_server;
+  delete shm_server;
+  delete compact_server;
   delete global_field;
   delete global_ball_settings;
 }
@@ -81,4 +124,72 @@ void MultiStackRoboCupSSL::RefreshNetworkOutput()
     fflush(stderr);
   }
   udp_server->mutex.unlock();
+  if (async_server!=0) {
+    async_server->setAsynchronous(global_network_output_settings->asynchronous->getBool());
+    async_server->setBatchWindow(global_network_output_settings->batch_window->getDouble()*1.0E-3);
+  }
+  if (shm_server!=0) {
+    string name = global_network_output_settings->shared_memory_name->getString();
+    if (global_network_output_settings->shared_memory->getBool()==false) {
+      shm_server->close();
+    } else if (shm_server->isOpen()==false || shm_server->getName()!=name) {
+      if (shm_server->open(name)==false) {
+        fprintf(stderr,"ERROR WHEN TRYING TO OPEN THE SHARED MEMORY OUTPUT!\n");
+        fflush(stderr);
+      }
+    }
+  }
+  if (compact_server!=0) {
+    //the stacks drop their frames while the compact server is disabled,
+    //and queued ones are not sent while it is closed:
+    compact_server->setEnabled(false);
+    compact_server->mutex.lock();
+    compact_server->close();
+    bool enable = false;
+    if (global_network_output_settings->compact->getBool()) {
+      compact_server->_port = global_network_output_settings->compact_port->getInt();
+      compact_server->_net_address = global_network_output_settings->multicast_address->getString();
+      compact_server->_net_interface = global_network_output_settings->multicast_interface->getString();
+      enable = compact_server->open();
+      if (enable==false) {
+        fprintf(stderr,"ERROR WHEN TRYING TO OPEN THE COMPACT NETWORK OUTPUT!\n");
+        fflush(stderr);
+      }
+    }
+    compact_server->mutex.unlock();
+    compact_server->setAsynchronous(global_network_output_settings->asynchronous->getBool());
+    compact_server->setBatchWindow(global_network_output_settings->batch_window->getDouble()*1.0E-3);
+    compact_server->setEnabled(enable);
+  }
+}
+
+void MultiStackRoboCupSSL::poll()
+{
+  MultiVisionStack::poll();
+  global_cycle_aggregator->poll();
+  double t = GetTimeSec();
+  if (t - t_sender_statistics >= 1.0) {
+    if (async_server!=0) global_network_output_settings->updateSenderStatistics(async_server);
+    global_cycle_aggregator->updateStatistics();
+    t_sender_statistics = t;
+  }
+}
+
+
+void MultiStackRoboCupSSL::RefreshSceneTeams()
+{
+  CMPattern::TeamSelector * selectors[2] = {global_team_selector_blue, global_team_selector_yellow};
+  for (int i = 0; i < 2; i++) {
+    CMPattern::Team * team = selectors[i]->getSelectedTeam();
+    FieldScene::TeamColor color = (i==0 ? FieldScene::TeamBlue : FieldScene::TeamYellow);
+    if (team==0 || team->getLoadMarkersFromImageFile()==false) {
+      global_scene->setTeam(color,"",0,0,0.0,false,vector<bool>());
+      continue;
+    }
+    int n = team->getMarkerImageRows() * team->getMarkerImageCols();
+    vector<bool> valid(max(0,n));
+    for (int j = 0; j < n; j++) valid[j] = team->isPatternValid(j);
+    global_scene->setTeam(color,team->getMarkerImageFile(),team->getMarkerImageRows(),team->getMarkerImageCols(),
+                          team->getRobotHeight(),team->getUseMarkerImageHeights(),valid);
+  }
 }
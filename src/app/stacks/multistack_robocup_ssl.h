@@ -26,15 +26,46 @@
 #include "stack_robocup_ssl.h"
 #include "plugin_detect_balls.h"
 #include "plugin_publishgeometry.h"
-#include "cmpattern_teamdetector.h"
+#include "cmpattern_team.h"
 #include "robocup_ssl_server.h"
+#include "robocup_ssl_async_server.h"
+#include "robocup_ssl_shm_server.h"
 #include "field.h"
+#include "field_scene.h"
+#include "camera_cycle_aggregator.h"
+#include "affinity_manager.h"
 using namespace std;
 
 /*!
   \class   MultiStackRoboCupSSL
   \brief   The multi-camera vision processing stack used for the RoboCup SSL vision system.
   \author  Stefan Zickler, (C) 2008
+
+  The "Synthetic Scene" is rendered by the capture generators of all
+  cameras, with the marker images of the selected teams.
+
+  The multicast server sends from its own thread, unless "Asynchronous
+  Sender" is disabled in the "Network Output" settings. With "Shared Memory
+  Output", the same packets are also published to a shared-memory ring for
+  clients on this host. "Compact Output" sends every detection once more
+  as a quantized SSL_CompactDetectionFrame on a port of its own, for
+  clients behind links with little bandwidth. It has a sender thread of its
+  own as well. If enabled, the
+  "Camera Cycle Aggregation" additionally sends the frames of all cameras
+  of one capture cycle as a single SSL_DetectionCycle packet.
+
+  If \p output is given, all packets are sent through it instead of the
+  multicast server (e.g. a RoboCupSSLPacketFile for offline processing).
+  It is not owned by the stack.
+
+  With \p geometry_publisher, the geometry is sent by a thread that also
+  answers requests on the "Request Port" (see PluginPublishGeometry). It
+  is meant for the vision server itself and is ignored if \p output is
+  given. Otherwise, the geometry is sent on the frame times.
+
+  With \p affinity, the placement of the \p cameras is planned before any
+  thread of the stack starts, and the sender threads pin themselves to its
+  housekeeping cpus. The capture threads still need setAffinityManager().
 */
 class MultiStackRoboCupSSL : public QObject, public MultiVisionStack {
   Q_OBJECT
@@ -46,13 +77,24 @@ class MultiStackRoboCupSSL : public QObject, public MultiVisionStack {
   CMPattern::TeamSelector * global_team_selector_blue;
   CMPattern::TeamSelector * global_team_selector_yellow;
   PluginSSLNetworkOutputSettings * global_network_output_settings;
+  FieldScene * global_scene;
+  CameraCycleAggregator * global_cycle_aggregator;
   RoboCupSSLServer * udp_server;
+  RoboCupSSLAsyncServer * async_server; //the udp_server, unless an output was given
+  RoboCupSSLShmServer * shm_server; //mirrors the packets of an own udp_server
+  RoboCupSSLAsyncServer * compact_server; //quantized detections, next to an own udp_server
+  bool own_udp_server;
+  double t_sender_statistics;
   public:
-  MultiStackRoboCupSSL(RenderOptions * _opts, int cameras);
+  MultiStackRoboCupSSL(RenderOptions * _opts, int cameras, bool visualization=true, RoboCupSSLServer * output=0, bool geometry_publisher=false, AffinityManager * affinity=0);
   virtual string getSettingsFileName();
+  PluginSSLNetworkOutputSettings * getNetworkOutputSettings();
   virtual ~MultiStackRoboCupSSL();
+  FieldScene * getScene();
+  virtual void poll();
   public slots:
   void RefreshNetworkOutput();
+  void RefreshSceneTeams();
 };
 
 #endif
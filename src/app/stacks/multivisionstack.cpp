@@ -24,6 +24,12 @@ MultiVisionStack::MultiVisionStack(string _name, RenderOptions * _opts) {
   name=_name;
   opts=_opts;
   settings=new VarList("Global");
+  settings->addChild(v_timing_report=new VarString("Timing Report File",""));
+  settings->addChild(v_tracing=new VarList("Tracing"));
+  v_tracing->addChild(v_trace_enable=new VarBool("Enable",false));
+  v_tracing->addChild(v_trace_window=new VarDouble("Window (seconds)",10.0,0.0));
+  v_tracing->addChild(v_trace_file=new VarString("Trace File","vision-trace.json"));
+  v_tracing->addChild(v_trace_dump=new VarTrigger("Dump Trace","Dump"));
 }
 
 MultiVisionStack::~MultiVisionStack() {
@@ -66,3 +72,59 @@ void MultiVisionStack::stop() {
     t->kill();
   }
 }
+
+VarList * MultiVisionStack::buildSettingsTree() {
+  VarList * root=new VarList("Vision System");
+  VarExternal * stackvar;
+  root->addChild(stackvar= new VarExternal((getSettingsFileName() + ".xml").c_str(),getName()));
+  stackvar->addChild(getSettings());
+  for (unsigned int i=0;i<threads.size();i++) {
+    VisionStack * s = threads[i]->getStack();
+    VarList * threadvar = new VarList("Camera " + QString::number(i).toStdString());
+    threadvar->addChild(s->getSettings());
+    threadvar->addChild(threads[i]->getSettings());
+    for (unsigned int j=0;j<s->stack.size();j++) {
+      VisionPlugin * p=s->stack[j];
+      if (p->getSettings()==0) continue;
+      if (p->isSharedAmongStacks()) {
+        if (i==0) stackvar->addChild(p->getSettings());
+      } else {
+        threadvar->addChild(p->getSettings());
+      }
+    }
+    stackvar->addChild(threadvar);
+  }
+  return root;
+}
+
+void MultiVisionStack::writeTimingReport() {
+  string filename=v_timing_report->getString();
+  if (filename.empty()) return;
+  FILE * f=fopen(filename.c_str(),"w");
+  if (f==0) {
+    fprintf(stderr,"Unable to write timing report %s\n",filename.c_str());
+    return;
+  }
+  for (unsigned int i=0;i<threads.size();i++) {
+    VisionStack * s=threads[i]->getStack();
+    if (s==0) continue;
+    fprintf(f,"Camera %d:\n",i);
+    s->printTimingStatistics(f);
+  }
+  fclose(f);
+  printf("Wrote timing report to %s\n",filename.c_str());
+}
+
+void MultiVisionStack::poll() {
+  pollTracing();
+}
+
+void MultiVisionStack::pollTracing() {
+  bool enable=v_trace_enable->getBool();
+  if (enable!=Tracer::isEnabled()) Tracer::setEnabled(enable);
+  if (v_trace_dump->getAndResetCounter() > 0) dumpTrace();
+}
+
+void MultiVisionStack::dumpTrace() {
+  Tracer::dump(v_trace_file->getString().c_str(),v_trace_window->getDouble());
+}
@@ -44,6 +44,12 @@ public:
   RenderOptions * opts;
   VarList * settings;
 protected:
+    VarString * v_timing_report;
+    VarList * v_tracing;
+    VarBool * v_trace_enable;
+    VarDouble * v_trace_window;
+    VarString * v_trace_file;
+    VarTrigger * v_trace_dump;
     void createThreads(int number);
 public:
     MultiVisionStack(string _name, RenderOptions * _opts);
@@ -57,6 +63,22 @@ public:
     void start();
     void stop();
 
+    /// builds the same data-tree as the MainWindow (without any widgets),
+    /// so that the GUI-less front-ends share their settings.xml with the GUI.
+    VarList * buildSettingsTree();
+
+    /// writes the timing statistics of all stacks to the "Timing Report File",
+    /// if one is set. All threads need to be stopped before calling this.
+    void writeTimingReport();
+
+    /// called periodically by the main thread: applies the "Tracing"
+    /// settings, and derived stacks refresh their statistics.
+    virtual void poll();
+    /// applies the "Tracing" settings and dumps the trace if requested.
+    void pollTracing();
+    /// writes the traced spans of the configured window to the "Trace File"
+    void dumpTrace();
+
     /*virtual void keyPressEvent ( QKeyEvent * event );
     virtual void mousePressEvent ( QMouseEvent * event, pixelloc loc );
     virtual void mouseReleaseEvent ( QMouseEvent * event, pixelloc loc );
@@ -20,11 +20,13 @@
 //========================================================================
 #include "stack_robocup_ssl.h"
 
-StackRoboCupSSL::StackRoboCupSSL(RenderOptions * _opts, FrameBuffer * _fb, int camera_id, RoboCupField * _global_field, PluginDetectBallsSettings * _global_ball_settings,PluginPublishGeometry * _global_plugin_publish_geometry, CMPattern::TeamSelector * _global_team_selector_blue, CMPattern::TeamSelector * _global_team_selector_yellow, RoboCupSSLServer * udp_server, string cam_settings_filename) : VisionStack("RoboCup Image Processing",_opts), global_field(_global_field), global_ball_settings(_global_ball_settings), global_team_selector_blue(_global_team_selector_blue), global_team_selector_yellow(_global_team_selector_yellow) {
+StackRoboCupSSL::StackRoboCupSSL(RenderOptions * _opts, FrameBuffer * _fb, int camera_id, RoboCupField * _global_field, PluginDetectBallsSettings * _global_ball_settings,PluginPublishGeometry * _global_plugin_publish_geometry, CMPattern::TeamSelector * _global_team_selector_blue, CMPattern::TeamSelector * _global_team_selector_yellow, RoboCupSSLServer * udp_server, CameraCycleAggregator * cycle_aggregator, RoboCupSSLAsyncServer * compact_server, string cam_settings_filename, bool visualization) : VisionStack("RoboCup Image Processing",_opts), global_field(_global_field), global_ball_settings(_global_ball_settings), global_team_selector_blue(_global_team_selector_blue), global_team_selector_yellow(_global_team_selector_yellow) {
     (void)_fb;
     _camera_id=camera_id;
     _cam_settings_filename=cam_settings_filename;
     _udp_server = udp_server;
+    _cycle_aggregator = cycle_aggregator;
+    _compact_server = compact_server;
     lut_yuv = new YUVLUT(4,6,6,cam_settings_filename + "-lut-yuv.xml");
     lut_yuv->loadRoboCupChannels(LUTChannelMode_Numeric);
     lut_yuv->addDerivedLUT(new RGBLUT(5,5,5,""));
@@ -34,7 +36,8 @@ StackRoboCupSSL::StackRoboCupSSL(RenderOptions * _opts, FrameBuffer * _fb, int c
 
     _global_plugin_publish_geometry->addCameraParameters(camera_parameters);
 
-    stack.push_back(new PluginDVR(_fb));
+    //the DVR is controlled entirely through its widget:
+    if (visualization) stack.push_back(new PluginDVR(_fb));
 
     stack.push_back(new PluginColorCalibration(_fb,lut_yuv, LUTChannelMode_Numeric));
     settings->addChild(lut_yuv->getSettings());
@@ -55,19 +58,31 @@ StackRoboCupSSL::StackRoboCupSSL(RenderOptions * _opts, FrameBuffer * _fb, int c
 
     stack.push_back(new PluginDetectBalls(_fb,lut_yuv,*camera_parameters,*global_field,global_ball_settings));
 
-    stack.push_back(new PluginSSLNetworkOutput(_fb,_udp_server,*camera_parameters,*global_field));
+    stack.push_back(new PluginSSLNetworkOutput(_fb,_udp_server,*camera_parameters,*global_field,_cycle_aggregator,_compact_server));
 
     stack.push_back(_global_plugin_publish_geometry);
 
-    PluginVisualize * vis=new PluginVisualize(_fb,*camera_parameters,*global_field,*calib_field);
-    vis->setThresholdingLUT(lut_yuv);
-    stack.push_back(vis);
+    if (visualization) {
+      PluginVisualize * vis=new PluginVisualize(_fb,*camera_parameters,*global_field,*calib_field);
+      vis->setThresholdingLUT(lut_yuv);
+      stack.push_back(vis);
+    }
 
+    initTimingStatistics();
 
 }
 string StackRoboCupSSL::getSettingsFileName() {
   return _cam_settings_filename;
 }
+
+CameraParameters * StackRoboCupSSL::getCameraParameters() {
+  return camera_parameters;
+}
+
+YUVLUT * StackRoboCupSSL::getLUT() {
+  return lut_yuv;
+}
+
 StackRoboCupSSL::~StackRoboCupSSL() {
   delete lut_yuv;
   delete camera_parameters;
@@ -37,8 +37,9 @@
 #include "plugin_sslnetworkoutput.h"
 #include "plugin_publishgeometry.h"
 #include "plugin_dvr.h"
-#include "cmpattern_teamdetector.h"
+#include "cmpattern_team.h"
 #include "robocup_ssl_server.h"
+#include "camera_cycle_aggregator.h"
 
 using namespace std;
 
@@ -47,6 +48,10 @@ using namespace std;
   \brief   The single camera vision stack implementation used for the RoboCup SSL
   \author  Stefan Zickler, (C) 2008
            multiple of these stacks are run in parallel using the MultiStackRoboCupSSL
+
+  If \p visualization is false, the plugins which exist only to show or record
+  video in the GUI (DVR and Visualize) are not created. This is used by the
+  headless server, which has no widgets.
 */
 class StackRoboCupSSL : public VisionStack {
   protected:
@@ -60,9 +65,13 @@ class StackRoboCupSSL : public VisionStack {
   CMPattern::TeamSelector * global_team_selector_yellow;
   RoboCupCalibrationHalfField * calib_field;
   RoboCupSSLServer * _udp_server;
+  CameraCycleAggregator * _cycle_aggregator;
+  RoboCupSSLAsyncServer * _compact_server;
   public:
-  StackRoboCupSSL(RenderOptions * _opts, FrameBuffer * _fb, int camera_id, RoboCupField * _global_field, PluginDetectBallsSettings * _global_ball_settings, PluginPublishGeometry * _global_plugin_publish_geometry, CMPattern::TeamSelector * _global_team_selector_blue, CMPattern::TeamSelector * _global_team_selector_yellow, RoboCupSSLServer * udp_server, string cam_settings_filename);
+  StackRoboCupSSL(RenderOptions * _opts, FrameBuffer * _fb, int camera_id, RoboCupField * _global_field, PluginDetectBallsSettings * _global_ball_settings, PluginPublishGeometry * _global_plugin_publish_geometry, CMPattern::TeamSelector * _global_team_selector_blue, CMPattern::TeamSelector * _global_team_selector_yellow, RoboCupSSLServer * udp_server, CameraCycleAggregator * cycle_aggregator, RoboCupSSLAsyncServer * compact_server, string cam_settings_filename, bool visualization=true);
   virtual string getSettingsFileName();
+  CameraParameters * getCameraParameters();
+  YUVLUT * getLUT();
   virtual ~StackRoboCupSSL();
 };
 
@@ -26,12 +26,36 @@ VisionStack::VisionStack(string _name, RenderOptions * _opts) {
   //counter_proc=0.0;
   //counter_post_proc=0.0;
   settings=new VarList("Global");
+  rt_stats=0;
+  rt_inversion_threshold=0.0;
+  settings->addChild(timing=new VarList("Timing Statistics"));
+  timing->addChild(v_print_timing=new VarBool("Print Timing",false));
+  timing->addChild(v_timing_reset=new VarTrigger("Reset","Reset"));
+  timing->addChild(v_fps=new VarDouble("Processed fps",0.0));
+  v_fps->addFlags(VARTYPE_FLAG_READONLY | VARTYPE_FLAG_NOSAVE | VARTYPE_FLAG_NOLOAD);
+  timing_total=new LatencyStatistics("Stack");
+  timing->addChild(timing_total->getSettings());
+  timing_frames=0;
+  timing_frames_last=0;
+  timing_t_last=0.0;
+  print_timing=false;
 }
 
 VisionStack::~VisionStack() {
+  for (unsigned int i=0;i<timing_plugins.size();i++) {
+    delete timing_plugins[i];
+  }
+  delete timing_total;
   delete settings;
 }
 
+void VisionStack::initTimingStatistics() {
+  for (unsigned int i=timing_plugins.size();i<stack.size();i++) {
+    timing_plugins.push_back(new LatencyStatistics(stack[i]->getName()));
+    timing->addChild(timing_plugins[i]->getSettings());
+  }
+}
+
 string VisionStack::getName() {
   return name;
 }
@@ -45,28 +69,66 @@ string VisionStack::getSettingsFileName() {
   return name;
 }
 
+void VisionStack::setRealTimeStats(RealTimeManager::ThreadStats * stats, double inversion_threshold) {
+  rt_stats=stats;
+  rt_inversion_threshold=inversion_threshold;
+}
+
+void VisionStack::lockPlugin(VisionPlugin * p) {
+  if (rt_stats==0) {
+    p->lock();
+  } else if (p->tryLock()==false) {
+    double a=GetTimeSec();
+    p->lock();
+    rt_stats->lockWaited(GetTimeSec()-a,p->getName().c_str(),rt_inversion_threshold);
+  }
+}
+
+size_t VisionStack::prefault(FrameData * data) {
+  size_t bytes=0;
+  unsigned int n=stack.size();
+  VisionPlugin * p;
+  for (unsigned int i=0;i<n;i++) {
+    p=stack[i];
+    p->lock();
+    bytes+=p->prefault(data);
+    p->unlock();
+  }
+  return bytes;
+}
+
 void VisionStack::process(FrameData * data) {
   double a=0.0;
   double b=0.0;
   unsigned int n=stack.size();
   VisionPlugin * p;
   double total=0.0;
-  bool show_timing = false;
+  bool show_timing = print_timing;
+  bool keep_timing = (timing_plugins.size()==n);
   if (show_timing) printf("----------\n");
   for (unsigned int i=0;i<n;i++) {
     p=stack[i];
-    p->lock();
+    lockPlugin(p);
+    if (p->updateSettingsSnapshots()) p->settingsSnapshotsUpdated();
     a=GetTimeSec();
-    p->process(data,opts);
+    if (keep_timing && Tracer::isEnabled()) {
+      TRACE_SPAN(timing_plugins[i]->getName());
+      p->process(data,opts);
+    } else {
+      p->process(data,opts);
+    }
     b=GetTimeSec();
     p->setTimeProcessing(b-a);
     total+=(p->getTimeProcessing());
+    if (keep_timing) timing_plugins[i]->add(b-a);
     if (show_timing) {
       printf("Plugin %s: %fms\n",p->getName().c_str(),  p->getTimeProcessing() * 1000.0);
     }
     p->unlock();
   }
   if (show_timing) printf("Total time: %fms\n",total * 1000.0);
+  timing_total->add(total);
+  timing_frames++;
   //counter_proc+=1.0;
 }
 
@@ -77,7 +139,7 @@ void VisionStack::postProcess(FrameData * data) {
   VisionPlugin * p;
   for (unsigned int i=0;i<n;i++) {
     p=stack[i];
-    p->lock();
+    lockPlugin(p);
     a=GetTimeSec();
     p->postProcess(data,opts);
     b=GetTimeSec();
@@ -88,7 +150,32 @@ void VisionStack::postProcess(FrameData * data) {
 }
 
 void VisionStack::updateTimingStatistics() {
+  if (v_timing_reset->getAndResetCounter() > 0) resetTimingStatistics();
+  print_timing=v_print_timing->getBool();
+  double t=GetTimeSec();
+  if (timing_t_last > 0.0 && t > timing_t_last) {
+    v_fps->setDouble((double)(timing_frames-timing_frames_last)/(t-timing_t_last));
+  }
+  timing_t_last=t;
+  timing_frames_last=timing_frames;
+  timing_total->update();
+  for (unsigned int i=0;i<timing_plugins.size();i++) {
+    timing_plugins[i]->update();
+  }
+}
 
+void VisionStack::resetTimingStatistics() {
+  timing_total->reset();
+  for (unsigned int i=0;i<timing_plugins.size();i++) {
+    timing_plugins[i]->reset();
+  }
+}
+
+void VisionStack::printTimingStatistics(FILE * f) {
+  timing_total->hist.print(f,"stack");
+  for (unsigned int i=0;i<timing_plugins.size();i++) {
+    timing_plugins[i]->hist.print(f,stack[i]->getName().c_str());
+  }
 }
 
 void VisionStack::keyPressEvent ( QKeyEvent * event ) {
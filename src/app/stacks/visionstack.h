@@ -23,6 +23,8 @@
 
 #include "visionplugin.h"
 #include "framedata.h"
+#include "latency_statistics.h"
+#include "tracer.h"
 #include "timer.h"
 using namespace std;
 
@@ -30,12 +32,33 @@ using namespace std;
   \class   VisionStack
   \brief   Base-class of a single-threaded / single-camera vision stack.
   \author  Stefan Zickler, (C) 2008
+
+  The stack keeps a latency histogram of each plugin and of the whole stack,
+  shown read-only under "Timing Statistics" in its settings. Subclasses need
+  to call initTimingStatistics() once all plugins have been added.
 */
 class VisionStack {
 protected:
   string name;
   RenderOptions * opts;
   VarList * settings;
+  RealTimeManager::ThreadStats * rt_stats;
+  double rt_inversion_threshold;
+  /// locks \p p. In real-time mode, blocked waits are recorded in rt_stats.
+  void lockPlugin(VisionPlugin * p);
+
+  VarList * timing;
+  VarBool * v_print_timing;
+  bool print_timing; //v_print_timing as of the last updateTimingStatistics()
+  VarTrigger * v_timing_reset;
+  VarDouble * v_fps;
+  LatencyStatistics * timing_total;
+  vector<LatencyStatistics *> timing_plugins;
+  long long timing_frames;
+  long long timing_frames_last;
+  double timing_t_last;
+  /// creates the statistics of all plugins in \p stack
+  void initTimingStatistics();
   //double counter_proc;
   //double counter_post_proc;
 public:
@@ -49,7 +72,17 @@ public:
 
     void process(FrameData * data);
     void postProcess(FrameData * data);
+    /// refreshes the statistics in the data-tree and handles reset requests.
+    /// called by the capture thread about once per second.
     void updateTimingStatistics();
+    void resetTimingStatistics();
+    /// prints all timing histograms. The stack must not be processing.
+    void printTimingStatistics(FILE * f);
+
+    /// enables lock-wait and priority inversion statistics for real-time mode
+    void setRealTimeStats(RealTimeManager::ThreadStats * stats, double inversion_threshold);
+    /// lets all plugins allocate and prefault their buffers for \p data
+    size_t prefault(FrameData * data);
 
     virtual void keyPressEvent ( QKeyEvent * event );
     virtual void mousePressEvent ( QMouseEvent * event, pixelloc loc );
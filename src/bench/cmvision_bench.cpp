@@ -0,0 +1,1102 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    cmvision_bench.cpp
+  \brief   Micro-benchmarks of the CMVision and CMPattern kernels and of the packet encodings
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include <QCoreApplication>
+#include <QString>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <dc1394/conversions.h>
+#include "qgetopt.h"
+#include "image_io.h"
+#include "rawimage.h"
+#include "lut3d.h"
+#include "field.h"
+#include "camera_calibration.h"
+#include "cmvision_region.h"
+#include "cmvision_threshold.h"
+#include "cmvision_histogram.h"
+#include "cmpattern_pattern.h"
+#include "cmpattern_teamdetector.h"
+#include "cmpattern_team.h"
+#include "robocup_ssl_compact.h"
+#include "messages_robocup_ssl_wrapper.pb.h"
+using namespace std;
+
+//========================================================================
+// allocation counting
+//
+// All heap allocations of the process (including those of operator new)
+// pass through these wrappers of the glibc allocator. The benchmark is
+// single-threaded, so plain counters are sufficient.
+//========================================================================
+static volatile long bench_allocs=0;
+static volatile long bench_alloc_bytes=0;
+
+extern "C" {
+  void * __libc_malloc(size_t size);
+  void * __libc_calloc(size_t n, size_t size);
+  void * __libc_realloc(void * ptr, size_t size);
+
+  void * malloc(size_t size) {
+    bench_allocs++;
+    bench_alloc_bytes+=size;
+    return __libc_malloc(size);
+  }
+  void * calloc(size_t n, size_t size) {
+    bench_allocs++;
+    bench_alloc_bytes+=n*size;
+    return __libc_calloc(n,size);
+  }
+  void * realloc(void * ptr, size_t size) {
+    bench_allocs++;
+    bench_alloc_bytes+=size;
+    return __libc_realloc(ptr,size);
+  }
+}
+
+static double benchTime() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return (double)ts.tv_sec + ts.tv_nsec*1.0E-9;
+}
+
+/*!
+  \class   BenchStage
+  \brief   Accumulated time and allocations of one kernel on one input
+*/
+class BenchStage {
+public:
+  string kernel;
+  double seconds;
+  long allocs;
+  long calls;
+  double pixels;
+  double t_start;
+  long allocs_start;
+  BenchStage(const string & _kernel) {
+    kernel=_kernel;
+    seconds=0.0;
+    allocs=0;
+    calls=0;
+    pixels=0.0;
+    t_start=0.0;
+    allocs_start=0;
+  }
+  inline void begin() {
+    allocs_start=bench_allocs;
+    t_start=benchTime();
+  }
+  inline void end(double _pixels, long _calls=1) {
+    seconds+=benchTime()-t_start;
+    allocs+=bench_allocs-allocs_start;
+    calls+=_calls;
+    pixels+=_pixels;
+  }
+};
+
+/*!
+  \class   StressStage
+  \brief   Per-frame worst case of one kernel over a sequence of frames
+*/
+class StressStage {
+public:
+  string kernel;
+  long frames;
+  double sum_seconds;
+  double max_seconds;
+  long max_allocs;
+  long max_alloc_bytes;
+  double last_seconds;
+  long last_allocs;
+  long last_alloc_bytes;
+  double t_start;
+  long allocs_start;
+  long bytes_start;
+  StressStage(const string & _kernel) {
+    kernel=_kernel;
+    frames=0;
+    sum_seconds=0.0;
+    max_seconds=0.0;
+    max_allocs=0;
+    max_alloc_bytes=0;
+    last_seconds=0.0;
+    last_allocs=0;
+    last_alloc_bytes=0;
+    t_start=0.0;
+    allocs_start=0;
+    bytes_start=0;
+  }
+  inline void begin() {
+    allocs_start=bench_allocs;
+    bytes_start=bench_alloc_bytes;
+    t_start=benchTime();
+  }
+  inline void end() {
+    add(benchTime()-t_start,bench_allocs-allocs_start,bench_alloc_bytes-bytes_start);
+  }
+  void add(double seconds, long allocs, long bytes) {
+    last_seconds=seconds;
+    last_allocs=allocs;
+    last_alloc_bytes=bytes;
+    frames++;
+    sum_seconds+=seconds;
+    if (seconds > max_seconds) max_seconds=seconds;
+    if (allocs > max_allocs) max_allocs=allocs;
+    if (bytes > max_alloc_bytes) max_alloc_bytes=bytes;
+  }
+};
+
+/*!
+  \class   BenchReport
+  \brief   Collects the results and writes them as JSON
+*/
+class BenchReport {
+protected:
+  FILE * f;
+  bool first;
+public:
+  BenchReport(FILE * _f, const char * benchmark="cmvision") {
+    f=_f;
+    first=true;
+    fprintf(f,"{\"benchmark\":\"%s\",\"results\":[",benchmark);
+  }
+  ~BenchReport() {
+    fprintf(f,"\n]}\n");
+  }
+  void add(const BenchStage & s, const string & input, int width, int height, const string & extra="") {
+    double calls=(s.calls > 0 ? (double)s.calls : 1.0);
+    double ns_per_call=s.seconds*1.0E9/calls;
+    double ns_per_pixel=(s.pixels > 0.0 ? s.seconds*1.0E9/s.pixels : 0.0);
+    double allocs_per_call=(double)s.allocs/calls;
+    fprintf(f,"%s\n{\"kernel\":\"%s\",\"input\":\"%s\",\"width\":%d,\"height\":%d,\"calls\":%ld,"
+              "\"ns_per_call\":%.1f,\"ns_per_pixel\":%.4f,\"allocs_per_call\":%.3f%s%s}",
+            (first ? "" : ","),s.kernel.c_str(),input.c_str(),width,height,s.calls,
+            ns_per_call,ns_per_pixel,allocs_per_call,(extra.empty() ? "" : ","),extra.c_str());
+    fflush(f);
+    first=false;
+    printf("%-24s %-18s %4dx%-4d %12.1f ns/call %8.3f ns/pixel %7.2f allocs/call\n",
+            s.kernel.c_str(),input.c_str(),width,height,ns_per_call,ns_per_pixel,allocs_per_call);
+  }
+  void add(const StressStage & s, const string & input, int width, int height, const string & extra="") {
+    double mean_us=(s.frames > 0 ? s.sum_seconds*1.0E6/s.frames : 0.0);
+    double max_us=s.max_seconds*1.0E6;
+    fprintf(f,"%s\n{\"kernel\":\"%s\",\"input\":\"%s\",\"width\":%d,\"height\":%d,\"frames\":%ld,"
+              "\"mean_us\":%.1f,\"max_us\":%.1f,\"max_allocs\":%ld,\"max_alloc_bytes\":%ld%s%s}",
+            (first ? "" : ","),s.kernel.c_str(),input.c_str(),width,height,s.frames,
+            mean_us,max_us,s.max_allocs,s.max_alloc_bytes,(extra.empty() ? "" : ","),extra.c_str());
+    fflush(f);
+    first=false;
+    printf("%-24s %-18s %4dx%-4d %10.1f us mean %10.1f us max %6ld allocs %9ld bytes\n",
+            s.kernel.c_str(),input.c_str(),width,height,mean_us,max_us,s.max_allocs,s.max_alloc_bytes);
+  }
+};
+
+/*!
+  \class   BenchRandom
+  \brief   A small LCG, so that synthetic inputs are identical on every run
+*/
+class BenchRandom {
+protected:
+  unsigned int state;
+public:
+  BenchRandom(unsigned int seed) {
+    state=seed;
+  }
+  unsigned int next() {
+    state=state*1664525u+1013904223u;
+    return state >> 8;
+  }
+  int uniform(int n) {
+    return (int)(next() % (unsigned int)n);
+  }
+};
+
+static void fillBox(rgb * img, int w, int h, int x1, int y1, int x2, int y2, rgb c) {
+  if (x1 < 0) x1=0;
+  if (y1 < 0) y1=0;
+  if (x2 > w-1) x2=w-1;
+  if (y2 > h-1) y2=h-1;
+  for (int y=y1;y<=y2;y++) {
+    for (int x=x1;x<=x2;x++) img[y*w+x]=c;
+  }
+}
+
+static void fillDisc(rgb * img, int w, int h, int cx, int cy, int r, rgb c) {
+  for (int y=cy-r;y<=cy+r;y++) {
+    if (y < 0 || y >= h) continue;
+    for (int x=cx-r;x<=cx+r;x++) {
+      if (x < 0 || x >= w) continue;
+      if ((x-cx)*(x-cx)+(y-cy)*(y-cy) <= r*r) img[y*w+x]=c;
+    }
+  }
+}
+
+static void convertToUYVY(RawImage & out, rgb * img, int w, int h) {
+  //the same conversion as the "FromFile" capture module:
+  out.allocate(COLOR_YUV422_UYVY,w,h);
+  dc1394_convert_to_YUV422((unsigned char *)img, out.getData(), w, h,
+                           DC1394_BYTE_ORDER_UYVY, DC1394_COLOR_CODING_RGB8, 8);
+}
+
+/// nearest-neighbour resampling of a recorded frame to another resolution
+static void makeFieldImage(RawImage & out, const rgb * src, int sw, int sh, int w, int h) {
+  rgb * img=new rgb[w*h];
+  for (int y=0;y<h;y++) {
+    const rgb * row=src+((y*sh)/h)*sw;
+    for (int x=0;x<w;x++) img[y*w+x]=row[(x*sw)/w];
+  }
+  convertToUYVY(out,img,w,h);
+  delete[] img;
+}
+
+/// a field with lines, robots and balls; \p clutter 0..2 adds robots and
+/// single-pixel noise of all marker colors
+static void makeSyntheticImage(RawImage & out, int w, int h, int clutter) {
+  static const int robots_per_level[3]={4,12,24};
+  static const int noise_per_level[3]={0,0,200};
+  const rgb marker_colors[3]={RGB::Pink,RGB::Green,RGB::Cyan};
+  BenchRandom rnd(0x5EED+clutter);
+  rgb * img=new rgb[w*h];
+  fillBox(img,w,h,0,0,w-1,h-1,RGB::DarkGreen);
+
+  //field lines:
+  int lw=(w/400 > 1 ? w/400 : 1);
+  int m=w/20;
+  fillBox(img,w,h,m,m,w-m,m+lw,RGB::White);
+  fillBox(img,w,h,m,h-m-lw,w-m,h-m,RGB::White);
+  fillBox(img,w,h,m,m,m+lw,h-m,RGB::White);
+  fillBox(img,w,h,w-m-lw,m,w-m,h-m,RGB::White);
+  fillBox(img,w,h,w/2,m,w/2+lw,h-m,RGB::White);
+
+  //robots with a team marker and four id markers:
+  int r=w/60;
+  for (int i=0;i<robots_per_level[clutter];i++) {
+    int cx=m+r*3+rnd.uniform(w-2*m-r*6);
+    int cy=m+r*3+rnd.uniform(h-2*m-r*6);
+    fillDisc(img,w,h,cx,cy,r*2,RGB::Black);
+    fillDisc(img,w,h,cx,cy,r/2+1,(i%2)==0 ? RGB::Yellow : RGB::Blue);
+    fillDisc(img,w,h,cx-r,cy-r,r/3+1,marker_colors[rnd.uniform(3)]);
+    fillDisc(img,w,h,cx+r,cy-r,r/3+1,marker_colors[rnd.uniform(3)]);
+    fillDisc(img,w,h,cx-r,cy+r,r/3+1,marker_colors[rnd.uniform(3)]);
+    fillDisc(img,w,h,cx+r,cy+r,r/3+1,marker_colors[rnd.uniform(3)]);
+  }
+  for (int i=0;i<=clutter;i++) {
+    fillDisc(img,w,h,m+rnd.uniform(w-2*m),m+rnd.uniform(h-2*m),r/2+1,RGB::Orange);
+  }
+
+  //speckle noise of every label color:
+  const rgb noise_colors[6]={RGB::Orange,RGB::Yellow,RGB::Blue,RGB::Pink,RGB::Cyan,RGB::White};
+  if (noise_per_level[clutter] > 0) {
+    int n=(w*h)/noise_per_level[clutter];
+    for (int i=0;i<n;i++) img[rnd.uniform(w*h)]=noise_colors[rnd.uniform(6)];
+  }
+
+  convertToUYVY(out,img,w,h);
+  delete[] img;
+}
+
+/*!
+  \class   SegmentationBench
+  \brief   Runs the CMVision kernels stage by stage on one input
+*/
+class SegmentationBench {
+protected:
+  YUVLUT * lut;
+  double min_seconds;
+  BenchReport * report;
+public:
+  //the limits used by the RoboCup stack:
+  static const int max_runs=50000;
+  static const int max_regions=10000;
+  static const int min_blob_area=5;
+
+  SegmentationBench(YUVLUT * _lut, double _min_seconds, BenchReport * _report) {
+    lut=_lut;
+    min_seconds=_min_seconds;
+    report=_report;
+  }
+
+  void run(const RawImage & image, const string & input) {
+    int w=image.getWidth();
+    int h=image.getHeight();
+    double pixels=(double)w*h;
+    Image<raw8> thresholded;
+    thresholded.allocate(w,h);
+    CMVision::RunList runlist(max_runs);
+    CMVision::RegionList reglist(max_regions);
+    CMVision::ColorRegionList colorlist(lut->getChannelCount());
+    CMVision::Histogram histogram(lut->getChannelCount());
+
+    BenchStage s_threshold("thresholdYUV422_UYVY");
+    BenchStage s_encode("encodeRuns");
+    BenchStage s_connect("connectComponents");
+    BenchStage s_extract("extractRegions");
+    BenchStage s_separate("separateRegions+sort");
+    BenchStage s_histogram("Histogram::addBox");
+    BenchStage s_full("ImageProcessor");
+
+    //one untimed iteration, so that first-use allocations are not counted:
+    int iterations=-1;
+    double t_end=0.0;
+    int box=(w/40 > 4 ? w/40 : 4);
+    while (iterations < 5 || benchTime() < t_end) {
+      if (iterations==0) t_end=benchTime()+min_seconds;
+      bool timed=(iterations >= 0);
+      BenchStage dummy("");
+      s_threshold.begin();
+      CMVisionThreshold::thresholdImageYUV422_UYVY(&thresholded,&image,lut);
+      (timed ? s_threshold : dummy).end(pixels);
+      s_encode.begin();
+      CMVision::RegionProcessing::encodeRuns(&thresholded,&runlist);
+      (timed ? s_encode : dummy).end(pixels);
+      s_connect.begin();
+      CMVision::RegionProcessing::connectComponents(&runlist);
+      (timed ? s_connect : dummy).end(pixels);
+      s_extract.begin();
+      CMVision::RegionProcessing::extractRegions(&reglist,&runlist);
+      (timed ? s_extract : dummy).end(pixels);
+      s_separate.begin();
+      int max_area=CMVision::RegionProcessing::separateRegions(&colorlist,&reglist,min_blob_area);
+      CMVision::RegionProcessing::sortRegions(&colorlist,max_area);
+      (timed ? s_separate : dummy).end(pixels);
+
+      //robot-sized boxes over the whole image, as sampled by the team detector:
+      int boxes=0;
+      s_histogram.begin();
+      for (int y=0;y+box<h;y+=box) {
+        for (int x=0;x+box<w;x+=box) {
+          histogram.clear();
+          histogram.addBox(&thresholded,x,y,x+box-1,y+box-1);
+          boxes++;
+        }
+      }
+      (timed ? s_histogram : dummy).end((double)boxes*box*box,boxes);
+      iterations++;
+    }
+
+    //the complete path, including its own buffers:
+    CMVision::ImageProcessor processor(lut,max_regions,max_runs);
+    processor.processYUV422_UYVY(&image,min_blob_area);
+    iterations=0;
+    t_end=benchTime()+min_seconds;
+    while (iterations < 5 || benchTime() < t_end) {
+      s_full.begin();
+      processor.processYUV422_UYVY(&image,min_blob_area);
+      s_full.end(pixels);
+      iterations++;
+    }
+
+    char extra[128];
+    snprintf(extra,sizeof(extra),"\"runs\":%d,\"regions\":%d",runlist.getUsedRuns(),reglist.getUsedRegions());
+    report->add(s_threshold,input,w,h);
+    report->add(s_encode,input,w,h,extra);
+    report->add(s_connect,input,w,h,extra);
+    report->add(s_extract,input,w,h,extra);
+    report->add(s_separate,input,w,h,extra);
+    report->add(s_histogram,input,w,h);
+    report->add(s_full,input,w,h,extra);
+  }
+};
+
+/// image2field for a grid of pixels, one call per pixel
+static void benchImage2Field(const CameraModel & camera, int w, int h, double min_seconds, BenchReport * report) {
+  BenchStage s("image2field");
+  double t_end=benchTime()+min_seconds;
+  double checksum=0.0;
+  while (s.calls==0 || benchTime() < t_end) {
+    long calls=0;
+    s.begin();
+    for (int y=0;y<h;y+=8) {
+      for (int x=0;x<w;x+=8) {
+        GVector::vector2d<double> p_i(x,y);
+        GVector::vector3d<double> p_f;
+        camera.image2field(p_f,p_i,140.0);
+        checksum+=p_f.x;
+        calls++;
+      }
+    }
+    s.end((double)calls,calls);
+  }
+  char extra[64];
+  snprintf(extra,sizeof(extra),"\"checksum\":%.1f",checksum/s.calls);
+  report->add(s,"grid",w,h,extra);
+}
+
+/// findPattern for markers taken from every pattern of the team image,
+/// in a rotated order so that all offsets are searched
+static bool benchFindPattern(const string & image_file, YUVLUT * lut, const CameraModel & camera, double min_seconds, BenchReport * report) {
+  rgbImage rgbi;
+  if (rgbi.load(image_file)==false) {
+    fprintf(stderr,"Error loading team image file: '%s'.\n",image_file.c_str());
+    return false;
+  }
+  //the same model setup as the team detector:
+  YUVLUT minilut(4,4,4,"");
+  minilut.copyChannels(*lut);
+  minilut.computeLUTfromLabels();
+  yuvImage yuvi;
+  yuvi.allocate(rgbi.getWidth(),rgbi.getHeight());
+  Images::convert(rgbi,yuvi);
+  CMPattern::MultiPatternModel model;
+  if (model.loadMultiPatternImage(yuvi,&minilut,3,4,140.0)==false) {
+    fprintf(stderr,"Errors while processing team image file: '%s'.\n",image_file.c_str());
+    return false;
+  }
+
+  CMPattern::MultiPatternModel::PatternFitParameters fit_params;
+  fit_params.fit_area_weight=0.1;
+  fit_params.fit_cen_dist_weight=0.2;
+  fit_params.fit_next_dist_weight=1.0;
+  fit_params.fit_next_angle_dist_weight=0.5;
+  fit_params.fit_max_error=1.0;
+  fit_params.fit_variance=0.25;
+  fit_params.fit_uniform=0.05;
+
+  int n=model.getNumPatterns();
+  vector<CMPattern::Marker *> markers(n);
+  vector<int> num_markers(n);
+  vector<CMVision::Region> regions(n*CMPattern::MaxMarkers);
+  for (int i=0;i<n;i++) {
+    const CMPattern::Pattern & p=model.getPattern(i);
+    num_markers[i]=p.getNumMarkers();
+    markers[i]=new CMPattern::Marker[CMPattern::MaxMarkers];
+    for (int j=0;j<num_markers[i];j++) {
+      CMPattern::Marker & m=markers[i][j];
+      m=p.getMarker((j+i)%num_markers[i]);
+      CMVision::Region & reg=regions[i*CMPattern::MaxMarkers+j];
+      memset(&reg,0,sizeof(reg));
+      reg.color=m.id;
+      reg.cen_x=390.0+m.loc.x;
+      reg.cen_y=290.0+m.loc.y;
+      m.reg=&reg;
+      m.height=p.getHeight();
+      m.next=0;
+    }
+  }
+
+  BenchStage s("findPattern");
+  long found=0;
+  double t_end=benchTime()+min_seconds;
+  while (s.calls < 100 || benchTime() < t_end) {
+    s.begin();
+    for (int i=0;i<n;i++) {
+      CMPattern::MultiPatternModel::PatternDetectionResult result;
+      if (model.findPattern(result,markers[i],num_markers[i],fit_params,camera)) found++;
+    }
+    s.end(0.0,n);
+  }
+  for (int i=0;i<n;i++) delete[] markers[i];
+  char extra[64];
+  snprintf(extra,sizeof(extra),"\"patterns\":%d,\"found\":%.3f",n,(double)found/s.calls);
+  report->add(s,"standard2010",yuvi.getWidth(),yuvi.getHeight(),extra);
+  return true;
+}
+
+//========================================================================
+// detection encoding
+//
+// The cost and size of the SSL_WrapperPackets and of the compact output,
+// for detection frames of one camera with random positions. Decoding
+// parses into the same message again, as receiveBatch() and
+// receiveCompact() do.
+//========================================================================
+
+static float benchUniform(BenchRandom & random, float min, float max) {
+  return min + (max - min)*(random.next() & 0xffff)*(1.0f/65536.0f);
+}
+
+static void makeDetectionFrame(SSL_DetectionFrame & frame, BenchRandom & random, int balls, int robots, int number) {
+  frame.Clear();
+  frame.set_frame_number(number);
+  frame.set_t_capture(1.0E9 + number/60.0);
+  frame.set_t_sent(frame.t_capture() + benchUniform(random,0.002f,0.008f));
+  frame.set_camera_id(number % 2);
+  for (int i=0;i<balls;i++) {
+    SSL_DetectionBall * ball=frame.add_balls();
+    ball->set_confidence(benchUniform(random,0.5f,1.0f));
+    ball->set_area(20 + random.uniform(80));
+    ball->set_x(benchUniform(random,0.0f,3025.0f));
+    ball->set_y(benchUniform(random,-2025.0f,2025.0f));
+    ball->set_pixel_x(benchUniform(random,0.0f,780.0f));
+    ball->set_pixel_y(benchUniform(random,0.0f,580.0f));
+  }
+  for (int team=0;team<2;team++) {
+    for (int i=0;i<robots;i++) {
+      SSL_DetectionRobot * robot=(team==0 ? frame.add_robots_yellow() : frame.add_robots_blue());
+      robot->set_confidence(benchUniform(random,0.5f,1.0f));
+      robot->set_robot_id(i);
+      robot->set_x(benchUniform(random,0.0f,3025.0f));
+      robot->set_y(benchUniform(random,-2025.0f,2025.0f));
+      robot->set_orientation(benchUniform(random,-M_PI,M_PI));
+      robot->set_pixel_x(benchUniform(random,0.0f,780.0f));
+      robot->set_pixel_y(benchUniform(random,0.0f,580.0f));
+      robot->set_height(140.0f);
+    }
+  }
+}
+
+/// the largest difference of the positions (mm) and orientations (rad) of \p a and \p b
+static void compareDetectionFrames(const SSL_DetectionFrame & a, const SSL_DetectionFrame & b, double & position_error, double & orientation_error) {
+  for (int i=0;i<a.balls_size() && i<b.balls_size();i++) {
+    position_error=max(position_error,(double)max(fabs(a.balls(i).x()-b.balls(i).x()),fabs(a.balls(i).y()-b.balls(i).y())));
+  }
+  for (int team=0;team<2;team++) {
+    const ::google::protobuf::RepeatedPtrField<SSL_DetectionRobot> & ra=(team==0 ? a.robots_yellow() : a.robots_blue());
+    const ::google::protobuf::RepeatedPtrField<SSL_DetectionRobot> & rb=(team==0 ? b.robots_yellow() : b.robots_blue());
+    for (int i=0;i<ra.size() && i<rb.size();i++) {
+      position_error=max(position_error,(double)max(fabs(ra.Get(i).x()-rb.Get(i).x()),fabs(ra.Get(i).y()-rb.Get(i).y())));
+      double d=fabs(ra.Get(i).orientation()-rb.Get(i).orientation());
+      orientation_error=max(orientation_error,min(d,2.0*M_PI-d));
+    }
+  }
+}
+
+static bool benchDetectionEncoding(int balls, int robots, double min_seconds, BenchReport * report) {
+  static const int n=64;
+  BenchRandom random(4711 + robots);
+  vector<SSL_WrapperPacket> packets(n);
+  for (int i=0;i<n;i++) makeDetectionFrame(*packets[i].mutable_detection(),random,balls,robots,i);
+  char input[64];
+  snprintf(input,sizeof(input),"%d-balls-%d-robots",balls,2*robots);
+
+  BenchStage s_encode("wrapper-encode");
+  BenchStage s_decode("wrapper-decode");
+  BenchStage s_compact_encode("compact-encode");
+  BenchStage s_compact_decode("compact-decode");
+  vector<char> buffer(65536);
+  vector<string> wrapper_data(n);
+  vector<string> compact_data(n);
+  SSL_WrapperPacket parsed;
+  SSL_CompactDetectionFrame compact;
+  SSL_DetectionFrame decoded;
+  long wrapper_bytes=0;
+  long compact_bytes=0;
+  double position_error=0.0;
+  double orientation_error=0.0;
+  bool ok=true;
+  for (int i=0;i<n;i++) {
+    packets[i].SerializeToString(&wrapper_data[i]);
+    RoboCupSSLCompact::encode(packets[i].detection(),compact);
+    compact.SerializeToString(&compact_data[i]);
+    wrapper_bytes+=wrapper_data[i].size();
+    compact_bytes+=compact_data[i].size();
+    if (compact.ParseFromString(compact_data[i])==false || RoboCupSSLCompact::decode(compact,decoded)==false ||
+        decoded.robots_blue_size()!=robots || decoded.balls_size()!=balls) {
+      fprintf(stderr,"The compact encoding of a detection frame did not decode\n");
+      ok=false;
+    }
+    compareDetectionFrames(packets[i].detection(),decoded,position_error,orientation_error);
+  }
+
+  //the first round only warms the reused messages up:
+  BenchStage * stages[4]={&s_encode,&s_decode,&s_compact_encode,&s_compact_decode};
+  double t_end=0.0;
+  for (int round=0;;round++) {
+    if (round==1) t_end=benchTime()+min_seconds;
+    if (round > 1 && benchTime() >= t_end) break;
+    for (int k=0;k<4;k++) {
+      if (round > 0) stages[k]->begin();
+      for (int i=0;i<n;i++) {
+        if (k==0) {
+          packets[i].ByteSize();
+          packets[i].SerializeWithCachedSizesToArray((google::protobuf::uint8 *)&buffer[0]);
+        } else if (k==1) {
+          parsed.ParseFromArray(wrapper_data[i].data(),wrapper_data[i].size());
+        } else if (k==2) {
+          RoboCupSSLCompact::encode(packets[i].detection(),compact);
+          compact.ByteSize();
+          compact.SerializeWithCachedSizesToArray((google::protobuf::uint8 *)&buffer[0]);
+        } else {
+          compact.ParseFromArray(compact_data[i].data(),compact_data[i].size());
+          RoboCupSSLCompact::decode(compact,decoded);
+        }
+      }
+      if (round > 0) stages[k]->end(0.0,n);
+    }
+  }
+
+  char extra[128];
+  snprintf(extra,sizeof(extra),"\"bytes\":%.1f",(double)wrapper_bytes/n);
+  report->add(s_encode,input,0,0,extra);
+  report->add(s_decode,input,0,0,extra);
+  snprintf(extra,sizeof(extra),"\"bytes\":%.1f,\"saving\":%.3f,\"max_position_error\":%.2f,\"max_orientation_error\":%.5f",
+           (double)compact_bytes/n,1.0-(double)compact_bytes/wrapper_bytes,position_error,orientation_error);
+  report->add(s_compact_encode,input,0,0,extra);
+  report->add(s_compact_decode,input,0,0,extra);
+  printf("%-24s %-18s %.1f bytes instead of %.1f (%.1f%% less)\n","compact-encoding",input,
+         (double)compact_bytes/n,(double)wrapper_bytes/n,100.0*(1.0-(double)compact_bytes/wrapper_bytes));
+  return ok;
+}
+
+//========================================================================
+// adversarial load
+//
+// Label images that are cheap to draw but expensive to segment and fit,
+// as seen during setup and under bad lighting. They are drawn directly as
+// labels, so that no LUT smooths them, and they change with every frame.
+//========================================================================
+
+enum StressInput {
+  StressSaltPepper10=0,
+  StressSaltPepper50,
+  StressCheckerboard1,
+  StressCheckerboard2,
+  StressStripesVertical,
+  StressStripesDiagonal,
+  StressBlobs,
+  StressFakeRobots,
+  StressInputCount
+};
+
+static const char * stress_input_names[StressInputCount]={
+  "salt-pepper-10","salt-pepper-50","checkerboard-1","checkerboard-2",
+  "stripes-vertical","stripes-diagonal","blobs","fake-robots"
+};
+
+/*!
+  \class   StressImageGenerator
+  \brief   Draws the adversarial label images of the stress test
+*/
+class StressImageGenerator {
+protected:
+  int field;
+  int black;
+  int colors[7]; //every label that is not field or black
+  int team[2];
+  int markers[3];
+  double px_per_mm;
+
+  static void fill(Image<raw8> & img, int x1, int y1, int x2, int y2, int label) {
+    if (x1 < 0) x1=0;
+    if (y1 < 0) y1=0;
+    if (x2 > img.getWidth()-1) x2=img.getWidth()-1;
+    if (y2 > img.getHeight()-1) y2=img.getHeight()-1;
+    raw8 * p=img.getPixelData();
+    for (int y=y1;y<=y2;y++) {
+      for (int x=x1;x<=x2;x++) p[y*img.getWidth()+x].v=label;
+    }
+  }
+public:
+  StressImageGenerator(LUT3D * lut, double _px_per_mm) {
+    px_per_mm=_px_per_mm;
+    field=lut->getChannelID("Field Green");
+    black=lut->getChannelID("Black");
+    team[0]=lut->getChannelID("Blue");
+    team[1]=lut->getChannelID("Yellow");
+    markers[0]=lut->getChannelID("Pink");
+    markers[1]=lut->getChannelID("Green");
+    markers[2]=lut->getChannelID("Cyan");
+    colors[0]=lut->getChannelID("Orange");
+    colors[1]=lut->getChannelID("White");
+    colors[2]=team[0];
+    colors[3]=team[1];
+    colors[4]=markers[0];
+    colors[5]=markers[1];
+    colors[6]=markers[2];
+  }
+
+  void draw(Image<raw8> & img, int input, int frame) {
+    BenchRandom rnd(0xBAD5EED+input*7919+frame);
+    int w=img.getWidth();
+    int h=img.getHeight();
+    raw8 * p=img.getPixelData();
+    switch (input) {
+      case StressSaltPepper10:
+      case StressSaltPepper50: {
+        int percent=(input==StressSaltPepper10 ? 10 : 50);
+        for (int i=0;i<w*h;i++) p[i].v=(rnd.uniform(100) < percent ? colors[rnd.uniform(7)] : field);
+        break;
+      }
+      case StressCheckerboard1:
+      case StressCheckerboard2: {
+        //no two neighbouring cells share a label, so every cell row is a run:
+        int cell=(input==StressCheckerboard1 ? 1 : 2);
+        for (int y=0;y<h;y++) {
+          for (int x=0;x<w;x++) p[y*w+x].v=((((x+frame)/cell)+(y/cell)) & 1) ? markers[0] : markers[1];
+        }
+        break;
+      }
+      case StressStripesVertical: {
+        //one-pixel columns, every run is merged with the run above it:
+        for (int y=0;y<h;y++) {
+          for (int x=0;x<w;x++) p[y*w+x].v=((x+frame) & 1) ? markers[0] : markers[2];
+        }
+        break;
+      }
+      case StressStripesDiagonal: {
+        //two-pixel diagonals, long regions that touch every row:
+        for (int y=0;y<h;y++) {
+          for (int x=0;x<w;x++) p[y*w+x].v=(((x+y+frame)/2) & 1) ? markers[0] : markers[1];
+        }
+        break;
+      }
+      case StressBlobs: {
+        //thousands of marker-sized squares of the team and marker colors,
+        //just below the run limit at 780x580:
+        fill(img,0,0,w-1,h-1,black);
+        for (int y=0;y+12<=h;y+=12) {
+          for (int x=0;x+12<=w;x+=12) {
+            int x1=x+rnd.uniform(2);
+            int y1=y+rnd.uniform(2);
+            fill(img,x1,y1,x1+4+rnd.uniform(2),y1+4+rnd.uniform(2),colors[2+rnd.uniform(5)]);
+          }
+        }
+        break;
+      }
+      case StressFakeRobots: {
+        //packed robot tops with random markers, at the scale of the camera,
+        //so that every team marker is fitted against all patterns:
+        int ofs=(int)(50.0*px_per_mm+0.5);
+        int r=(int)(20.0*px_per_mm+0.5);
+        if (r < 2) r=2;
+        if (ofs < 2*r+2) ofs=2*r+2;
+        int pitch=2*(ofs+r)+3;
+        fill(img,0,0,w-1,h-1,field);
+        int i=0;
+        for (int cy=pitch/2;cy+pitch/2<h;cy+=pitch) {
+          for (int cx=pitch/2;cx+pitch/2<w;cx+=pitch) {
+            int jx=cx+rnd.uniform(3)-1;
+            int jy=cy+rnd.uniform(3)-1;
+            fill(img,jx-ofs-r,jy-ofs-r,jx+ofs+r,jy+ofs+r,black);
+            fill(img,jx-r,jy-r,jx+r,jy+r,team[(i++) & 1]);
+            fill(img,jx-ofs-r,jy-ofs-r,jx-ofs+r,jy-ofs+r,markers[rnd.uniform(3)]);
+            fill(img,jx+ofs-r,jy-ofs-r,jx+ofs+r,jy-ofs+r,markers[rnd.uniform(3)]);
+            fill(img,jx-ofs-r,jy+ofs-r,jx-ofs+r,jy+ofs+r,markers[rnd.uniform(3)]);
+            fill(img,jx+ofs-r,jy+ofs-r,jx+ofs+r,jy+ofs+r,markers[rnd.uniform(3)]);
+          }
+        }
+        break;
+      }
+    }
+  }
+};
+
+/*!
+  \class   StressBench
+  \brief   Worst-case time and memory per frame of the robot detection path
+
+  Runs the stages of the RoboCup stack from the label image to the robot
+  detections of both teams, with the buffer limits of the stack, and keeps
+  the worst frame of every stage. The "frame" stage is the sum of all
+  stages, i.e. the bound to budget for.
+*/
+class StressBench {
+protected:
+  LUT3D * lut;
+  CameraModel camera;
+  int frames;
+  BenchReport * report;
+  VarList * team_settings;
+  CMPattern::Team * team;
+  CMPattern::TeamDetector * detector;
+  int color_id_field;
+  int color_id_ball;
+  int color_id_black;
+  int color_id_blue;
+  int color_id_yellow;
+
+  /// the same tree as PluginDetectRobots::buildRegionTree()
+  int buildRegionTree(CMVision::RegionTree & reg_tree, CMVision::ColorRegionList & colorlist) {
+    int size=0;
+    reg_tree.clear();
+    for (int c=0;c<colorlist.getNumColorRegions();c++) {
+      if (c!=0 && c!=color_id_field && c!=color_id_ball && c!=color_id_black) {
+        for (CMVision::Region * reg=colorlist.getRegionList(c).getInitialElement();reg!=0;reg=reg->next) {
+          reg_tree.add(reg);
+          size++;
+        }
+      }
+    }
+    reg_tree.build();
+    return size;
+  }
+
+public:
+  StressBench(LUT3D * _lut, const CameraParameters & _camera, const RoboCupField & field, const string & team_image, int _frames, BenchReport * _report)
+   : camera(_camera.getModel())
+  {
+    lut=_lut;
+    frames=_frames;
+    report=_report;
+    color_id_field=lut->getChannelID("Field Green");
+    color_id_ball=lut->getChannelID("Orange");
+    color_id_black=lut->getChannelID("Black");
+    color_id_blue=lut->getChannelID("Blue");
+    color_id_yellow=lut->getChannelID("Yellow");
+
+    //a team with unique patterns, so that the team detector fits the model:
+    team_settings=new VarList("Stress Team");
+    team_settings->addChild(new VarBool("Unique Patterns",true));
+    team_settings->addChild(new VarBool("Have Angles",true));
+    VarList * marker_image=new VarList("Marker Image");
+    team_settings->addChild(marker_image);
+    marker_image->addChild(new VarString("Marker Image File",team_image));
+    team=new CMPattern::Team(team_settings);
+    detector=new CMPattern::TeamDetector(lut);
+    CMPattern::TeamSettings settings;
+    team->compile(settings);
+    FieldFilter field_filter;
+    field.updateFilter(field_filter);
+    detector->init(settings,field_filter);
+    team->loadPatterns(detector->getModel(),*lut);
+  }
+
+  ~StressBench() {
+    delete detector;
+    delete team;
+    delete team_settings;
+  }
+
+  void run(int input, int w, int h) {
+    //the scale of the camera at the image center, for the fake robots:
+    GVector::vector2d<double> p_a(w/2,h/2);
+    GVector::vector2d<double> p_b(w/2+10,h/2);
+    GVector::vector3d<double> f_a;
+    GVector::vector3d<double> f_b;
+    camera.image2field(f_a,p_a,140.0);
+    camera.image2field(f_b,p_b,140.0);
+    double mm_per_px=sqrt(sq(f_a.x-f_b.x)+sq(f_a.y-f_b.y))/10.0;
+    StressImageGenerator generator(lut,(mm_per_px > 0.0 ? 1.0/mm_per_px : 0.1));
+
+    Image<raw8> labels;
+    labels.allocate(w,h);
+    CMVision::RunList runlist(SegmentationBench::max_runs);
+    CMVision::RegionList reglist(SegmentationBench::max_regions);
+    CMVision::ColorRegionList colorlist(lut->getChannelCount());
+    CMVision::RegionTree reg_tree;
+    ::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot > robots_blue;
+    ::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot > robots_yellow;
+
+    StressStage s_encode("encodeRuns");
+    StressStage s_connect("connectComponents");
+    StressStage s_extract("extractRegions");
+    StressStage s_separate("separateRegions+sort");
+    StressStage s_tree("buildRegionTree");
+    StressStage s_model("findRobotsByModel");
+    StressStage s_frame("frame");
+    int max_runs=0;
+    int max_regions=0;
+    int max_tree=0;
+    int max_robots=0;
+    int runs_saturated=0;
+    int regions_saturated=0;
+
+    //frame -1 is not counted, so that first-use allocations are not part of the bound:
+    for (int frame=-1;frame<frames;frame++) {
+      generator.draw(labels,input,frame+1);
+      bool timed=(frame >= 0);
+      StressStage dummy("");
+      StressStage & encode=(timed ? s_encode : dummy);
+      StressStage & connect=(timed ? s_connect : dummy);
+      StressStage & extract=(timed ? s_extract : dummy);
+      StressStage & separate=(timed ? s_separate : dummy);
+      StressStage & tree=(timed ? s_tree : dummy);
+      StressStage & model=(timed ? s_model : dummy);
+
+      encode.begin();
+      CMVision::RegionProcessing::encodeRuns(&labels,&runlist);
+      encode.end();
+      connect.begin();
+      CMVision::RegionProcessing::connectComponents(&runlist);
+      connect.end();
+      extract.begin();
+      CMVision::RegionProcessing::extractRegions(&reglist,&runlist);
+      extract.end();
+      separate.begin();
+      int max_area=CMVision::RegionProcessing::separateRegions(&colorlist,&reglist,SegmentationBench::min_blob_area);
+      CMVision::RegionProcessing::sortRegions(&colorlist,max_area);
+      separate.end();
+      tree.begin();
+      int tree_size=buildRegionTree(reg_tree,colorlist);
+      tree.end();
+      model.begin();
+      detector->update(&robots_blue,color_id_blue,6,&labels,&colorlist,reg_tree,camera);
+      detector->update(&robots_yellow,color_id_yellow,6,&labels,&colorlist,reg_tree,camera);
+      model.end();
+      if (timed==false) continue;
+
+      s_frame.add(s_encode.last_seconds+s_connect.last_seconds+s_extract.last_seconds+
+                  s_separate.last_seconds+s_tree.last_seconds+s_model.last_seconds,
+                  s_encode.last_allocs+s_connect.last_allocs+s_extract.last_allocs+
+                  s_separate.last_allocs+s_tree.last_allocs+s_model.last_allocs,
+                  s_encode.last_alloc_bytes+s_connect.last_alloc_bytes+s_extract.last_alloc_bytes+
+                  s_separate.last_alloc_bytes+s_tree.last_alloc_bytes+s_model.last_alloc_bytes);
+      if (runlist.getUsedRuns() > max_runs) max_runs=runlist.getUsedRuns();
+      if (reglist.getUsedRegions() > max_regions) max_regions=reglist.getUsedRegions();
+      if (tree_size > max_tree) max_tree=tree_size;
+      if (robots_blue.size()+robots_yellow.size() > max_robots) max_robots=robots_blue.size()+robots_yellow.size();
+      if (runlist.getUsedRuns()==runlist.getMaxRuns()) runs_saturated++;
+      if (reglist.getUsedRegions()==reglist.getMaxRegions()) regions_saturated++;
+    }
+    reg_tree.clear();
+
+    //the fixed buffers of the stack, and the part of them that was used:
+    long buffer_bytes=(long)w*h*sizeof(raw8)+(long)runlist.getMaxRuns()*sizeof(CMVision::Run)+
+                      (long)reglist.getMaxRegions()*sizeof(CMVision::Region);
+    long used_bytes=(long)w*h*sizeof(raw8)+(long)max_runs*sizeof(CMVision::Run)+
+                    (long)max_regions*sizeof(CMVision::Region);
+
+    string name=stress_input_names[input];
+    char runs[128];
+    char regions[128];
+    char extra[256];
+    snprintf(runs,sizeof(runs),"\"max_runs\":%d,\"runs_saturated\":%d",max_runs,runs_saturated);
+    snprintf(regions,sizeof(regions),"\"max_regions\":%d,\"regions_saturated\":%d",max_regions,regions_saturated);
+    report->add(s_encode,name,w,h,runs);
+    report->add(s_connect,name,w,h,runs);
+    report->add(s_extract,name,w,h,regions);
+    report->add(s_separate,name,w,h,regions);
+    snprintf(extra,sizeof(extra),"\"max_tree_regions\":%d",max_tree);
+    report->add(s_tree,name,w,h,extra);
+    snprintf(extra,sizeof(extra),"\"max_robots\":%d",max_robots);
+    report->add(s_model,name,w,h,extra);
+    snprintf(extra,sizeof(extra),"%s,%s,\"buffer_bytes\":%ld,\"max_used_bytes\":%ld",runs,regions,buffer_bytes,used_bytes);
+    report->add(s_frame,name,w,h,extra);
+  }
+};
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  GetOpt opts(argc, argv);
+  bool help=false;
+  QString output_file;
+  QString data_dir;
+  QString s_seconds;
+  QString s_stress;
+  int ecode=0;
+  opts.addSwitch("help",&help);
+  opts.addOption( 'o',QString("output"),&output_file);
+  opts.addOption( 'd',QString("data"),&data_dir);
+  opts.addOption( 't',QString("time"),&s_seconds);
+  opts.addOption( 's',QString("stress"),&s_stress);
+  if (!opts.parse()) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+  int stress_frames=(s_stress.isEmpty() ? 0 : s_stress.toInt());
+  if (output_file.isEmpty()) output_file=(s_stress.isEmpty() ? "cmvision-bench.json" : "cmvision-stress.json");
+  if (data_dir.isEmpty()) data_dir=".";
+  double min_seconds=(s_seconds.isEmpty() ? 0.3 : s_seconds.toDouble());
+  if (help==false && (min_seconds <= 0.0 || (s_stress.isEmpty()==false && stress_frames <= 0))) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+
+  if (help) {
+    printf("SSL-Vision kernel benchmark command line options:\n");
+    printf(" -o FILE     Write the results as JSON to FILE (default: cmvision-bench.json)\n");
+    printf(" -d DIR      Source directory containing test-data/ and patterns/ (default: .)\n");
+    printf(" -t SECONDS  Minimum run time of each kernel and input (default: 0.3)\n");
+    printf(" -s FRAMES   Instead of the benchmarks, run FRAMES adversarial label images\n");
+    printf("             per input and report the worst frame of each detection stage\n");
+    printf("             (default output: cmvision-stress.json)\n");
+    printf(" --help      Show this help\n");
+    exit(ecode);
+  }
+
+  //the kernels print their warnings to stdout, so the JSON goes to a file:
+  FILE * out=fopen(output_file.toStdString().c_str(),"w");
+  if (out==0) {
+    fprintf(stderr,"Unable to write %s\n",output_file.toStdString().c_str());
+    exit(1);
+  }
+  string dir=data_dir.toStdString();
+
+  //a LUT mapping every color to its nearest label, so that all pixels are
+  //segmented; this is the worst case of a calibrated LUT:
+  YUVLUT lut(4,6,6,"");
+  lut.loadRoboCupChannels(LUTChannelMode_Numeric);
+  lut.computeLUTfromLabels();
+
+  int ecode_run=0;
+  if (stress_frames > 0) {
+    BenchReport report(out,"cmvision-stress");
+    RoboCupField field_model;
+    RoboCupCalibrationHalfField calib_field(&field_model,0);
+    CameraParameters camera(calib_field);
+    string team_file=dir+"/patterns/teams/standard2010.png";
+    FILE * team_image=fopen(team_file.c_str(),"r");
+    if (team_image==0) {
+      fprintf(stderr,"Unable to read image %s\n",team_file.c_str());
+      ecode_run=1;
+    } else {
+      fclose(team_image);
+      StressBench stress(&lut,camera,field_model,team_file,stress_frames,&report);
+      static const int resolutions[2][2]={{780,580},{1280,1024}};
+      for (int i=0;i<2;i++) {
+        for (int input=0;input<StressInputCount;input++) {
+          stress.run(input,resolutions[i][0],resolutions[i][1]);
+        }
+      }
+    }
+  } else {
+    BenchReport report(out);
+    SegmentationBench segmentation(&lut,min_seconds,&report);
+
+    static const int resolutions[4][2]={{640,480},{780,580},{1280,1024},{1920,1200}};
+    string field_file=dir+"/test-data/ssl-field-2008.jpg";
+    int fw=0;
+    int fh=0;
+    rgb * field=ImageIO::readRGB(fw,fh,field_file.c_str());
+    if (field==0) {
+      fprintf(stderr,"Unable to read image %s\n",field_file.c_str());
+      ecode_run=1;
+    } else {
+      for (int i=0;i<4;i++) {
+        RawImage image;
+        makeFieldImage(image,field,fw,fh,resolutions[i][0],resolutions[i][1]);
+        segmentation.run(image,"field-2008");
+        image.clear();
+      }
+      delete[] field;
+    }
+
+    static const char * clutter_names[3]={"synthetic-low","synthetic-medium","synthetic-high"};
+    for (int i=0;i<4;i++) {
+      if (i==1) continue;
+      for (int c=0;c<3;c++) {
+        RawImage image;
+        makeSyntheticImage(image,resolutions[i][0],resolutions[i][1],c);
+        segmentation.run(image,clutter_names[c]);
+        image.clear();
+      }
+    }
+
+    RoboCupField field_model;
+    RoboCupCalibrationHalfField calib_field(&field_model,0);
+    CameraParameters camera(calib_field);
+    benchImage2Field(camera.getModel(),780,580,min_seconds,&report);
+    if (benchFindPattern(dir+"/patterns/teams/standard2010.png",&lut,camera.getModel(),min_seconds,&report)==false) ecode_run=1;
+    if (benchDetectionEncoding(1,6,min_seconds,&report)==false) ecode_run=1;
+    if (benchDetectionEncoding(3,11,min_seconds,&report)==false) ecode_run=1;
+  }
+  fclose(out);
+  printf("Wrote %s\n",output_file.toStdString().c_str());
+  return ecode_run;
+}
@@ -57,14 +57,16 @@ int main(int argc, char *argv[])
 
     RoboCupSSLClient client;
     client.open(true);
-    SSL_WrapperPacket packet;
 
     while(true) {
-        if (client.receive(packet)) {
+        //blocks for the first packet, then reads everything that is pending:
+        int n = client.receiveBatch();
+        for (int k = 0; k < n; k++) {
+            const SSL_WrapperPacket & packet = client.getPacket(k);
             printf("-----Received Wrapper Packet---------------------------------------------\n");
             //see if the packet contains a robot detection frame:
             if (packet.has_detection()) {
-                SSL_DetectionFrame detection = packet.detection();
+                const SSL_DetectionFrame & detection = packet.detection();
                 //Display the contents of the robot detection results:
                 double t_now = GetTimeSec();
 
@@ -81,7 +83,7 @@ int main(int argc, char *argv[])
 
                 //Ball info:
                 for (int i = 0; i < balls_n; i++) {
-                    SSL_DetectionBall ball = detection.balls(i);
+                    const SSL_DetectionBall & ball = detection.balls(i);
                     printf("-Ball (%2d/%2d): CONF=%4.2f POS=<%9.2f,%9.2f> ", i+1, balls_n, ball.confidence(),ball.x(),ball.y());
                     if (ball.has_z()) {
                         printf("Z=%7.2f ",ball.z());
@@ -93,14 +95,14 @@ int main(int argc, char *argv[])
 
                 //Blue robot info:
                 for (int i = 0; i < robots_blue_n; i++) {
-                    SSL_DetectionRobot robot = detection.robots_blue(i);
+                    const SSL_DetectionRobot & robot = detection.robots_blue(i);
                     printf("-Robot(B) (%2d/%2d): ",i+1, robots_blue_n);
                     printRobotInfo(robot);
                 }
 
                 //Yellow robot info:
                 for (int i = 0; i < robots_yellow_n; i++) {
-                    SSL_DetectionRobot robot = detection.robots_yellow(i);
+                    const SSL_DetectionRobot & robot = detection.robots_yellow(i);
                     printf("-Robot(Y) (%2d/%2d): ",i+1, robots_yellow_n);
                     printRobotInfo(robot);
                 }
@@ -22,9 +22,13 @@
 
 #include "ClientThreading.h"
 #include <iostream>
-#include <fstream>
 #include <QFileDialog>
 #include <QDateTime>
+#include <QFileInfo>
+#include <QFile>
+#include "robocup_ssl_log_writer.h"
+#include <math.h>
+#include <algorithm>
 
 ViewUpdateThread::ViewUpdateThread ( SoccerView *_soccerView, QMutex* _drawMutex )
 {
@@ -35,6 +39,12 @@ ViewUpdateThread::ViewUpdateThread ( SoccerView *_soccerView, QMutex* _drawMutex
   connect(this, SIGNAL(change_play_button(QString)), this->soccerView, SLOT(change_play_button(QString)));
   shutdownView = false;
   play = false;
+  stopPlay = false;
+  for ( int i = 0; i < MaxCameras; i++ )
+    frameChanged[i] = false;
+  fieldChanged = false;
+  viewChanged = false;
+  tNextDraw = 0.0;
   fileName = QDir::homePath();
 }
 
@@ -43,109 +53,131 @@ void ViewUpdateThread::run()
   client.open ( false );
   while ( !shutdownView )
   {
-    int time = execute();
-    drawMutex->lock();
-    soccerView->updateView();
-    drawMutex->unlock();
-    msleep(abs(time));
-  }
-}
-
-int ViewUpdateThread::execute()
-{
-    int c = 0;
-    int n=0;
-    Log_Frame* log_frame;
-    SSL_DetectionFrame detection;
-    if ( client.receive ( packet ) && !play)
+    if(play)
     {
-      //see if the packet contains a robot detection frame:
-      if ( packet.has_detection() )
+      if(stopPlay)
       {
-        detection = packet.detection();
-        int balls_n = detection.balls_size();
-        //Ball info:
-        QVector<QPointF> balls;
-        for ( int i = 0; i < balls_n; i++ )
-        {
-          QPointF p;
-          SSL_DetectionBall ball = detection.balls ( i );
-          if ( ball.confidence() > 0.0 )
-          {
-            p.setX ( ball.x() );
-            p.setY ( ball.y() );
-            balls.push_back ( p );
-          }
-        }
-        drawMutex->lock();
-        soccerView->UpdateBalls ( balls,detection.camera_id() );
-        //Robot info:
-        soccerView->UpdateRobots ( detection );
-        drawMutex->unlock();
-      }
-      //see if packet contains geometry data:
-      if ( packet.has_geometry() )
-      {
-        drawMutex->lock();
-        const SSL_GeometryData & geom = packet.geometry();
-        const SSL_GeometryFieldSize & field = geom.field();
-        soccerView->LoadFieldGeometry ( ( SSL_GeometryFieldSize& ) field );
-        drawMutex->unlock();
+        end_play_record();
+        continue;
       }
+      int time = playNextFrame();
+      if ( viewChanged && GetTimeSec() >= tNextDraw )
+        draw();
+      msleep(abs(time));
+      continue;
     }
+    if(log_control->get_current_frame() != 0)
+      end_play_record();
 
-    if(!play && log_control->get_current_frame() != 0)
-        end_play_record();
+    //sleep until a packet arrives, or until the next refresh if there is
+    //something to draw:
+    int timeout = IdleWait;
+    if ( viewChanged )
+      timeout = std::max ( 0, ( int ) ceil ( ( tNextDraw - GetTimeSec() ) * 1000.0 ) );
+    if ( timeout == 0 || client.wait ( timeout ) )
+      receivePackets();
+    if ( viewChanged && GetTimeSec() >= tNextDraw )
+      draw();
+  }
+}
 
-    //Play logfile
-    if(play)
+void ViewUpdateThread::coalesce ( const SSL_DetectionFrame &detection )
+{
+  int camera = detection.camera_id();
+  if ( camera < 0 || camera >= MaxCameras )
+    return;
+  //reusing the frame of the camera does not allocate:
+  latestFrames[camera].CopyFrom ( detection );
+  QVector<QPointF> &balls = latestBalls[camera];
+  balls.clear();
+  int balls_n = detection.balls_size();
+  for ( int i = 0; i < balls_n; i++ )
+  {
+    const SSL_DetectionBall & ball = detection.balls ( i );
+    if ( ball.confidence() > 0.0 )
+      balls.push_back ( QPointF ( ball.x(), ball.y() ) );
+  }
+  frameChanged[camera] = true;
+  viewChanged = true;
+}
+
+void ViewUpdateThread::coalesce ( const SSL_WrapperPacket &packet )
+{
+  //see if the packet contains a robot detection frame:
+  if ( packet.has_detection() )
+    coalesce ( packet.detection() );
+  //see if packet contains geometry data:
+  if ( packet.has_geometry() )
+  {
+    latestField.CopyFrom ( packet.geometry().field() );
+    fieldChanged = true;
+    viewChanged = true;
+  }
+}
+
+void ViewUpdateThread::receivePackets()
+{
+  //only the newest frame of each camera is kept, older ones are dropped:
+  int packets_n = client.receiveBatch ( true );
+  for ( int k = 0; k < packets_n; k++ )
+    coalesce ( client.getPacket ( k ) );
+}
+
+void ViewUpdateThread::draw()
+{
+  drawMutex->lock();
+  if ( fieldChanged )
+    soccerView->LoadFieldGeometry ( latestField );
+  for ( int i = 0; i < MaxCameras; i++ )
+  {
+    if ( !frameChanged[i] )
+      continue;
+    soccerView->UpdateBalls ( latestBalls[i], i );
+    //Robot info:
+    soccerView->UpdateRobots ( latestFrames[i] );
+    frameChanged[i] = false;
+  }
+  soccerView->updateView();
+  drawMutex->unlock();
+  fieldChanged = false;
+  viewChanged = false;
+  tNextDraw = GetTimeSec() + 1.0 / RefreshRate;
+}
+
+int ViewUpdateThread::playNextFrame()
+{
+    if(log_control->get_next_frame() < 0)
     {
-        if(log_control->get_next_frame() < 0)
-            end_play_record();
-        else
-        {
-            //get next frame
-            log_frame = logs.mutable_log(log_control->get_current_frame());
-            SSL_DetectionFrame* det_frame = log_frame->mutable_frame();
-            detection = *det_frame;
-
-            //process frame
-            int balls_n = detection.balls_size();
-            //Ball info:
-            QVector<QPointF> balls;
-            for ( int i = 0; i < balls_n; i++ )
-            {
-              QPointF p;
-              SSL_DetectionBall ball = detection.balls ( i );
-              if ( ball.confidence() > 0.0 )
-              {
-                p.setX ( ball.x() );
-                p.setY ( ball.y() );
-                balls.push_back ( p );
-              }
-            }
-            drawMutex->lock();
-            soccerView->UpdateBalls ( balls,detection.camera_id() );
-            //Robot info:
-            soccerView->UpdateRobots ( detection );
-            drawMutex->unlock();
-        }
+        end_play_record();
+        return 4;
+    }
 
-        emit update_frame(log_control->get_current_frame());
+    //get next frame
+    double t_capture = 0.0;
+    int type, size;
+    const char * message;
+    if ( logs.read ( log_control->get_current_frame(), t_capture, type, message, size ) )
+    {
+      if ( type == RoboCupSSLLog::RecordLogFrame && logFrame.ParseFromArray ( message, size ) )
+        coalesce ( logFrame.frame() );
+      else if ( type == RoboCupSSLLog::RecordWrapperPacket && logPacket.ParseFromArray ( message, size ) )
+        coalesce ( logPacket );
+    }
 
-        //distance between frames in ms
-        if(log_control->get_play_speed() == 0)
-            return 10;
+    emit update_frame(log_control->get_current_frame());
 
-        //calculate distance between frames
-        if(!(log_control->get_prop_next_frame() < 0))
-        {
-            double old_time = detection.t_capture();
-            double new_time = logs.mutable_log(log_control->get_prop_next_frame())->mutable_frame()->t_capture();
-            double timediff = new_time - old_time;
-            return ((timediff * 1000) / log_control->get_play_speed());
-        }
+    //distance between frames in ms
+    if(log_control->get_play_speed() == 0)
+        return 10;
 
+    //calculate distance between frames
+    if(!(log_control->get_prop_next_frame() < 0))
+    {
+        double old_time = t_capture;
+        double new_time = old_time;
+        logs.read ( log_control->get_prop_next_frame(), new_time, type, message, size );
+        double timediff = new_time - old_time;
+        return ((timediff * 1000) / log_control->get_play_speed());
     }
 
     //distance between frames in ms, see http://xkcd.com/221/
@@ -169,7 +201,8 @@ void ViewUpdateThread::playLogfilePressed()
     }
     else
     {
-        end_play_record();
+        //the log may be read by run() right now, which closes it:
+        stopPlay = true;
     }
 }
 
@@ -188,48 +221,71 @@ int ViewUpdateThread::start_play_record()
     }
 
     //What data shall I read?
-    fileName = QFileDialog::getOpenFileName((QWidget*)this->parent(), tr("Open Logfile"), fileName, tr("Log Files (*.log)"));
+    fileName = QFileDialog::getOpenFileName((QWidget*)this->parent(), tr("Open Logfile"), fileName, tr("Log Files (*.log *.ssllog)"));
+    if (fileName.isEmpty())
+    {
+        //the dialog was cancelled, the next one starts at home again:
+        fileName = QDir::homePath();
+        return -1;
+    }
     std::cout << "fileName: " << fileName.toAscii().constData() << std::endl;
+    std::string file = fileName.toAscii().constData();
 
-    // Read the existing log.
-    std::fstream input(fileName.toAscii().constData(), std::ios::in | std::ios::binary);
-    if (!input)
+    //convert an old Refbox_Log, without loading it:
+    if (!RoboCupSSLLogReader::isLogFile(file))
     {
-        std::cout << fileName.toAscii().constData() << ": File not found." << std::endl;
-        return -1;
+        std::string converted = (QDir::tempPath() + "/" + QFileInfo(fileName).completeBaseName() + ".ssllog").toAscii().constData();
+        std::cout << "Converting " << file << " to " << converted << std::endl;
+        RoboCupSSLLogWriter writer;
+        if (!writer.open(converted))
+            return -1;
+        bool converted_ok = (writer.convertRefboxLog(file) >= 0);
+        if (!writer.close())
+            converted_ok = false;
+        if (!converted_ok)
+        {
+            std::cout << "Failed to convert Logfile." << std::endl;
+            QFile::remove(QString::fromAscii(converted.c_str()));
+            return -1;
+        }
+        file = converted;
     }
-    else if (!logs.ParseFromIstream(&input))
+
+    // Map the log.
+    if (!logs.open(file))
     {
-        std::cout << "Failed to parse Logfile." << std::endl;
+        std::cout << "Failed to open Logfile." << std::endl;
         return -1;
     }
 
     std::cout << "File successfully loaded" << std::endl;
-    if(logs.IsInitialized() && logs.log_size() > 0 && logs.log(0).IsInitialized())
+    if(logs.getRecordCount() > 0)
     {
-        std::cout << "Logfilegröße:  " << logs.log_size() << std::endl;
-        std::cout << "Start Command: " << logs.mutable_log(0)->refbox_cmd() << std::endl;
-        log_control->reset(logs.log_size());
-        emit log_size(logs.log_size());
+        std::cout << "Logfilegröße:  " << logs.getRecordCount() << std::endl;
+        std::cout << "Duration:      " << logs.getEndTime() - logs.getStartTime() << " s" << std::endl;
+        log_control->reset(logs.getRecordCount());
+        emit log_size(logs.getRecordCount());
         //initializeSlider(int min, int max, int singleStep, int pageStep, int tickInterval)
-        emit initializeSlider(0, logs.log_size(), 1, 100, 1800);
+        emit initializeSlider(0, logs.getRecordCount(), 1, 100, 1800);
         emit showLogControl(true);
     }
     else
     {
         std::cout << "Logfile seems to be empty or damaged" << std::endl;
+        logs.close();
         return -1;
     }
-    input.close();
     emit change_play_button("  End Play  ");
     return 0;
 }
 
 void ViewUpdateThread::end_play_record()
 {
-    play = false;
     log_control->reset(0);
-    logs.clear_log();
+    logs.close();
+    //the GUI may open the next log once play is false:
+    stopPlay = false;
+    play = false;
     emit showLogControl(false);
     emit change_play_button("Play Record");
     std::cout << "Stopped Playing Record" << std::endl;
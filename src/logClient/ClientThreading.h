@@ -28,23 +28,61 @@
 #include <QPointF>
 #include "GraphicsPrimitives.h"
 #include "robocup_ssl_client.h"
+#include "robocup_ssl_log_reader.h"
 #include "timer.h"
 #include "LogControl.h"
 
+/*!
+  \class   ViewUpdateThread
+  \brief   Receives the packets (or plays a log) and updates the SoccerView
+
+  The thread sleeps until a packet arrives. All packets that arrive until
+  the next refresh of the display are coalesced into the latest frame of
+  each camera, and the view is redrawn at most RefreshRate times per
+  second. The drawMutex is only held to apply the latest frames to the
+  view and to redraw it.
+
+  Logs are played from indexed log files (see RoboCupSSLLog), which are
+  mapped instead of loaded, so playback and seeking start at once. An old
+  Refbox_Log is converted to an indexed log in the temporary directory
+  first. The GUI thread opens the log before playback starts. Only this
+  thread reads and closes it, so the GUI only requests the end of the
+  playback.
+*/
 class ViewUpdateThread : public QThread
 {
     Q_OBJECT
 
   private:
+    static const int MaxCameras = 32;
+    static const int RefreshRate = 60; //redraws per second, at most
+    static const int IdleWait = 100; //ms to wait for a packet before checking for shutdown
+
     bool shutdownView;
     RoboCupSSLClient client;
-    SSL_WrapperPacket packet;
     SoccerView *soccerView;
-    int execute();
+
+    //the latest state, not yet drawn:
+    SSL_DetectionFrame latestFrames[MaxCameras];
+    QVector<QPointF> latestBalls[MaxCameras];
+    bool frameChanged[MaxCameras];
+    SSL_GeometryFieldSize latestField;
+    bool fieldChanged;
+    bool viewChanged;
+    double tNextDraw;
+
+    void coalesce ( const SSL_DetectionFrame &detection );
+    void coalesce ( const SSL_WrapperPacket &packet );
+    void receivePackets();
+    void draw();
+    int playNextFrame();
 
     //Logplayer
-    Refbox_Log logs;
-    bool play;
+    RoboCupSSLLogReader logs;
+    Log_Frame logFrame;
+    SSL_WrapperPacket logPacket;
+    volatile bool play;
+    volatile bool stopPlay; //set by the GUI, the playback ends in run()
     int start_play_record();
     void end_play_record();
     QString fileName;
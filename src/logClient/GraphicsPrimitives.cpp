@@ -300,38 +300,38 @@ void SoccerView::AddRobot ( Robot *robot )
   scene->addItem ( robot );
 }
 
-void SoccerView::UpdateRobots ( SSL_DetectionFrame &detection )
+void SoccerView::UpdateRobots ( const SSL_DetectionFrame &detection )
 {
   int robots_blue_n =  detection.robots_blue_size();
   int robots_yellow_n =  detection.robots_yellow_size();
   int i,j,yellowj=0,bluej=0;
   int team=teamBlue;
-  SSL_DetectionRobot robot;
   for ( i = 0; i < robots_blue_n+robots_yellow_n; i++ )
   {
+    const SSL_DetectionRobot * robot;
     if ( i<robots_blue_n )
     {
-      robot = detection.robots_blue ( i );
+      robot = &detection.robots_blue ( i );
       team = teamBlue;
       j=bluej;
     }
     else
     {
-      robot = detection.robots_yellow ( i-robots_blue_n );
+      robot = &detection.robots_yellow ( i-robots_blue_n );
       team = teamYellow;
       j=yellowj;
     }
 
-    double x,y,orientation,conf =robot.confidence();
+    double x,y,orientation,conf =robot->confidence();
     int id=NA, n=0;
-    if ( robot.has_robot_id() )
-      id = robot.robot_id();
+    if ( robot->has_robot_id() )
+      id = robot->robot_id();
     else
       id = NA;
-    x = robot.x();
-    y = robot.y();
-    if ( robot.has_orientation() )
-      orientation = robot.orientation() *180.0/M_PI;
+    x = robot->x();
+    y = robot->y();
+    if ( robot->has_orientation() )
+      orientation = robot->orientation() *180.0/M_PI;
     else
       orientation = NAOrientation;
 
@@ -424,7 +424,7 @@ void SoccerView::LoadFieldGeometry()
   this->penalty_line_from_spot_dist = FieldConstantsRoboCup2012::penalty_line_from_spot_dist;
 }
 
-void SoccerView::LoadFieldGeometry ( SSL_GeometryFieldSize &fieldSize )
+void SoccerView::LoadFieldGeometry ( const SSL_GeometryFieldSize &fieldSize )
 {
   this->line_width = fieldSize.line_width();
   this->field_length = fieldSize.field_length();
@@ -83,10 +83,10 @@ class SoccerView : public QGraphicsView
     SoccerView(QMutex*);
     ~SoccerView();
     void AddRobot ( Robot* robot );
-    void UpdateRobots ( SSL_DetectionFrame &detection );
+    void UpdateRobots ( const SSL_DetectionFrame &detection );
     int UpdateBalls ( QVector<QPointF> &_balls, int cameraID );
     void LoadFieldGeometry();
-    void LoadFieldGeometry ( SSL_GeometryFieldSize &fieldSize );
+    void LoadFieldGeometry ( const SSL_GeometryFieldSize &fieldSize );
     void updateView();
 
     void update ( qreal x, qreal y, qreal width, qreal height ) { return;}
@@ -0,0 +1,51 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    main.cpp
+  \brief   Converts Refbox_Log files to indexed log files
+  \author  Author Name, 2026
+*/
+//========================================================================
+
+#include <stdio.h>
+#include "robocup_ssl_log_writer.h"
+#include "robocup_ssl_log_reader.h"
+#include "timer.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3) {
+        printf("Usage: %s REFBOX_LOG OUTPUT\n",argv[0]);
+        printf("Converts a Refbox_Log (e.g. game.log) to an indexed log file (e.g. game.ssllog)\n");
+        return 1;
+    }
+    if (RoboCupSSLLogReader::isLogFile(argv[1])) {
+        fprintf(stderr,"%s is already an indexed log file\n",argv[1]);
+        return 1;
+    }
+
+    double t_start = GetTimeSec();
+    RoboCupSSLLogWriter writer;
+    if (writer.open(argv[2])==false) return 1;
+    long long frames = writer.convertRefboxLog(argv[1]);
+    if (writer.close()==false) return 1;
+
+    RoboCupSSLLogReader reader;
+    if (reader.open(argv[2])==false) return 1;
+    printf("Wrote %lld frame(s) of %.1f s to %s in %.2f s\n",reader.getRecordCount(),
+           reader.getEndTime()-reader.getStartTime(),argv[2],GetTimeSec()-t_start);
+    //a damaged Refbox_Log is converted up to the damage:
+    return frames < 0 ? 2 : 0;
+}
@@ -0,0 +1,241 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    main.cpp
+  \brief   Records the packets of the multicast group to indexed log files
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include <QCoreApplication>
+#include <QString>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+#include "qgetopt.h"
+#include "robocup_ssl_client.h"
+#include "robocup_ssl_async_log_writer.h"
+#include "timer.h"
+
+static volatile sig_atomic_t stop_requested=0;
+
+static void requestStop(int) {
+  stop_requested=1;
+}
+
+/*!
+  \class   FrameGaps
+  \brief   Counts the detection frames that were lost, from frame_number gaps
+
+  A frame counts as dropped when a later frame of its camera arrived first.
+  Frames that arrive after a later one are counted as late, and a frame
+  number far below the last one (a restarted vision server) starts the
+  camera anew.
+*/
+class FrameGaps {
+public:
+  static const int MaxCameras=32;
+  static const int RestartDistance=1000;
+  long long dropped[MaxCameras];
+  long long late[MaxCameras];
+  long long frames[MaxCameras];
+  long long restarts;
+  unsigned int last[MaxCameras];
+
+  FrameGaps() {
+    for (int i=0;i<MaxCameras;i++) {
+      dropped[i]=0;
+      late[i]=0;
+      frames[i]=0;
+      last[i]=0;
+    }
+    restarts=0;
+  }
+  void add(int camera, unsigned int frame_number) {
+    if (camera < 0 || camera >= MaxCameras) return;
+    if (frames[camera] > 0) {
+      if (frame_number > last[camera]) {
+        dropped[camera]+=frame_number - last[camera] - 1;
+      } else if (last[camera] - frame_number < (unsigned int)RestartDistance) {
+        late[camera]++;
+        frames[camera]++;
+        return;
+      } else {
+        restarts++;
+      }
+    }
+    last[camera]=frame_number;
+    frames[camera]++;
+  }
+  long long getDropped() const {
+    long long result=0;
+    for (int i=0;i<MaxCameras;i++) result+=dropped[i];
+    return result;
+  }
+  void print(FILE * out) const {
+    for (int i=0;i<MaxCameras;i++) {
+      if (frames[i]==0) continue;
+      fprintf(out,"  camera %d: %lld frame(s), %lld dropped, %lld late\n",i,frames[i],dropped[i],late[i]);
+    }
+    if (restarts > 0) fprintf(out,"  %lld restart(s) of the frame numbers\n",restarts);
+  }
+};
+
+/// the name of part \p part of a recording, from \p prefix and the current
+/// time. The names sort in the order of the parts, and no existing file is
+/// overwritten.
+static string nextFilename(const string & prefix, int & part) {
+  char date[32];
+  time_t now=time(0);
+  strftime(date,sizeof(date),"%Y%m%d-%H%M%S",localtime(&now));
+  string filename;
+  do {
+    char number[16];
+    snprintf(number,sizeof(number),"%04d",++part);
+    filename=prefix + "-" + date + "-" + number + ".ssllog";
+  } while (access(filename.c_str(),F_OK)==0);
+  return filename;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  GetOpt opts(argc, argv);
+  bool help=false;
+  bool quiet=false;
+  QString s_port;
+  QString address;
+  QString interface;
+  QString prefix;
+  QString s_size;
+  QString s_seconds;
+  QString s_buffer;
+  int ecode=0;
+  opts.addSwitch("help",&help);
+  opts.addOption( 'p',QString("port"),&s_port);
+  opts.addOption( 'a',QString("address"),&address);
+  opts.addOption( 'i',QString("interface"),&interface);
+  opts.addOption( 'o',QString("output"),&prefix);
+  opts.addOption( 's',QString("size"),&s_size);
+  opts.addOption( 't',QString("time"),&s_seconds);
+  opts.addOption( 'b',QString("buffer"),&s_buffer);
+  opts.addSwitch("quiet",&quiet);
+  if (!opts.parse()) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+  if (address.isEmpty()) address="224.5.23.2";
+  if (prefix.isEmpty()) prefix="ssl-vision";
+  int port=(s_port.isEmpty() ? 10002 : s_port.toInt());
+  long long max_size=(long long)((s_size.isEmpty() ? 1024.0 : s_size.toDouble())*1048576.0);
+  double max_seconds=(s_seconds.isEmpty() ? 0.0 : s_seconds.toDouble());
+  int buffer=(int)((s_buffer.isEmpty() ? 8.0 : s_buffer.toDouble())*1048576.0);
+  if (help==false && (port <= 0 || port > 65535 || max_size < 0 || max_seconds < 0.0 || buffer < 0)) {
+    fprintf(stderr,"Invalid command line parameters!\n");
+    help=true;
+    ecode=1;
+  }
+
+  if (help) {
+    printf("SSL-Vision log recorder command line options:\n");
+    printf(" -p PORT      Port of the multicast group (default: 10002)\n");
+    printf(" -a ADDRESS   Address of the multicast group (default: 224.5.23.2)\n");
+    printf(" -i ADDRESS   Address of the network interface (default: any)\n");
+    printf(" -o PREFIX    Prefix of the log files, which are named\n");
+    printf("              PREFIX-YYYYMMDD-HHMMSS-PART.ssllog (default: ssl-vision)\n");
+    printf(" -s MB        Start a new file at this size, 0 for none (default: 1024)\n");
+    printf(" -t SECONDS   Start a new file after this time, 0 for none (default: 0)\n");
+    printf(" -b MB        Kernel receive buffer of the socket (default: 8)\n");
+    printf(" --quiet      Do not print statistics every second\n");
+    printf(" --help       Show this help\n");
+    printf("Every datagram is stored unchanged with its receive time. Stop with\n");
+    printf("SIGTERM (or Ctrl-C) to have the last file completed.\n");
+    exit(ecode);
+  }
+
+  RoboCupSSLClient client(port,address.toStdString(),interface.toStdString());
+  if (client.open(false)==false) return 1;
+  if (buffer > 0) {
+    int result=client.setReceiveBuffer(buffer);
+    //Linux reports twice the requested size:
+    if (result < buffer) {
+      fprintf(stderr,"The receive buffer is %d bytes only, raise net.core.rmem_max for more\n",result/2);
+    }
+  }
+
+  signal(SIGTERM,requestStop);
+  signal(SIGINT,requestStop);
+
+  RoboCupSSLAsyncLogWriter writer;
+  SSL_WrapperPacket packet;
+  FrameGaps gaps;
+  long long packets=0;
+  long long invalid=0;
+  long long packets_reported=0;
+  int part=0;
+  double t_file=0.0;
+  double t_report=GetTimeSec() + 1.0;
+  bool ok=true;
+  while (ok && stop_requested==0) {
+    double t=GetTimeSec();
+    //an idle recorder keeps its file instead of starting empty ones:
+    if (writer.isOpen()==false || (writer.getRecordCount() > 0 &&
+        ((max_size > 0 && writer.getSize() >= max_size) || (max_seconds > 0.0 && t - t_file >= max_seconds)))) {
+      if (writer.isOpen()) {
+        ok=writer.close();
+        if (ok==false) break;
+      }
+      string filename=nextFilename(prefix.toStdString(),part);
+      ok=writer.open(filename);
+      if (ok==false) break;
+      t_file=t;
+      if (quiet==false) printf("Recording to %s\n",filename.c_str());
+    }
+    if (quiet==false && t >= t_report) {
+      printf("%lld packet(s)/s, %.1f MB in this file, %lld dropped, %lld disk wait(s)\n",
+             packets - packets_reported,writer.getSize()/1048576.0,gaps.getDropped(),writer.getStalls());
+      fflush(stdout);
+      packets_reported=packets;
+      t_report+=1.0;
+      if (t_report < t) t_report=t + 1.0;
+    }
+    //the timeout keeps the time rotation and the statistics running while
+    //nothing is received:
+    if (client.wait(100)==false) continue;
+    int n=client.receiveRawBatch();
+    t=GetTimeSec();
+    for (int i=0;i<n && ok;i++) {
+      const char * data=client.getData(i);
+      int size=client.getDataSize(i);
+      ok=writer.write(t,RoboCupSSLLog::RecordWrapperPacket,data,size);
+      if (packet.ParseFromArray(data,size)==false) {
+        invalid++;
+      } else if (packet.has_detection()) {
+        gaps.add(packet.detection().camera_id(),packet.detection().frame_number());
+      }
+    }
+    packets+=n;
+  }
+  if (writer.isOpen() && writer.close()==false) ok=false;
+  client.close();
+
+  printf("Recorded %lld packet(s), %lld of them invalid, %lld disk wait(s)\n",packets,invalid,writer.getStalls());
+  gaps.print(stdout);
+  return ok ? 0 : 1;
+}
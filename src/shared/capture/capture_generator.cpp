@@ -21,6 +21,8 @@
 
 #include "capture_generator.h"
 #include "conversions.h"
+#include "field_scene.h"
+#include <dc1394/conversions.h>
 
 
 #ifndef VDATA_NO_QT
@@ -30,6 +32,7 @@ CaptureGenerator::CaptureGenerator ( VarList * _settings ) : CaptureInterface (
 #endif
 {
   is_capturing=false;
+  scene_view=0;
 
   settings->addChild ( conversion_settings = new VarList ( "Conversion Settings" ) );
   settings->addChild ( capture_settings = new VarList ( "Capture Settings" ) );
@@ -44,10 +47,24 @@ CaptureGenerator::CaptureGenerator ( VarList * _settings ) : CaptureInterface (
   capture_settings->addChild ( v_width = new VarInt ( "Width (pixels)", 780 ) );
   capture_settings->addChild ( v_height = new VarInt ( "Height (pixels)", 580 ) );
   capture_settings->addChild ( v_test_image = new VarBool ( "Generate Color Test Image", false ) );
+  capture_settings->addChild ( v_scene = new VarBool ( "Generate Field Scene", false ) );
 }
 
 CaptureGenerator::~CaptureGenerator()
 {
+  delete scene_view;
+}
+
+void CaptureGenerator::setScene ( FieldScene * scene, const CameraParameters * camera, int camera_id )
+{
+#ifndef VDATA_NO_QT
+  mutex.lock();
+#endif
+  delete scene_view;
+  scene_view = ( scene!=0 && camera!=0 ) ? new FieldSceneView ( scene,camera,camera_id ) : 0;
+#ifndef VDATA_NO_QT
+  mutex.unlock();
+#endif
 }
 
 bool CaptureGenerator::stopCapture()
@@ -165,6 +182,8 @@ RawImage CaptureGenerator::getFrame()
         img.setPixel(x,y,color2);
       }
     }
+  } else if (v_scene->getBool() && scene_view!=0) {
+    scene_view->render(img,result.getTime());
   } else {
     img.fillBlack();
   }
@@ -34,6 +34,9 @@
   #include <pthread.h>
 #endif
 
+class FieldScene;
+class FieldSceneView;
+class CameraParameters;
 
 #ifndef VDATA_NO_QT
   #include <QMutex>
@@ -66,6 +69,8 @@ protected:
   VarInt * v_height;
   VarDouble * v_framerate;
   VarBool * v_test_image;
+  VarBool * v_scene;
+  FieldSceneView * scene_view;
   
 public:
 #ifndef VDATA_NO_QT
@@ -87,6 +92,10 @@ public:
 
   virtual bool copyAndConvertFrame(const RawImage & src, RawImage & target);
   virtual string getCaptureMethodName() const;
+
+  /// the scene rendered by "Generate Field Scene", seen through \p camera.
+  /// Neither is owned by the generator. Pass 0 to remove the scene.
+  void setScene(FieldScene * scene, const CameraParameters * camera, int camera_id);
 };
 
 #endif
@@ -28,6 +28,7 @@
 #include <errno.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <poll.h>
 
 #ifndef VDATA_NO_QT
 CaptureV4L2::CaptureV4L2 ( VarList * _settings, QObject * parent ) : QObject ( parent ), CaptureInterface ( _settings )
@@ -45,6 +46,10 @@ CaptureV4L2::CaptureV4L2 ( VarList * _settings ) : CaptureInterface ( _settings
 
     settings->addChild(v_device = new VarString("Device", "/dev/video0"));
 
+    // One buffer is held by the capture thread during processing,
+    // so we need at least one more queued in the driver to never miss a frame.
+    settings->addChild(v_buffer_count = new VarInt("Buffer Count", 4, 2, 32));
+
     //FIXME - Identify device by connection
     //FIXME - Identify device by serial number
 }
@@ -59,9 +64,11 @@ void CaptureV4L2::populateConfiguration()
     struct v4l2_fmtdesc fmtdesc;
     fmtdesc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     fmtdesc.index = 0;
+    device_formats.clear();
     while (ioctl(fd, VIDIOC_ENUM_FMT, &fmtdesc) == 0)
     {
         printf("Format %d: %s\n", fmtdesc.index, fmtdesc.description);
+        device_formats.push_back(fmtdesc.pixelformat);
         ++fmtdesc.index;
     }
 
@@ -191,6 +198,17 @@ bool CaptureV4L2::startCapture()
     fmt.fmt.pix.width = 640;
     fmt.fmt.pix.height = 480;
     fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_YUYV;
+
+    // Prefer UYVY if the device supports it, since the frame can then be
+    // used without any conversion (see canBorrowFrame).
+    for (unsigned int i = 0; i < device_formats.size(); ++i)
+    {
+        if (device_formats[i] == V4L2_PIX_FMT_UYVY)
+        {
+            fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_UYVY;
+            break;
+        }
+    }
     fmt.fmt.pix.field = V4L2_FIELD_NONE;
     if (ioctl(fd, VIDIOC_S_FMT, &fmt) != 0)
     {
@@ -231,6 +249,10 @@ bool CaptureV4L2::startCapture()
             color_format = COLOR_YUV422_YUYV;
             break;
 
+        case V4L2_PIX_FMT_UYVY:
+            color_format = COLOR_YUV422_UYVY;
+            break;
+
         default:
         {
             char format_string[5];
@@ -247,7 +269,7 @@ bool CaptureV4L2::startCapture()
 
     // Allocate buffers
     struct v4l2_requestbuffers req;
-    req.count = 2;
+    req.count = v_buffer_count->getInt();
     req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     req.memory = V4L2_MEMORY_MMAP;
     if (ioctl(fd, VIDIOC_REQBUFS, &req) != 0)
@@ -314,8 +336,9 @@ bool CaptureV4L2::startCapture()
         return false;
     }
 
-    // Make device configuration item read-only
+    // Make device configuration items read-only
     v_device->addFlags(VARTYPE_FLAG_READONLY);
+    v_buffer_count->addFlags(VARTYPE_FLAG_READONLY);
 
     return true;
 }
@@ -324,8 +347,9 @@ bool CaptureV4L2::stopCapture()
 {
     cleanup();
 
-    // Make device configuration item read-write
+    // Make device configuration items read-write
     v_device->removeFlags(VARTYPE_FLAG_READONLY);
+    v_buffer_count->removeFlags(VARTYPE_FLAG_READONLY);
 
     return true;
 }
@@ -400,6 +424,53 @@ RawImage CaptureV4L2::getFrame()
     return buffers[last_buf.index];
 }
 
+RawImage CaptureV4L2::getLatestFrame(int & skipped)
+{
+    skipped = 0;
+    RawImage result = getFrame();
+    if (result.getData() == 0)
+    {
+        return result;
+    }
+
+#ifndef VDATA_NO_QT
+    QMutexLocker lock(&mutex);
+#endif
+
+    // Dequeue any newer frames that are already waiting, without blocking.
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    while (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN))
+    {
+        struct v4l2_buffer newer;
+        memset(&newer, 0, sizeof(newer));
+        newer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        newer.memory = V4L2_MEMORY_MMAP;
+        if (ioctl(fd, VIDIOC_DQBUF, &newer) != 0)
+        {
+            break;
+        }
+
+        // Give the older buffer back to the driver
+        if (ioctl(fd, VIDIOC_QBUF, &last_buf) != 0)
+        {
+            fprintf(stderr, "CaptureV4L2::getLatestFrame: VIDIOC_QBUF failed: %m\n");
+        }
+        last_buf = newer;
+        ++skipped;
+    }
+
+    if (skipped > 0)
+    {
+        const struct timeval &tv = last_buf.timestamp;
+        buffers[last_buf.index].setTime((double)tv.tv_sec + tv.tv_usec*(1.0E-6) + timeOffset);
+        result = buffers[last_buf.index];
+    }
+
+    return result;
+}
+
 bool CaptureV4L2::copyAndConvertFrame(const RawImage & src, RawImage & target)
 {
 #ifndef VDATA_NO_QT
@@ -417,7 +488,10 @@ bool CaptureV4L2::copyAndConvertFrame(const RawImage & src, RawImage & target)
     }
     target.setTime(src.getTime());
 
-    if (src_fmt == COLOR_YUV422_YUYV && output_fmt == COLOR_YUV422_UYVY)
+    if (src_fmt == output_fmt)
+    {
+        memcpy(target.getData(), src.getData(), src.getNumBytes());
+    } else if (src_fmt == COLOR_YUV422_YUYV && output_fmt == COLOR_YUV422_UYVY)
     {
         //FIXME - Can you make this faster?
 //         struct timespec t0;
@@ -459,6 +533,16 @@ bool CaptureV4L2::copyAndConvertFrame(const RawImage & src, RawImage & target)
     return true;
 }
 
+bool CaptureV4L2::canBorrowFrame(const RawImage & src)
+{
+#ifndef VDATA_NO_QT
+    QMutexLocker lock(&mutex);
+#endif
+
+    ColorFormat output_fmt = Colors::stringToColorFormat(v_colorout->getSelection().c_str());
+    return src.getData() != 0 && src.getColorFormat() == output_fmt;
+}
+
 void CaptureV4L2::releaseFrame()
 {
 #ifndef VDATA_NO_QT
@@ -60,12 +60,16 @@ protected:
   // Adds choices to comboboxes and adds camera controls
   void populateConfiguration();
 
+  // Pixel formats reported by VIDIOC_ENUM_FMT
+  vector<uint32_t> device_formats;
+
   struct v4l2_buffer last_buf;
   vector<RawImage> buffers;
   
   // Configuration
   VarStringEnum *v_colorout;
   VarString *v_device;
+  VarInt *v_buffer_count;
   VarList *v_controls;
 
   // Map from VarType to camera control ID for each control
@@ -94,11 +98,13 @@ public:
   virtual bool isCapturing();
   
   virtual RawImage getFrame();
+  virtual RawImage getLatestFrame(int & skipped);
   virtual void releaseFrame();
    
   void cleanup();
 
   virtual bool copyAndConvertFrame(const RawImage & src, RawImage & target);
+  virtual bool canBorrowFrame(const RawImage & src);
   virtual string getCaptureMethodName() const;
 };
 
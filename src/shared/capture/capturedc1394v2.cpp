@@ -1529,6 +1529,13 @@ bool CaptureDC1394v2::copyAndConvertFrame(const RawImage & src, RawImage & targe
                       v_debayer_y16->getInt());
 }
 
+bool CaptureDC1394v2::canBorrowFrame(const RawImage & src)
+{
+  //convertFrame does a plain memcpy if no conversion is needed:
+  return (src.getData()!=0 &&
+          src.getColorFormat()==Colors::stringToColorFormat(v_colorout->getSelection().c_str()));
+}
+
 
 bool CaptureDC1394v2::convertFrame(const RawImage & src, RawImage & target, ColorFormat output_fmt,
                          bool debayer, dc1394color_filter_t bayer_format,dc1394bayer_method_t bayer_method, int y16bits)
@@ -1662,6 +1669,42 @@ RawImage CaptureDC1394v2::getFrame()
   return result;
 }
 
+RawImage CaptureDC1394v2::getLatestFrame(int & skipped)
+{
+  skipped=0;
+  RawImage result=getFrame();
+  if (result.getData()==0) return result;
+  #ifndef VDATA_NO_QT
+    mutex.lock();
+  #endif
+  //poll for any newer frames which are already waiting in the DMA ring:
+  dc1394video_frame_t * newer=0;
+  while (dc1394_capture_dequeue(camera, DC1394_CAPTURE_POLICY_POLL, &newer)==DC1394_SUCCESS && newer!=0) {
+    if (dc1394_capture_enqueue (camera, frame) !=DC1394_SUCCESS) {
+      fprintf (stderr, "CaptureDC1394v2 Error: Failed to release frame from camera %d\n", cam_id);
+    }
+    frame=newer;
+    newer=0;
+    skipped++;
+  }
+  if (skipped > 0) {
+    //note: RawImage::setData would free the old driver pointer, so build a new image
+    RawImage latest;
+    latest.setColorFormat(capture_format);
+    latest.setWidth(width);
+    latest.setHeight(height);
+    timeval tv;
+    gettimeofday(&tv,NULL);
+    latest.setTime((double)tv.tv_sec + tv.tv_usec*(1.0E-6));
+    latest.setData(frame->image);
+    result=latest;
+  }
+  #ifndef VDATA_NO_QT
+    mutex.unlock();
+  #endif
+  return result;
+}
+
 void CaptureDC1394v2::releaseFrame() {
   #ifndef VDATA_NO_QT
     mutex.lock();
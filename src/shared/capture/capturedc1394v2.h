@@ -439,6 +439,10 @@ public:
 
   virtual bool copyAndConvertFrame(const RawImage & src, RawImage & target);
 
+  virtual RawImage getLatestFrame(int & skipped);
+
+  virtual bool canBorrowFrame(const RawImage & src);
+
   virtual string getCaptureMethodName() const;
 
 protected:
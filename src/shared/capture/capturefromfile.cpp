@@ -25,6 +25,7 @@
 #include "capturefromfile.h"
 #include "image_io.h"
 #include "conversions.h"
+#include <dc1394/conversions.h>
 
 
 #ifndef VDATA_NO_QT
@@ -35,6 +36,7 @@ CaptureFromFile::CaptureFromFile(VarList * _settings) : CaptureInterface(_settin
 {
   currentImageIndex = 0;
   is_capturing=false;
+  limit_fps=0.0;
 
   settings->addChild(conversion_settings = new VarList("Conversion Settings"));
   settings->addChild(capture_settings = new VarList("Capture Settings"));
@@ -46,6 +48,8 @@ CaptureFromFile::CaptureFromFile(VarList * _settings) : CaptureInterface(_settin
     
   //=======================CAPTURE SETTINGS==========================
   capture_settings->addChild(v_cap_dir = new VarString("directory", ""));
+  //0 delivers the images as fast as they are processed
+  capture_settings->addChild(v_framerate = new VarDouble("Framerate (FPS)", 0.0));
     
   // Valid file endings
   validImageFileEndings.push_back("PNG");
@@ -135,6 +139,8 @@ bool CaptureFromFile::startCapture()
     }
     currentImageIndex = 0;
   }
+  limit_fps=v_framerate->getDouble();
+  if (limit_fps > 0.0) limit.init(limit_fps);
   is_capturing=true;  
   
 #ifndef VDATA_NO_QT
@@ -212,6 +218,7 @@ RawImage CaptureFromFile::getFrame()
 #ifndef VDATA_NO_QT
    mutex.lock();
 #endif
+  if (limit_fps > 0.0) limit.waitForNextFrame();
 
   RawImage result;
   result.setColorFormat(COLOR_RGB8); 
@@ -29,6 +29,7 @@
 #include <list>
 #include <algorithm>
 #include "VarTypes.h"
+#include "framelimiter.h"
 
 #ifndef VDATA_NO_QT
   #include <QMutex>
@@ -62,6 +63,9 @@ protected:
 
   //capture variables:
   VarString * v_cap_dir;
+  VarDouble * v_framerate;
+  FrameLimiter limit;
+  double limit_fps; //the framerate at the last start of the capture
   VarList * capture_settings;
   VarList * conversion_settings;
 
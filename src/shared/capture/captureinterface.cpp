@@ -37,6 +37,11 @@ CaptureInterface::~CaptureInterface()
 }
 
 
+RawImage CaptureInterface::getLatestFrame(int & skipped) {
+  skipped=0;
+  return getFrame();
+}
+
 bool CaptureInterface::resetBus() {
   return true;
 }
@@ -45,6 +50,11 @@ void CaptureInterface::readAllParameterValues() {
 
 }
 
+bool CaptureInterface::canBorrowFrame(const RawImage & src) {
+  (void)src;
+  return false;
+}
+
 bool CaptureInterface::copyAndConvertFrame(const RawImage & src, RawImage & target) {
   target.ensure_allocation(target.getColorFormat(),src.getWidth(),src.getHeight());
   target.setTime(src.getTime());
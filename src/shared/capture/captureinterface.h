@@ -59,6 +59,14 @@ public:
     /// memory location until releaseFrame() is called.
     virtual RawImage getFrame()     = 0;
 
+    /// Like getFrame(), but drains any further frames which are already
+    /// waiting in the driver's queue, and only returns the most recent one.
+    /// All older frames are released immediately and their count is
+    /// stored in \p skipped.
+    /// This bounds latency when processing can not keep up with capturing.
+    /// The default implementation just calls getFrame().
+    virtual RawImage getLatestFrame(int & skipped);
+
     /// This function should return true, if your method is currently
     /// actively capturing data.
     virtual bool     isCapturing() = 0;
@@ -102,6 +110,14 @@ public:
     /// already allocated, and then memcpy the data as-is.
     virtual bool     copyAndConvertFrame(const RawImage & src, RawImage & target);
 
+    /// This function should return true if a frame returned by getFrame()
+    /// can be processed as-is, i.e. if copyAndConvertFrame() would do
+    /// nothing but a plain memcpy of \p src.
+    /// If zero-copy capture is enabled, the capture thread will then process
+    /// the driver buffer directly and only release it after processing.
+    /// The default implementation returns false.
+    virtual bool     canBorrowFrame(const RawImage & src);
+
     /// Return a string describing your capture method
     /// e.g. DC1394B, or GigEVision, or V4LCapture, or USBCam,...
     virtual string   getCaptureMethodName() const = 0;
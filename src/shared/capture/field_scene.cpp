@@ -0,0 +1,539 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    field_scene.cpp
+  \brief   C++ Implementation: FieldScene, FieldSceneView
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "field_scene.h"
+#include <math.h>
+#include <string.h>
+#include "timer.h"
+
+const double FieldScene::robot_radius=90.0;
+const double FieldScene::ball_radius=21.5;
+
+//a small deterministic generator, so that a seed always yields the same scene:
+static double sceneRandom(unsigned int & state) {
+  state=state*1103515245u+12345u;
+  return (double)((state >> 8) & 0xFFFF)/65536.0;
+}
+
+//folds p back into [lo,hi], like a ball bouncing between two walls:
+static double sceneReflect(double p, double lo, double hi) {
+  double span=hi-lo;
+  if (span <= 0.0) return lo;
+  double u=fmod(p-lo,2.0*span);
+  if (u < 0.0) u+=2.0*span;
+  return lo + (u > span ? 2.0*span-u : u);
+}
+
+FieldScene::FieldScene(RoboCupField * _field)
+{
+  field=_field;
+  t0=GetTimeSec();
+  server=0;
+  server_port=0;
+
+  settings=new VarList("Synthetic Scene");
+  settings->addChild(v_robots=new VarInt("Robots per Team",6,0,12));
+  settings->addChild(v_balls=new VarInt("Balls",1,0,16));
+  settings->addChild(v_robot_speed=new VarDouble("Robot Speed (mm/s)",1000.0,0.0));
+  settings->addChild(v_ball_speed=new VarDouble("Ball Speed (mm/s)",2500.0,0.0));
+  settings->addChild(v_seed=new VarInt("Random Seed",1));
+  settings->addChild(v_noise=new VarDouble("Noise StdDev",0.0,0.0,128.0));
+  settings->addChild(v_gradient=new VarDouble("Lighting Gradient (%)",0.0,0.0,100.0));
+  settings->addChild(ground_truth=new VarList("Ground Truth"));
+  ground_truth->addChild(v_publish=new VarBool("Publish",false));
+  ground_truth->addChild(v_address=new VarString("Multicast Address","224.5.23.2"));
+  ground_truth->addChild(v_port=new VarInt("Multicast Port",10010,1,65535));
+  ground_truth->addChild(v_interface=new VarString("Multicast Interface",""));
+}
+
+FieldScene::~FieldScene()
+{
+  delete server;
+  settings->deleteAllChildren();
+  ground_truth->deleteAllChildren();
+  delete settings;
+}
+
+VarList * FieldScene::getSettings() {
+  return settings;
+}
+
+RoboCupField * FieldScene::getField() const {
+  return field;
+}
+
+double FieldScene::getNoise() const {
+  return v_noise->getDouble();
+}
+
+double FieldScene::getGradient() const {
+  return v_gradient->getDouble();
+}
+
+bool FieldScene::isPublishing() const {
+  return v_publish->getBool();
+}
+
+bool FieldScene::loadPattern(const rgbImage & img, int x0, int y0, int w, int h, double default_height, bool use_image_height, Pattern & p) {
+  //the marker colors, as in MultiPatternModel::loadSinglePatternImage:
+  static const int n_palette=8;
+  const rgb palette[n_palette]={RGB::Black,RGB::DarkGreen,RGB::Blue,RGB::Yellow,RGB::Pink,RGB::Cyan,RGB::Green,RGB::White};
+  const int labels[n_palette]={LabelBlack,LabelBlack,LabelCenter,-1,LabelPink,LabelCyan,LabelGreen,LabelWhite};
+
+  p.width=w;
+  p.height=h;
+  p.labels.assign(w*h,LabelBlack);
+  double sum_x=0.0;
+  double sum_y=0.0;
+  int n_center=0;
+  int hx0=w, hy0=h, hx1=-1, hy1=-1;
+  for (int y=0;y<h;y++) {
+    for (int x=0;x<w;x++) {
+      rgb c=img.getPixel(x0+x,y0+y);
+      int best=0;
+      int best_dist=0;
+      for (int i=0;i<n_palette;i++) {
+        int d=sq((int)c.r-(int)palette[i].r)+sq((int)c.g-(int)palette[i].g)+sq((int)c.b-(int)palette[i].b);
+        if (i==0 || d < best_dist) {
+          best=i;
+          best_dist=d;
+        }
+      }
+      if (labels[best]==-1) {
+        //the height indicator is not part of the robot top:
+        hx0=min(hx0,x);
+        hy0=min(hy0,y);
+        hx1=max(hx1,x);
+        hy1=max(hy1,y);
+        continue;
+      }
+      p.labels[y*w+x]=(unsigned char)labels[best];
+      if (labels[best]==LabelCenter) {
+        sum_x+=x;
+        sum_y+=y;
+        n_center++;
+      }
+    }
+  }
+  if (n_center==0) {
+    p=Pattern();
+    return false;
+  }
+  p.cen_x=sum_x/n_center;
+  p.cen_y=sum_y/n_center;
+  p.robot_height=default_height;
+  int indicator_width=hx1-hx0+1;
+  if (use_image_height && hx1 >= 0 && indicator_width >= 1 && indicator_width <= 6) {
+    p.robot_height=hy1-hy0+1;
+  }
+  return true;
+}
+
+bool FieldScene::setTeam(TeamColor team, const string & image_file, int rows, int cols,
+                         double default_height, bool use_image_heights, const vector<bool> & valid) {
+  vector<Pattern> loaded;
+  bool ok=true;
+  if (image_file.length() > 0) {
+    rgbImage img;
+    if (img.load(image_file)==false) {
+      fprintf(stderr,"Synthetic Scene: unable to load team image file: '%s'.\n",image_file.c_str());
+      ok=false;
+    } else if (rows <= 0 || cols <= 0 || (img.getWidth() % cols)!=0 || (img.getHeight() % rows)!=0) {
+      fprintf(stderr,"Synthetic Scene: image dimensions (%dx%d) of '%s' are not divisible by columns (%d) and/or rows (%d).\n",
+              img.getWidth(),img.getHeight(),image_file.c_str(),cols,rows);
+      ok=false;
+    } else {
+      int cell_w=img.getWidth()/cols;
+      int cell_h=img.getHeight()/rows;
+      loaded.resize(rows*cols);
+      for (int idx=0;idx<rows*cols;idx++) {
+        if (idx < (int)valid.size() && valid[idx]==false) continue;
+        loadPattern(img,(idx%cols)*cell_w,(idx/cols)*cell_h,cell_w,cell_h,default_height,use_image_heights,loaded[idx]);
+      }
+    }
+  }
+  patterns_lock.lockForWrite();
+  patterns[team].swap(loaded);
+  patterns_lock.unlock();
+  return ok;
+}
+
+void FieldScene::lockPatterns() {
+  patterns_lock.lockForRead();
+}
+
+void FieldScene::unlockPatterns() {
+  patterns_lock.unlock();
+}
+
+const FieldScene::Pattern * FieldScene::getPattern(int team, int id) const {
+  if (team < 0 || team > 1 || id < 0 || id >= (int)patterns[team].size()) return 0;
+  const Pattern * p=&patterns[team][id];
+  return (p->width > 0 ? p : 0);
+}
+
+void FieldScene::setTimeOrigin(double t) {
+  t0=t;
+}
+
+void FieldScene::getState(double time, vector<Robot> & robots, vector<Ball> & balls) const {
+  robots.clear();
+  balls.clear();
+  double t=time-t0;
+  int n_robots=v_robots->getInt();
+  int n_balls=v_balls->getInt();
+  double robot_speed=v_robot_speed->getDouble();
+  double ball_speed=v_ball_speed->getDouble();
+  unsigned int seed=(unsigned int)v_seed->getInt();
+  double hl=field->field_length->getInt()*0.5;
+  double hw=field->field_width->getInt()*0.5;
+
+  //the first n robots of each team that have a marker pattern, interleaved
+  //so that both teams are spread across the whole field:
+  vector<Robot> team_robots[2];
+  patterns_lock.lockForRead();
+  for (int team=0;team<2;team++) {
+    for (unsigned int id=0;id<patterns[team].size() && (int)team_robots[team].size() < n_robots;id++) {
+      if (patterns[team][id].width==0) continue;
+      Robot r;
+      r.team=team;
+      r.id=id;
+      r.height=patterns[team][id].robot_height;
+      team_robots[team].push_back(r);
+    }
+  }
+  patterns_lock.unlock();
+  for (unsigned int i=0;i<team_robots[0].size() || i<team_robots[1].size();i++) {
+    if (i < team_robots[0].size()) robots.push_back(team_robots[0][i]);
+    if (i < team_robots[1].size()) robots.push_back(team_robots[1][i]);
+  }
+
+  //every robot circles in its own cell of a grid that spans the field:
+  int n=robots.size();
+  if (n > 0 && hl > 0.0 && hw > 0.0) {
+    int cols=max(1,(int)ceil(sqrt(n*hl/hw)));
+    int rows=(n+cols-1)/cols;
+    double cell_w=2.0*hl/cols;
+    double cell_h=2.0*hw/rows;
+    double orbit=max(0.0,min(cell_w,cell_h)*0.5-robot_radius-20.0);
+    for (int i=0;i<n;i++) {
+      unsigned int state=seed*7919u+i;
+      double phase=sceneRandom(state)*2.0*M_PI;
+      double dir=(sceneRandom(state) < 0.5 ? -1.0 : 1.0);
+      double home_x=-hl+((i%cols)+0.5)*cell_w;
+      double home_y=-hw+((i/cols)+0.5)*cell_h;
+      double a=phase;
+      if (orbit > 0.0) a+=dir*robot_speed/orbit*t;
+      Robot & r=robots[i];
+      r.x=home_x+orbit*cos(a);
+      r.y=home_y+orbit*sin(a);
+      r.angle=angle_mod(a+dir*M_PI*0.5);
+    }
+  }
+
+  //balls bounce between the field lines:
+  for (int i=0;i<n_balls;i++) {
+    unsigned int state=seed*104729u+i;
+    double x=(sceneRandom(state)*2.0-1.0)*hl;
+    double y=(sceneRandom(state)*2.0-1.0)*hw;
+    double dir=sceneRandom(state)*2.0*M_PI;
+    Ball b;
+    b.x=sceneReflect(x+cos(dir)*ball_speed*t,-hl+ball_radius,hl-ball_radius);
+    b.y=sceneReflect(y+sin(dir)*ball_speed*t,-hw+ball_radius,hw-ball_radius);
+    balls.push_back(b);
+  }
+}
+
+void FieldScene::publish(const SSL_WrapperPacket & packet) {
+  server_mutex.lock();
+  int port=v_port->getInt();
+  string address=v_address->getString();
+  string interface=v_interface->getString();
+  if (server==0 || port!=server_port || address!=server_address || interface!=server_interface) {
+    delete server;
+    server=new RoboCupSSLServer(port,address,interface);
+    server_port=port;
+    server_address=address;
+    server_interface=interface;
+    if (server->open()==false) {
+      fprintf(stderr,"Synthetic Scene: unable to open the ground truth server on %s:%d\n",address.c_str(),port);
+    }
+  }
+  server->send(packet);
+  server_mutex.unlock();
+}
+
+FieldSceneView::FieldSceneView(FieldScene * _scene, const CameraParameters * _camera, int _camera_id)
+{
+  scene=_scene;
+  camera=_camera;
+  camera_id=_camera_id;
+  frame_number=0;
+  rand_state=2463534242u+camera_id;
+  gain_gradient=-1.0;
+}
+
+FieldSceneView::~FieldSceneView()
+{
+}
+
+void FieldSceneView::computeKey(int width, int height, vector<double> & result) const {
+  //everything the background depends on, with the calibration sampled at the image corners:
+  RoboCupField * field=scene->getField();
+  result.clear();
+  result.push_back(width);
+  result.push_back(height);
+  result.push_back(field->line_width->getInt());
+  result.push_back(field->field_length->getInt());
+  result.push_back(field->field_width->getInt());
+  result.push_back(field->boundary_width->getInt());
+  result.push_back(field->referee_width->getInt());
+  result.push_back(field->center_circle_radius->getInt());
+  result.push_back(field->defense_radius->getInt());
+  result.push_back(field->defense_stretch->getInt());
+  const double corners[5][2]={{0,0},{1,0},{0,1},{1,1},{0.5,0.5}};
+  for (int i=0;i<5;i++) {
+    GVector::vector2d<double> p_i(corners[i][0]*(width-1),corners[i][1]*(height-1));
+    GVector::vector3d<double> p_f;
+    camera->image2field(p_f,p_i,0.0);
+    result.push_back(p_f.x);
+    result.push_back(p_f.y);
+  }
+}
+
+rgb FieldSceneView::fieldColor(double x, double y) const {
+  RoboCupField * field=scene->getField();
+  double lw=field->line_width->getInt();
+  double hl=field->field_length->getInt()*0.5;
+  double hw=field->field_width->getInt()*0.5;
+  double surface=field->boundary_width->getInt()+field->referee_width->getInt();
+  double ax=fabs(x);
+  double ay=fabs(y);
+  if (ax > hl+surface || ay > hw+surface) return rgb(64,64,64);
+  if (ax <= hl && ay <= hw) {
+    //field boundary, measured outside to outside:
+    if (ax >= hl-lw || ay >= hw-lw) return RGB::White;
+    //center line and center circle:
+    if (ax <= lw*0.5) return RGB::White;
+    if (fabs(sqrt(x*x+y*y)-field->center_circle_radius->getInt()) <= lw*0.5) return RGB::White;
+    //defense areas, two quarter circles connected by a straight line:
+    double dr=field->defense_radius->getInt();
+    double hs=field->defense_stretch->getInt()*0.5;
+    double dx=hl-ax;
+    double dy=ay-hs;
+    double d=(dy <= 0.0 ? dx : sqrt(dx*dx+dy*dy));
+    if (fabs(d-dr) <= lw*0.5) return RGB::White;
+  }
+  return RGB::DarkGreen;
+}
+
+void FieldSceneView::renderBackground(int width, int height) {
+  background.allocate(width,height);
+  for (int y=0;y<height;y++) {
+    for (int x=0;x<width;x++) {
+      GVector::vector2d<double> p_i(x,y);
+      GVector::vector3d<double> p_f;
+      camera->image2field(p_f,p_i,0.0);
+      background.setPixel(x,y,fieldColor(p_f.x,p_f.y));
+    }
+  }
+}
+
+/// The camera model, linearized around the projection of (x,y,z), as the
+/// field offsets \p a and \p b of one pixel in x and y. Returns false if
+/// the point is not visible or the mapping is degenerate.
+static bool linearize(const CameraParameters * camera, double x, double y, double z,
+                      GVector::vector2d<double> & center, GVector::vector2d<double> & a, GVector::vector2d<double> & b) {
+  GVector::vector3d<double> p_f(x,y,z);
+  camera->field2image(p_f,center);
+  GVector::vector3d<double> f0, fx, fy;
+  GVector::vector2d<double> p_i=center;
+  camera->image2field(f0,p_i,z);
+  p_i.set(center.x+1.0,center.y);
+  camera->image2field(fx,p_i,z);
+  p_i.set(center.x,center.y+1.0);
+  camera->image2field(fy,p_i,z);
+  a.set(fx.x-f0.x,fx.y-f0.y);
+  b.set(fy.x-f0.x,fy.y-f0.y);
+  double det=a.x*b.y-a.y*b.x;
+  return (fabs(det) > 1e-9 && finite(center.x) && finite(center.y));
+}
+
+void FieldSceneView::drawBall(rgbImage & img, const FieldScene::Ball & ball) {
+  GVector::vector2d<double> c, a, b;
+  if (linearize(camera,ball.x,ball.y,FieldScene::ball_radius,c,a,b)==false) return;
+  double det=a.x*b.y-a.y*b.x;
+  double r=FieldScene::ball_radius;
+  double ex=r*(fabs(b.x)+fabs(b.y))/fabs(det);
+  double ey=r*(fabs(a.x)+fabs(a.y))/fabs(det);
+  int x0=max(0,(int)floor(c.x-ex));
+  int x1=min(img.getWidth()-1,(int)ceil(c.x+ex));
+  int y0=max(0,(int)floor(c.y-ey));
+  int y1=min(img.getHeight()-1,(int)ceil(c.y+ey));
+  for (int y=y0;y<=y1;y++) {
+    for (int x=x0;x<=x1;x++) {
+      double dx=(x-c.x)*a.x+(y-c.y)*b.x;
+      double dy=(x-c.x)*a.y+(y-c.y)*b.y;
+      if (dx*dx+dy*dy <= r*r) img.setPixel(x,y,RGB::Orange);
+    }
+  }
+}
+
+void FieldSceneView::drawRobot(rgbImage & img, const FieldScene::Robot & robot) {
+  const FieldScene::Pattern * p=scene->getPattern(robot.team,robot.id);
+  if (p==0) return;
+  GVector::vector2d<double> c, a, b;
+  if (linearize(camera,robot.x,robot.y,robot.height,c,a,b)==false) return;
+  double det=a.x*b.y-a.y*b.x;
+  double r=FieldScene::robot_radius;
+  double ex=r*(fabs(b.x)+fabs(b.y))/fabs(det);
+  double ey=r*(fabs(a.x)+fabs(a.y))/fabs(det);
+  int x0=max(0,(int)floor(c.x-ex));
+  int x1=min(img.getWidth()-1,(int)ceil(c.x+ex));
+  int y0=max(0,(int)floor(c.y-ey));
+  int y1=min(img.getHeight()-1,(int)ceil(c.y+ey));
+  rgb colors[6];
+  colors[FieldScene::LabelBlack]=RGB::Black;
+  colors[FieldScene::LabelCenter]=(robot.team==FieldScene::TeamBlue ? RGB::Blue : RGB::Yellow);
+  colors[FieldScene::LabelPink]=RGB::Pink;
+  colors[FieldScene::LabelCyan]=RGB::Cyan;
+  colors[FieldScene::LabelGreen]=RGB::Green;
+  colors[FieldScene::LabelWhite]=RGB::White;
+  double ca=cos(robot.angle);
+  double sa=sin(robot.angle);
+  for (int y=y0;y<=y1;y++) {
+    for (int x=x0;x<=x1;x++) {
+      //field offset from the robot center, rotated into the pattern frame:
+      double dx=(x-c.x)*a.x+(y-c.y)*b.x;
+      double dy=(x-c.x)*a.y+(y-c.y)*b.y;
+      if (dx*dx+dy*dy > r*r) continue;
+      double lx=ca*dx+sa*dy;
+      double ly=-sa*dx+ca*dy;
+      //the inverse of the marker locations of the pattern model, loc=(cen_y-py,cen_x-px):
+      int px=(int)floor(p->cen_x-ly+0.5);
+      int py=(int)floor(p->cen_y-lx+0.5);
+      img.setPixel(x,y,colors[p->getLabel(px,py)]);
+    }
+  }
+}
+
+void FieldSceneView::applyLighting(rgbImage & img) {
+  double gradient=scene->getGradient();
+  double noise=scene->getNoise();
+  if (gradient <= 0.0 && noise <= 0.0) return;
+  int w=img.getWidth();
+  int h=img.getHeight();
+  if ((int)gain.size()!=w*h || gradient!=gain_gradient) {
+    //a linear falloff towards the bottom right corner:
+    gain.resize(w*h);
+    for (int y=0;y<h;y++) {
+      for (int x=0;x<w;x++) {
+        double f=0.5*((double)x/max(1,w-1)+(double)y/max(1,h-1));
+        gain[y*w+x]=(int)(256.0*(1.0-gradient*0.01*f));
+      }
+    }
+    gain_gradient=gradient;
+  }
+  //approximately gaussian noise from the sum of four random bytes, whose stddev is 147.8:
+  int scale=(int)(noise/147.8*256.0);
+  rgb * px=img.getPixelData();
+  for (int i=0;i<w*h;i++) {
+    int n=0;
+    if (scale > 0) {
+      rand_state^=rand_state << 13;
+      rand_state^=rand_state >> 17;
+      rand_state^=rand_state << 5;
+      n=((int)(rand_state & 0xFF)+(int)((rand_state >> 8) & 0xFF)+(int)((rand_state >> 16) & 0xFF)+(int)(rand_state >> 24)-510)*scale >> 8;
+    }
+    int g=gain[i];
+    px[i].r=(unsigned char)bound(((int)px[i].r*g >> 8)+n,0,255);
+    px[i].g=(unsigned char)bound(((int)px[i].g*g >> 8)+n,0,255);
+    px[i].b=(unsigned char)bound(((int)px[i].b*g >> 8)+n,0,255);
+  }
+}
+
+void FieldSceneView::publishTruth(int width, int height, double time) {
+  SSL_DetectionFrame * frame=truth.mutable_detection();
+  frame->Clear();
+  frame->set_frame_number(frame_number);
+  frame->set_t_capture(time);
+  frame->set_camera_id(camera_id);
+  GVector::vector2d<double> p_i;
+  for (unsigned int i=0;i<robots.size();i++) {
+    const FieldScene::Robot & r=robots[i];
+    GVector::vector3d<double> p_f(r.x,r.y,r.height);
+    camera->field2image(p_f,p_i);
+    if (p_i.x < 0 || p_i.y < 0 || p_i.x >= width || p_i.y >= height) continue;
+    SSL_DetectionRobot * robot=(r.team==FieldScene::TeamBlue ? frame->add_robots_blue() : frame->add_robots_yellow());
+    robot->set_confidence(1.0);
+    robot->set_robot_id(r.id);
+    robot->set_x(r.x);
+    robot->set_y(r.y);
+    robot->set_orientation(r.angle);
+    robot->set_pixel_x(p_i.x);
+    robot->set_pixel_y(p_i.y);
+    robot->set_height(r.height);
+  }
+  for (unsigned int i=0;i<balls.size();i++) {
+    const FieldScene::Ball & b=balls[i];
+    //balls underneath a robot are not visible:
+    bool hidden=false;
+    for (unsigned int j=0;j<robots.size() && !hidden;j++) {
+      hidden=(sq(robots[j].x-b.x)+sq(robots[j].y-b.y) < sq(FieldScene::robot_radius+FieldScene::ball_radius));
+    }
+    if (hidden) continue;
+    GVector::vector3d<double> p_f(b.x,b.y,FieldScene::ball_radius);
+    camera->field2image(p_f,p_i);
+    if (p_i.x < 0 || p_i.y < 0 || p_i.x >= width || p_i.y >= height) continue;
+    SSL_DetectionBall * ball=frame->add_balls();
+    ball->set_confidence(1.0);
+    ball->set_x(b.x);
+    ball->set_y(b.y);
+    ball->set_pixel_x(p_i.x);
+    ball->set_pixel_y(p_i.y);
+  }
+  frame->set_t_sent(GetTimeSec());
+  scene->publish(truth);
+}
+
+void FieldSceneView::render(rgbImage & img, double time) {
+  int w=img.getWidth();
+  int h=img.getHeight();
+  computeKey(w,h,key);
+  if (key!=background_key) {
+    renderBackground(w,h);
+    background_key=key;
+  }
+  memcpy(img.getPixelData(),background.getPixelData(),w*h*sizeof(rgb));
+
+  scene->getState(time,robots,balls);
+  for (unsigned int i=0;i<balls.size();i++) {
+    drawBall(img,balls[i]);
+  }
+  scene->lockPatterns();
+  for (unsigned int i=0;i<robots.size();i++) {
+    drawRobot(img,robots[i]);
+  }
+  scene->unlockPatterns();
+  applyLighting(img);
+
+  if (scene->isPublishing()) publishTruth(w,h,time);
+  frame_number++;
+}
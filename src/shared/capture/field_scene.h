@@ -0,0 +1,214 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    field_scene.h
+  \brief   C++ Interface: FieldScene, FieldSceneView
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef FIELD_SCENE_H
+#define FIELD_SCENE_H
+
+#include <string>
+#include <vector>
+#include <QMutex>
+#include <QReadWriteLock>
+#include "VarTypes.h"
+#include "image.h"
+#include "field.h"
+#include "camera_calibration.h"
+#include "robocup_ssl_server.h"
+#include "messages_robocup_ssl_wrapper.pb.h"
+using namespace std;
+using namespace VarTypes;
+
+/*!
+  \class   FieldScene
+  \brief   A synthetic RoboCup SSL scene of moving robots and balls
+
+  The state of the scene is a pure function of time, so all cameras that
+  render the same timestamp see the same robots and balls. Robots circle
+  around the cells of a grid that covers the field, and balls bounce off
+  the field boundary. The robot tops are textured with the team's marker
+  image, as loaded by setTeam().
+
+  The scene does not render anything itself. Each camera owns a
+  FieldSceneView, which caches the parts that only depend on its
+  calibration.
+*/
+class FieldScene {
+public:
+  enum TeamColor {
+    TeamBlue=0,
+    TeamYellow=1
+  };
+  struct Robot {
+    int team;
+    int id;
+    double x;
+    double y;
+    double angle;
+    double height;
+  };
+  struct Ball {
+    double x;
+    double y;
+  };
+  ///the color labels of a marker image cell
+  enum PatternLabel {
+    LabelBlack=0,
+    LabelCenter,
+    LabelPink,
+    LabelCyan,
+    LabelGreen,
+    LabelWhite
+  };
+  /*!
+    \class Pattern
+    \brief one robot of a marker image, labeled by the nearest marker color
+  */
+  class Pattern {
+  public:
+    int width;
+    int height;
+    vector<unsigned char> labels;
+    double cen_x; //centroid of the team marker, in cell pixels
+    double cen_y;
+    double robot_height;
+    Pattern() {
+      width=height=0;
+      cen_x=cen_y=0.0;
+      robot_height=0.0;
+    }
+    unsigned char getLabel(int x, int y) const {
+      if (x < 0 || y < 0 || x >= width || y >= height) return LabelBlack;
+      return labels[y*width+x];
+    }
+  };
+  static const double robot_radius;
+  static const double ball_radius;
+
+protected:
+  RoboCupField * field;
+  double t0;
+
+  mutable QReadWriteLock patterns_lock; //held by renderers while reading the patterns
+  vector<Pattern> patterns[2];
+
+  QMutex server_mutex;
+  RoboCupSSLServer * server;
+  int server_port;
+  string server_address;
+  string server_interface;
+
+  VarList * settings;
+  VarInt * v_robots;
+  VarInt * v_balls;
+  VarDouble * v_robot_speed;
+  VarDouble * v_ball_speed;
+  VarInt * v_seed;
+  VarDouble * v_noise;
+  VarDouble * v_gradient;
+  VarList * ground_truth;
+  VarBool * v_publish;
+  VarString * v_address;
+  VarInt * v_port;
+  VarString * v_interface;
+
+  static bool loadPattern(const rgbImage & img, int x0, int y0, int w, int h, double default_height, bool use_image_height, Pattern & p);
+
+public:
+  FieldScene(RoboCupField * _field);
+  ~FieldScene();
+  VarList * getSettings();
+
+  /// loads the marker image of a team. An empty file name removes the team.
+  bool setTeam(TeamColor team, const string & image_file, int rows, int cols,
+               double default_height, bool use_image_heights, const vector<bool> & valid);
+
+  /// the state of the scene at \p time (in GetTimeSec() seconds)
+  void getState(double time, vector<Robot> & robots, vector<Ball> & balls) const;
+  /// the time at which the scene starts moving, the time of construction by default.
+  /// Offline tools set it to 0 to render the same frames on every run.
+  void setTimeOrigin(double t);
+
+  bool isPublishing() const;
+  double getNoise() const;
+  double getGradient() const;
+  RoboCupField * getField() const;
+
+  /// a read-lock on the patterns, for the duration of a render
+  void lockPatterns();
+  void unlockPatterns();
+  /// the pattern of a robot, only valid while the patterns are locked
+  const Pattern * getPattern(int team, int id) const;
+
+  /// sends the ground truth of a camera if publishing is enabled
+  void publish(const SSL_WrapperPacket & packet);
+};
+
+/*!
+  \class   FieldSceneView
+  \brief   Renders a FieldScene through the calibration of one camera
+
+  The background (field and lines) is rendered once per calibration and
+  image size by unprojecting every pixel. Per frame, the background is
+  copied, then balls and robots are drawn at their heights through the
+  camera model linearized at their centers, which is exact at the center
+  and close to it across the 180mm of a robot. The result is in the draw
+  colors of the RoboCup color labels, so a LUT computed from the labels
+  segments it.
+
+  Every rendered frame publishes the robots and balls that are visible in
+  this camera as an SSL_WrapperPacket, whose t_capture is the time of the
+  frame. This is the key to match it with the detection of that frame.
+
+  A view is used by one capture thread only.
+*/
+class FieldSceneView {
+protected:
+  FieldScene * scene;
+  const CameraParameters * camera;
+  int camera_id;
+  unsigned int frame_number;
+  unsigned int rand_state;
+
+  rgbImage background;
+  vector<double> background_key;
+  vector<double> key;
+  vector<int> gain; //lighting gradient, 8.8 fixed point
+  double gain_gradient;
+
+  vector<FieldScene::Robot> robots;
+  vector<FieldScene::Ball> balls;
+  SSL_WrapperPacket truth;
+
+  void computeKey(int width, int height, vector<double> & result) const;
+  rgb fieldColor(double x, double y) const;
+  void renderBackground(int width, int height);
+  void drawBall(rgbImage & img, const FieldScene::Ball & ball);
+  void drawRobot(rgbImage & img, const FieldScene::Robot & robot);
+  void applyLighting(rgbImage & img);
+  void publishTruth(int width, int height, double time);
+
+public:
+  FieldSceneView(FieldScene * _scene, const CameraParameters * _camera, int _camera_id);
+  ~FieldSceneView();
+
+  /// renders the scene at \p time into \p img and publishes its ground truth
+  void render(rgbImage & img, double time);
+};
+
+#endif
@@ -76,6 +76,18 @@ void Pattern::setEnabled(bool val) {
   enabled=val;
 }
 
+int Pattern::getNumMarkers() const {
+  return num_markers;
+}
+
+const Marker & Pattern::getMarker(int idx) const {
+  return markers[idx];
+}
+
+float Pattern::getHeight() const {
+  return height;
+}
+
 void Pattern::allocate(int num) {
   if (num_markers!=num) {
     if (markers!=0) {
@@ -141,7 +153,7 @@ bool MultiPatternModel::usesColor(raw8 color_id) const {
   return used.isUsed(color_id.v);
 }
 
-bool MultiPatternModel::loadMultiPatternImage(const yuvImage & multi_image, YUVLUT * _lut, int rows, int cols, float default_object_height)
+bool MultiPatternModel::loadMultiPatternImage(const yuvImage & multi_image, LUT3DTable * _lut, int rows, int cols, float default_object_height)
 {
   yuvImage single_image;
   if (multi_image.getWidth()==0 || multi_image.getHeight()==0) {
@@ -194,7 +206,7 @@ void MultiPatternModel::clearPatternModels() {
 }
 
 
-bool MultiPatternModel::loadSinglePatternImage(const yuvImage & image, YUVLUT * _lut,int idx, float default_object_height) {
+bool MultiPatternModel::loadSinglePatternImage(const yuvImage & image, LUT3DTable * _lut,int idx, float default_object_height) {
 
   if (_lut==0) return false;
   int color_team_id=_lut->getChannelID("Blue");
@@ -384,7 +396,7 @@ void MultiPatternModel::recheckColorsUsed() {
   }
 }
 
-bool MultiPatternModel::findPattern(PatternDetectionResult & result, Marker * markers,int num_markers, const PatternFitParameters & fit_params,const CameraParameters& camera_params) const {
+bool MultiPatternModel::findPattern(PatternDetectionResult & result, Marker * markers,int num_markers, const PatternFitParameters & fit_params,const CameraModel& camera) const {
   if(markers==0 || num_markers<0) return(false);
 
   int best_idx = -1;
@@ -429,7 +441,7 @@ bool MultiPatternModel::findPattern(PatternDetectionResult & result, Marker * ma
     for(int i=0; i<num_markers; i++){
       vector2d marker_img_center(markers[i].reg->cen_x,markers[i].reg->cen_y);
       vector3d marker_center3d;
-      camera_params.image2field(marker_center3d,marker_img_center,markers[i].height);
+      camera.image2field(marker_center3d,marker_img_center,markers[i].height);
       markers[i].loc.set(marker_center3d.x,marker_center3d.y);
     }
 
@@ -22,12 +22,12 @@
 #ifndef CM_PATTERN_PATTERN_H
 #define CM_PATTERN_PATTERN_H
 #include "image.h"
-#include "lut3d.h"
+#include "lut3d_table.h"
 #include <algorithm>
 #include "cmvision_region.h"
 #include "util.h"
 #include "vis_util.h"
-#include "camera_calibration.h"
+#include "camera_model.h"
 namespace CMPattern {
 
 /**
@@ -89,6 +89,9 @@ protected:
 public:
   void setEnabled(bool val);
   void copyMarkers(const vector<Marker> & mv);
+  int getNumMarkers() const;
+  const Marker & getMarker(int idx) const;
+  float getHeight() const;
   void reset();
     Pattern();
 
@@ -188,9 +191,9 @@ public:
   int getNumPatterns();
   void clearPatternModels();
   bool usesColor(raw8 color_id) const;
-  bool loadSinglePatternImage(const yuvImage & image, YUVLUT * _lut,int idx, float default_object_height=0.0);
-  bool loadMultiPatternImage(const yuvImage & image, YUVLUT * _lut, int rows=4, int cols=4, float default_object_height=0.0);
-  bool findPattern(PatternDetectionResult & result, Marker * markers,int num_markers, const PatternFitParameters & fit_params,const CameraParameters& camera_params) const;
+  bool loadSinglePatternImage(const yuvImage & image, LUT3DTable * _lut,int idx, float default_object_height=0.0);
+  bool loadMultiPatternImage(const yuvImage & image, LUT3DTable * _lut, int rows=4, int cols=4, float default_object_height=0.0);
+  bool findPattern(PatternDetectionResult & result, Marker * markers,int num_markers, const PatternFitParameters & fit_params,const CameraModel& camera) const;
   void recheckColorsUsed();//to be used if patterns have been enabled/disabled;
 };
 
@@ -19,6 +19,7 @@
 */
 //========================================================================
 #include "cmpattern_team.h"
+#include "lut3d.h"
 
 namespace CMPattern {
 
@@ -36,12 +37,14 @@ void Team::slotChangeOccured(VarType * item) {
 
 Team::Team(VarList * team_root)
 {
+    //the defaults of the settings are kept in TeamSettings:
+    TeamSettings d;
     _settings=team_root;
     _team_name = _settings->findChildOrReplace(new VarString("Team Name", team_root->getName()));
     connect(_team_name,SIGNAL(hasChanged(VarType *)),this,SLOT(slotTeamNameChanged()));
-    _unique_patterns = _settings->findChildOrReplace(new VarBool("Unique Patterns"));
-    _have_angle = _settings->findChildOrReplace(new VarBool("Have Angles"));
-    _robot_height = _settings->findChildOrReplace(new VarDouble("Robot Height (mm)", 140.0));
+    _unique_patterns = _settings->findChildOrReplace(new VarBool("Unique Patterns",d.unique_patterns));
+    _have_angle = _settings->findChildOrReplace(new VarBool("Have Angles",d.have_angle));
+    _robot_height = _settings->findChildOrReplace(new VarDouble("Robot Height (mm)", d.robot_height));
     _use_marker_image_heights = _settings->findChildOrReplace(new VarBool("Use Heights from Marker Image", true));
 
     _marker_image = _settings->findChildOrReplace(new VarList("Marker Image"));
@@ -53,44 +56,44 @@ Team::Team(VarList * team_root)
       _valid_patterns->addFlags(VARTYPE_FLAG_PERSISTENT);
 
     _center_marker_filter = _settings->findChildOrReplace(new VarList("Center Marker Settings"));
-      _center_marker_area_mean = _center_marker_filter->findChildOrReplace(new VarDouble("Expected Area Mean (sq-mm)",sq(50.0)));
-      _center_marker_area_stddev = _center_marker_filter->findChildOrReplace(new VarDouble("Expected StdDev (sq-mm)",sq(30.0)));
-      _center_marker_uniform = _center_marker_filter->findChildOrReplace(new VarDouble("Uniform",0.05));
-      _center_marker_min_width = _center_marker_filter->findChildOrReplace(new VarInt("Min Width (pixels)",4));
-      _center_marker_max_width = _center_marker_filter->findChildOrReplace(new VarInt("Max Width (pixels)",30));
-      _center_marker_min_height = _center_marker_filter->findChildOrReplace(new VarInt("Min Height (pixels)",4));
-      _center_marker_max_height = _center_marker_filter->findChildOrReplace(new VarInt("Max Height (pixels)",30));
-      _center_marker_min_area = _center_marker_filter->findChildOrReplace(new VarInt("Min Area (sq-pixels)",15));
-      _center_marker_max_area = _center_marker_filter->findChildOrReplace(new VarInt("Max Area (sq-pixels)",400));
-      _center_marker_duplicate_distance = _center_marker_filter->findChildOrReplace(new VarInt("Duplicate Merge Distance (mm)",135));
+      _center_marker_area_mean = _center_marker_filter->findChildOrReplace(new VarDouble("Expected Area Mean (sq-mm)",d.center_marker_area_mean));
+      _center_marker_area_stddev = _center_marker_filter->findChildOrReplace(new VarDouble("Expected StdDev (sq-mm)",d.center_marker_area_stddev));
+      _center_marker_uniform = _center_marker_filter->findChildOrReplace(new VarDouble("Uniform",d.center_marker_uniform));
+      _center_marker_min_width = _center_marker_filter->findChildOrReplace(new VarInt("Min Width (pixels)",d.center_marker_min_width));
+      _center_marker_max_width = _center_marker_filter->findChildOrReplace(new VarInt("Max Width (pixels)",d.center_marker_max_width));
+      _center_marker_min_height = _center_marker_filter->findChildOrReplace(new VarInt("Min Height (pixels)",d.center_marker_min_height));
+      _center_marker_max_height = _center_marker_filter->findChildOrReplace(new VarInt("Max Height (pixels)",d.center_marker_max_height));
+      _center_marker_min_area = _center_marker_filter->findChildOrReplace(new VarInt("Min Area (sq-pixels)",d.center_marker_min_area));
+      _center_marker_max_area = _center_marker_filter->findChildOrReplace(new VarInt("Max Area (sq-pixels)",d.center_marker_max_area));
+      _center_marker_duplicate_distance = _center_marker_filter->findChildOrReplace(new VarInt("Duplicate Merge Distance (mm)",(int)d.center_marker_duplicate_distance));
 
     _other_markers_filter = _settings->findChildOrReplace(new VarList("Other Markers Settings"));
-      _other_markers_min_width = _other_markers_filter->findChildOrReplace(new VarInt("Min Width (pixels)",4));
-      _other_markers_max_width = _other_markers_filter->findChildOrReplace(new VarInt("Max Width (pixels)",40));
-      _other_markers_min_height = _other_markers_filter->findChildOrReplace(new VarInt("Min Height (pixels)",4));
-      _other_markers_max_height = _other_markers_filter->findChildOrReplace(new VarInt("Max Height (pixels)",40));
-      _other_markers_min_area = _other_markers_filter->findChildOrReplace(new VarInt("Min Area (sq-pixels)",15));
-      _other_markers_max_area = _other_markers_filter->findChildOrReplace(new VarInt("Max Area (sq-pixels)",600));
+      _other_markers_min_width = _other_markers_filter->findChildOrReplace(new VarInt("Min Width (pixels)",d.other_markers_min_width));
+      _other_markers_max_width = _other_markers_filter->findChildOrReplace(new VarInt("Max Width (pixels)",d.other_markers_max_width));
+      _other_markers_min_height = _other_markers_filter->findChildOrReplace(new VarInt("Min Height (pixels)",d.other_markers_min_height));
+      _other_markers_max_height = _other_markers_filter->findChildOrReplace(new VarInt("Max Height (pixels)",d.other_markers_max_height));
+      _other_markers_min_area = _other_markers_filter->findChildOrReplace(new VarInt("Min Area (sq-pixels)",d.other_markers_min_area));
+      _other_markers_max_area = _other_markers_filter->findChildOrReplace(new VarInt("Max Area (sq-pixels)",d.other_markers_max_area));
 
     _histogram_settings = _settings->findChildOrReplace(new VarList("Histogram Settings"));
-      _histogram_enable = _histogram_settings->findChildOrReplace(new VarBool("Enable",true));
-      _histogram_pixel_scan_radius = _histogram_settings->findChildOrReplace(new VarInt("Scan Radius (pixels)",16));
-      _histogram_min_markeryness = _histogram_settings->findChildOrReplace(new VarDouble("Min Markeryness",0.3));
-      _histogram_max_markeryness = _histogram_settings->findChildOrReplace(new VarDouble("Max Markeryness",12.0));
-      _histogram_min_field_greenness = _histogram_settings->findChildOrReplace(new VarDouble("Min Field-Greenness",0.0,0.0,1.0));
-      _histogram_max_field_greenness = _histogram_settings->findChildOrReplace(new VarDouble("Max Field-Greenness",1.0,0.0,1.0));
-      _histogram_min_black_whiteness = _histogram_settings->findChildOrReplace(new VarDouble("Min Black/Whiteness",0.0,0.0,1.0));
-      _histogram_max_black_whiteness = _histogram_settings->findChildOrReplace(new VarDouble("Max Black/Whiteness",1.0,0.0,1.0));
+      _histogram_enable = _histogram_settings->findChildOrReplace(new VarBool("Enable",d.histogram_enable));
+      _histogram_pixel_scan_radius = _histogram_settings->findChildOrReplace(new VarInt("Scan Radius (pixels)",d.histogram_pixel_scan_radius));
+      _histogram_min_markeryness = _histogram_settings->findChildOrReplace(new VarDouble("Min Markeryness",d.histogram_min_markeryness));
+      _histogram_max_markeryness = _histogram_settings->findChildOrReplace(new VarDouble("Max Markeryness",d.histogram_max_markeryness));
+      _histogram_min_field_greenness = _histogram_settings->findChildOrReplace(new VarDouble("Min Field-Greenness",d.histogram_min_field_greenness,0.0,1.0));
+      _histogram_max_field_greenness = _histogram_settings->findChildOrReplace(new VarDouble("Max Field-Greenness",d.histogram_max_field_greenness,0.0,1.0));
+      _histogram_min_black_whiteness = _histogram_settings->findChildOrReplace(new VarDouble("Min Black/Whiteness",d.histogram_min_black_whiteness,0.0,1.0));
+      _histogram_max_black_whiteness = _histogram_settings->findChildOrReplace(new VarDouble("Max Black/Whiteness",d.histogram_max_black_whiteness,0.0,1.0));
 
     _pattern_fitness = _settings->findChildOrReplace(new VarList("Pattern Fitting"));
-      _pattern_max_dist = _pattern_fitness->findChildOrReplace(new VarDouble("Max Marker Center Dist (mm)",100));
-      _pattern_fitness_weight_area = _pattern_fitness->findChildOrReplace(new VarDouble("Weight Area",0.1));
-      _pattern_fitness_weight_center_distance = _pattern_fitness->findChildOrReplace(new VarDouble("Weight Center-Dist",0.2));
-      _pattern_fitness_weight_next_distance = _pattern_fitness->findChildOrReplace(new VarDouble("Weight Next-Dist",1.0));
-      _pattern_fitness_weight_next_angle_distance = _pattern_fitness->findChildOrReplace(new VarDouble("Weight Next-Angle-Dist",0.5));
-      _pattern_fitness_max_error = _pattern_fitness->findChildOrReplace(new VarDouble("Max Error",1.0));
-      _pattern_fitness_stddev = _pattern_fitness->findChildOrReplace(new VarDouble("Expected StdDev",0.5));
-      _pattern_fitness_uniform = _pattern_fitness->findChildOrReplace(new VarDouble("Uniform",0.05));
+      _pattern_max_dist = _pattern_fitness->findChildOrReplace(new VarDouble("Max Marker Center Dist (mm)",d.pattern_max_dist));
+      _pattern_fitness_weight_area = _pattern_fitness->findChildOrReplace(new VarDouble("Weight Area",d.pattern_fitness_weight_area));
+      _pattern_fitness_weight_center_distance = _pattern_fitness->findChildOrReplace(new VarDouble("Weight Center-Dist",d.pattern_fitness_weight_center_distance));
+      _pattern_fitness_weight_next_distance = _pattern_fitness->findChildOrReplace(new VarDouble("Weight Next-Dist",d.pattern_fitness_weight_next_distance));
+      _pattern_fitness_weight_next_angle_distance = _pattern_fitness->findChildOrReplace(new VarDouble("Weight Next-Angle-Dist",d.pattern_fitness_weight_next_angle_distance));
+      _pattern_fitness_max_error = _pattern_fitness->findChildOrReplace(new VarDouble("Max Error",d.pattern_fitness_max_error));
+      _pattern_fitness_stddev = _pattern_fitness->findChildOrReplace(new VarDouble("Expected StdDev",d.pattern_fitness_stddev));
+      _pattern_fitness_uniform = _pattern_fitness->findChildOrReplace(new VarDouble("Uniform",d.pattern_fitness_uniform));
 
   _notifier.addRecursive(_settings);
   connect(&_notifier,SIGNAL(changeOccured(VarType*)),this,SLOT(slotChangeOccured(VarType *)));
@@ -101,5 +104,135 @@ Team::~Team()
 {
 }
 
+bool Team::getLoadMarkersFromImageFile() const {
+  return _load_markers_from_image_file->getBool();
+}
+
+string Team::getMarkerImageFile() const {
+  return _marker_image_file->getString();
+}
+
+int Team::getMarkerImageRows() const {
+  return _marker_image_rows->getInt();
+}
+
+int Team::getMarkerImageCols() const {
+  return _marker_image_cols->getInt();
+}
+
+double Team::getRobotHeight() const {
+  return _robot_height->getDouble();
+}
+
+bool Team::getUseMarkerImageHeights() const {
+  return _use_marker_image_heights->getBool();
+}
+
+bool Team::isPatternValid(int idx) const {
+  return (idx >= 0 && _valid_patterns->isSelected(idx));
+}
+
+void Team::compile(TeamSettings & s) const {
+  s.unique_patterns=_unique_patterns->getBool();
+  s.have_angle=_have_angle->getBool();
+  s.robot_height=_robot_height->getDouble();
+
+  s.center_marker_area_mean=_center_marker_area_mean->getDouble();
+  s.center_marker_area_stddev=_center_marker_area_stddev->getDouble();
+  s.center_marker_uniform=_center_marker_uniform->getDouble();
+  s.center_marker_min_width=_center_marker_min_width->getInt();
+  s.center_marker_max_width=_center_marker_max_width->getInt();
+  s.center_marker_min_height=_center_marker_min_height->getInt();
+  s.center_marker_max_height=_center_marker_max_height->getInt();
+  s.center_marker_min_area=_center_marker_min_area->getInt();
+  s.center_marker_max_area=_center_marker_max_area->getInt();
+  s.center_marker_duplicate_distance=_center_marker_duplicate_distance->getDouble();
+
+  s.other_markers_min_width=_other_markers_min_width->getInt();
+  s.other_markers_max_width=_other_markers_max_width->getInt();
+  s.other_markers_min_height=_other_markers_min_height->getInt();
+  s.other_markers_max_height=_other_markers_max_height->getInt();
+  s.other_markers_min_area=_other_markers_min_area->getInt();
+  s.other_markers_max_area=_other_markers_max_area->getInt();
+
+  s.histogram_enable=_histogram_enable->getBool();
+  s.histogram_pixel_scan_radius=_histogram_pixel_scan_radius->getInt();
+  s.histogram_min_markeryness=_histogram_min_markeryness->getDouble();
+  s.histogram_max_markeryness=_histogram_max_markeryness->getDouble();
+  s.histogram_min_field_greenness=_histogram_min_field_greenness->getDouble();
+  s.histogram_max_field_greenness=_histogram_max_field_greenness->getDouble();
+  s.histogram_min_black_whiteness=_histogram_min_black_whiteness->getDouble();
+  s.histogram_max_black_whiteness=_histogram_max_black_whiteness->getDouble();
+
+  s.pattern_max_dist=_pattern_max_dist->getDouble();
+  s.pattern_fitness_weight_area=_pattern_fitness_weight_area->getDouble();
+  s.pattern_fitness_weight_center_distance=_pattern_fitness_weight_center_distance->getDouble();
+  s.pattern_fitness_weight_next_distance=_pattern_fitness_weight_next_distance->getDouble();
+  s.pattern_fitness_weight_next_angle_distance=_pattern_fitness_weight_next_angle_distance->getDouble();
+  s.pattern_fitness_max_error=_pattern_fitness_max_error->getDouble();
+  s.pattern_fitness_stddev=_pattern_fitness_stddev->getDouble();
+  s.pattern_fitness_uniform=_pattern_fitness_uniform->getDouble();
+}
+
+void Team::loadPatterns(MultiPatternModel & model, const LUT3DTable & lut) const {
+  string marker_image_file=_marker_image_file->getString();
+  if (_load_markers_from_image_file->getBool() == true && marker_image_file.length() > 0) {
+    rgbImage rgbi;
+    if (rgbi.load(marker_image_file)) {
+      //create a YUV lut that's based on color-labels not on custom data:
+      YUVLUT minilut(4,4,4,"");
+      minilut.copyChannels(lut);
+      //compute a full LUT mapping based on NN-distance to color labels:
+      minilut.computeLUTfromLabels();
+      yuvImage yuvi;
+      yuvi.allocate(rgbi.getWidth(),rgbi.getHeight());
+      Images::convert(rgbi,yuvi);
+      printf("Loading Team Image %s\n",marker_image_file.c_str());
+      if (model.loadMultiPatternImage(yuvi,&minilut,_marker_image_rows->getInt(),_marker_image_cols->getInt(),_robot_height->getDouble())==false) {
+          fprintf(stderr,"Errors while processing team image file: '%s'.\n",marker_image_file.c_str());
+          fflush(stderr);
+      }
+    } else {
+          fprintf(stderr,"Error loading team image file: '%s'.\n",marker_image_file.c_str());
+          fflush(stderr);
+    }
+    for (int i=0;i<model.getNumPatterns();i++) {
+      model.getPattern(i).setEnabled(_valid_patterns->isSelected(i));
+    }
+    model.recheckColorsUsed();
+  }
+}
+
+TeamDetectorSettings::TeamDetectorSettings(string external_file) {
+ settings=new VarList("Team Config");
+ if (external_file.length()==0) {
+    settings->addChild(teams = new VarList("Teams"));; // a global variable, defining all teams
+ } else {
+    settings->addChild(teams = new VarExternal(external_file,"Teams"));; // a global variable, defining all teams
+ }
+ connect(teams,SIGNAL(childAdded(VarType *)),this,SLOT(slotTeamNodeAdded(VarType *)));
+ settings->addChild(addTeam = new VarTrigger("Add", "Add Team..."));
+ connect(addTeam,SIGNAL(signalTriggered()),this,SLOT(slotAddPressed()));
+ 
+}
+
+void TeamDetectorSettings::slotTeamNodeAdded(VarType * node) {
+  team_vector.push_back(new Team((VarList *)node));
+  connect(team_vector[team_vector.size()-1],SIGNAL(signalTeamNameChanged()),this,SIGNAL(teamInfoChanged()));
+  emit(teamInfoChanged());
+}
+
+void TeamDetectorSettings::slotAddPressed() {
+  teams->addChild(new VarList("New Team " + QString::number(teams->getChildrenCount()).toStdString()));
+}
+
+vector<Team *> TeamDetectorSettings::getTeams() const {
+  return team_vector;
+}
+
+Team * TeamDetectorSettings::getTeam(int idx) const {
+  if (idx < 0 || idx >= (int)team_vector.size()) return 0;
+  return (team_vector[idx]);
+}
 
 }
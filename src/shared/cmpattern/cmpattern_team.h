@@ -24,6 +24,8 @@
 #include "VarTypes.h"
 #include "geometry.h"
 #include "VarNotifier.h"
+#include "lut3d_table.h"
+#include "cmpattern_teamdetector.h"
 using namespace VarTypes;
 namespace CMPattern {
 
@@ -31,13 +33,11 @@ namespace CMPattern {
 	@author Author Name
 */
 class TeamSelector;
-class TeamDetector;
 
 class Team : public QObject {
 Q_OBJECT
 
 friend class TeamSelector;
-friend class TeamDetector;
 signals:
    void signalTeamNameChanged();
 signals:
@@ -105,7 +105,125 @@ public:
 
     ~Team();
 
+    //read-only access to the marker image, e.g. for rendering the patterns:
+    bool getLoadMarkersFromImageFile() const;
+    string getMarkerImageFile() const;
+    int getMarkerImageRows() const;
+    int getMarkerImageCols() const;
+    double getRobotHeight() const;
+    bool getUseMarkerImageHeights() const;
+    bool isPatternValid(int idx) const;
+
+    /// a plain copy of the detection settings, see TeamDetector::init()
+    void compile(TeamSettings & s) const;
+
+    /// load the patterns of the marker image into \p model, with the color
+    /// labels of \p lut, if the marker image is enabled
+    void loadPatterns(MultiPatternModel & model, const LUT3DTable & lut) const;
+
+};
+
+class TeamDetectorSettings : public QObject {
+Q_OBJECT
+ friend class TeamSelector;
+ protected:
+ VarList * settings;
+ VarList * teams; // a global variable, defining all teams
+ VarTrigger * addTeam;
+ vector<Team *> team_vector;
+signals:
+  void teamInfoChanged();
+ protected slots:
+   void slotTeamNodeAdded(VarType * node);
+   void slotAddPressed();
+ public:
+ vector<Team *> getTeams() const;
+ Team * getTeam(int idx) const;
+ TeamDetectorSettings(string external_file="");
+ VarList * getSettings() {
+   return settings;
+ }
+ //TODO: add notifier factory.
+
+};
+
+
+class TeamSelector : public QObject {
+Q_OBJECT
+signals:
+  void signalTeamDataChanged();
+protected:
+  TeamDetectorSettings * _detector_settings;
+  VarList * _settings;
+  VarStringEnum * _selector;
+  VarInt * _num_robots;
+  Team * current_team;
+  void update() {
+    vector<Team *> teams = _detector_settings->getTeams();
+    _selector->setSize(teams.size(), "");
+    int old_select_index = _selector->getIndex();
+    for (unsigned int i=0;i<teams.size();i++) {
+      _selector->setLabel(i,teams[i]-> _team_name->getString());
+    }
+    Team * new_team=0;
+    if (teams.size() > 0) {
+      if (old_select_index >= 0 && old_select_index < (int)teams.size()) {
+         _selector->selectIndex(old_select_index);
+      } else {
+         _selector->selectIndex(0);
+      }
+      new_team=_detector_settings->getTeam(_selector->getIndex());
+    } else {
+      new_team=0;
+    }
+    if (new_team!=current_team) {
+      if (current_team!=0) {
+        disconnect(current_team,SIGNAL(signalChangeOccured(VarType*)),this,SLOT(slotTeamDataChanged()));
+      }
+      if (new_team!=0) {
+        connect(new_team,SIGNAL(signalChangeOccured(VarType*)),this,SLOT(slotTeamDataChanged()));
+      }
+      current_team=new_team;
+    }
+    emit(signalTeamDataChanged());
+  }
+protected slots:
+  void slotTeamInfoChanged() {
+    update();
+  }
+  void slotTeamDataChanged() {
+    emit(signalTeamDataChanged());
+  }
+public:
+  TeamSelector(string label, TeamDetectorSettings * detector_settings) {
+    _detector_settings=detector_settings;
+    connect(_detector_settings,SIGNAL(teamInfoChanged()),this,SLOT(slotTeamInfoChanged()));
+    current_team=0;
+    _settings= new VarList(label);
+    _settings->addChild(_selector = new VarStringEnum("Team",""));
+    _selector->addFlags(VARTYPE_FLAG_NOLOAD_ENUM_CHILDREN);
+    _settings->addChild(_num_robots = new VarInt("Max Robots",6));
+    update();
+  }
+  VarList * getSettings() {
+    return _settings;
+  }
+  Team * getSelectedTeam() {
+    if (_selector->getIndex() == -1) {
+      update();
+    } else if (current_team!=_detector_settings->getTeam(_selector->getIndex())) {
+      update();
+    }
+    return current_team;
+  }
+  int getNumberRobots() {
+    return _num_robots->getInt();
+  }
+  ~TeamSelector() {
+    delete _settings;
+  }
 };
 
+
 }
 #endif
@@ -23,40 +23,50 @@
 
 namespace CMPattern {
 
-TeamDetectorSettings::TeamDetectorSettings(string external_file) {
- settings=new VarList("Team Config");
- if (external_file.length()==0) {
-    settings->addChild(teams = new VarList("Teams"));; // a global variable, defining all teams
- } else {
-    settings->addChild(teams = new VarExternal(external_file,"Teams"));; // a global variable, defining all teams
- }
- connect(teams,SIGNAL(childAdded(VarType *)),this,SLOT(slotTeamNodeAdded(VarType *)));
- settings->addChild(addTeam = new VarTrigger("Add", "Add Team..."));
- connect(addTeam,SIGNAL(signalTriggered()),this,SLOT(slotAddPressed()));
- 
+TeamSettings::TeamSettings() {
+  unique_patterns=false;
+  have_angle=false;
+  robot_height=140.0;
+
+  center_marker_area_mean=sq(50.0);
+  center_marker_area_stddev=sq(30.0);
+  center_marker_uniform=0.05;
+  center_marker_min_width=4;
+  center_marker_max_width=30;
+  center_marker_min_height=4;
+  center_marker_max_height=30;
+  center_marker_min_area=15;
+  center_marker_max_area=400;
+  center_marker_duplicate_distance=135;
+
+  other_markers_min_width=4;
+  other_markers_max_width=40;
+  other_markers_min_height=4;
+  other_markers_max_height=40;
+  other_markers_min_area=15;
+  other_markers_max_area=600;
+
+  histogram_enable=true;
+  histogram_pixel_scan_radius=16;
+  histogram_min_markeryness=0.3;
+  histogram_max_markeryness=12.0;
+  histogram_min_field_greenness=0.0;
+  histogram_max_field_greenness=1.0;
+  histogram_min_black_whiteness=0.0;
+  histogram_max_black_whiteness=1.0;
+
+  pattern_max_dist=100;
+  pattern_fitness_weight_area=0.1;
+  pattern_fitness_weight_center_distance=0.2;
+  pattern_fitness_weight_next_distance=1.0;
+  pattern_fitness_weight_next_angle_distance=0.5;
+  pattern_fitness_max_error=1.0;
+  pattern_fitness_stddev=0.5;
+  pattern_fitness_uniform=0.05;
 }
 
-void TeamDetectorSettings::slotTeamNodeAdded(VarType * node) {
-  team_vector.push_back(new Team((VarList *)node));
-  connect(team_vector[team_vector.size()-1],SIGNAL(signalTeamNameChanged()),this,SIGNAL(teamInfoChanged()));
-  emit(teamInfoChanged());
-}
-
-void TeamDetectorSettings::slotAddPressed() {
-  teams->addChild(new VarList("New Team " + QString::number(teams->getChildrenCount()).toStdString()));
-}
-
-vector<Team *> TeamDetectorSettings::getTeams() const {
-  return team_vector;
-}
-
-Team * TeamDetectorSettings::getTeam(int idx) const {
-  if (idx < 0 || idx >= (int)team_vector.size()) return 0;
-  return (team_vector[idx]);
-}
-
-TeamDetector::TeamDetector(LUT3D * lut3d, const CameraParameters& camera_params, const RoboCupField& field) : _camera_params(camera_params), _field(field) {
-  _team=0;
+TeamDetector::TeamDetector(LUT3DTable * lut3d) {
+  _camera=0;
   _lut3d=lut3d;
 
   histogram=0;
@@ -85,85 +95,48 @@ TeamDetector::TeamDetector(LUT3D * lut3d, const CameraParameters& camera_params,
   if (color_id_field_green == -1) printf("WARNING color label 'Field Green' not defined in LUT!!!\n");
 }
 
-void TeamDetector::init(Team * team)
+void TeamDetector::init(const TeamSettings & settings, const FieldFilter & field)
 {
-  _team=team;
-
   if (histogram==0) histogram= new CMVision::Histogram(_lut3d->getChannelCount());
 
   //--------------THINGS THAT MIGHT CHANGE DURING RUNTIME BELOW:------------
   //update field:
-  field_filter.update(_field);
+  field_filter=field;
 
   //read config:
-  _unique_patterns=_team->_unique_patterns->getBool();
-  _have_angle=_team->_have_angle->getBool();
-  _load_markers_from_image_file=_team->_load_markers_from_image_file->getBool();
-  _marker_image_file=_team->_marker_image_file->getString();
-  _marker_image_rows=_team->_marker_image_rows->getInt();
-  _marker_image_cols=_team->_marker_image_cols->getInt();
-  _robot_height=_team->_robot_height->getDouble();
-
-  _center_marker_area_mean=_team->_center_marker_area_mean->getDouble();
-  _center_marker_area_stddev=_team->_center_marker_area_stddev->getDouble();
-  _center_marker_uniform=_team->_center_marker_uniform->getDouble();
-  _center_marker_duplicate_distance=_team->_center_marker_duplicate_distance->getDouble();
-
-  filter_team.setWidth(_team->_center_marker_min_width->getInt(),team->_center_marker_max_width->getInt());
-  filter_team.setHeight(_team->_center_marker_min_height->getInt(),team->_center_marker_max_height->getInt());
-  filter_team.setArea(_team->_center_marker_min_area->getInt(),team->_center_marker_max_area->getInt());
-
-  filter_others.setWidth(_team->_other_markers_min_width->getInt(),team->_other_markers_max_width->getInt());
-  filter_others.setHeight(_team->_other_markers_min_height->getInt(),team->_other_markers_max_height->getInt());
-  filter_others.setArea(_team->_other_markers_min_area->getInt(),team->_other_markers_max_area->getInt());
-
-  _histogram_enable=_team->_histogram_enable->getBool();
-  _histogram_pixel_scan_radius=_team->_histogram_pixel_scan_radius->getInt();
-
-  _histogram_markeryness.set(_team->_histogram_min_markeryness->getDouble(),_team->_histogram_max_markeryness->getDouble());
-  _histogram_field_greenness.set(_team->_histogram_min_field_greenness->getDouble(),_team->_histogram_max_field_greenness->getDouble());
-  _histogram_black_whiteness.set(_team->_histogram_min_black_whiteness->getDouble(),_team->_histogram_max_black_whiteness->getDouble());
-
-
-  _pattern_max_dist=_team->_pattern_max_dist->getDouble();
-  _pattern_fit_params.fit_area_weight=_team->_pattern_fitness_weight_area->getDouble();
-  _pattern_fit_params.fit_cen_dist_weight=_team->_pattern_fitness_weight_center_distance->getDouble();
-  _pattern_fit_params.fit_next_dist_weight=_team->_pattern_fitness_weight_next_distance->getDouble();
-  _pattern_fit_params.fit_next_dist_weight=_team->_pattern_fitness_weight_next_angle_distance->getDouble();
-  _pattern_fit_params.fit_max_error=_team->_pattern_fitness_max_error->getDouble();
-  _pattern_fit_params.fit_variance=sq(_team->_pattern_fitness_stddev->getDouble());
-  _pattern_fit_params.fit_uniform=_team->_pattern_fitness_uniform->getDouble();
-
-  //load team image:
-
-
-  if (_load_markers_from_image_file == true && _marker_image_file.length() > 0) {
-    rgbImage rgbi;
-    if (rgbi.load(_marker_image_file)) {
-      //create a YUV lut that's based on color-labels not on custom data:
-      YUVLUT minilut(4,4,4,"");
-      minilut.copyChannels(*_lut3d);
-      //compute a full LUT mapping based on NN-distance to color labels:
-      minilut.computeLUTfromLabels();
-      yuvImage yuvi;
-      yuvi.allocate(rgbi.getWidth(),rgbi.getHeight());
-      Images::convert(rgbi,yuvi);
-      printf("Loading Team Image %s\n",_marker_image_file.c_str());
-      if (model.loadMultiPatternImage(yuvi,&minilut,_marker_image_rows,_marker_image_cols,_team->_robot_height->getDouble())==false) {
-          fprintf(stderr,"Errors while processing team image file: '%s'.\n",_marker_image_file.c_str());
-          fflush(stderr);
-      }
-    } else {
-          fprintf(stderr,"Error loading team image file: '%s'.\n",_marker_image_file.c_str());
-          fflush(stderr);
-    }
-    for (int i=0;i<model.getNumPatterns();i++) {
-      model.getPattern(i).setEnabled(_team->_valid_patterns->isSelected(i));
-    }
-    model.recheckColorsUsed();
-  }
-
-
+  _unique_patterns=settings.unique_patterns;
+  _have_angle=settings.have_angle;
+  _robot_height=settings.robot_height;
+
+  _center_marker_area_mean=settings.center_marker_area_mean;
+  _center_marker_area_stddev=settings.center_marker_area_stddev;
+  _center_marker_uniform=settings.center_marker_uniform;
+  _center_marker_duplicate_distance=settings.center_marker_duplicate_distance;
+
+  filter_team.setWidth(settings.center_marker_min_width,settings.center_marker_max_width);
+  filter_team.setHeight(settings.center_marker_min_height,settings.center_marker_max_height);
+  filter_team.setArea(settings.center_marker_min_area,settings.center_marker_max_area);
+
+  filter_others.setWidth(settings.other_markers_min_width,settings.other_markers_max_width);
+  filter_others.setHeight(settings.other_markers_min_height,settings.other_markers_max_height);
+  filter_others.setArea(settings.other_markers_min_area,settings.other_markers_max_area);
+
+  _histogram_enable=settings.histogram_enable;
+  _histogram_pixel_scan_radius=settings.histogram_pixel_scan_radius;
+
+  _histogram_markeryness.set(settings.histogram_min_markeryness,settings.histogram_max_markeryness);
+  _histogram_field_greenness.set(settings.histogram_min_field_greenness,settings.histogram_max_field_greenness);
+  _histogram_black_whiteness.set(settings.histogram_min_black_whiteness,settings.histogram_max_black_whiteness);
+
+
+  _pattern_max_dist=settings.pattern_max_dist;
+  _pattern_fit_params.fit_area_weight=settings.pattern_fitness_weight_area;
+  _pattern_fit_params.fit_cen_dist_weight=settings.pattern_fitness_weight_center_distance;
+  _pattern_fit_params.fit_next_dist_weight=settings.pattern_fitness_weight_next_distance;
+  _pattern_fit_params.fit_next_dist_weight=settings.pattern_fitness_weight_next_angle_distance;
+  _pattern_fit_params.fit_max_error=settings.pattern_fitness_max_error;
+  _pattern_fit_params.fit_variance=sq(settings.pattern_fitness_stddev);
+  _pattern_fit_params.fit_uniform=settings.pattern_fitness_uniform;
 }
 
 
@@ -172,7 +145,8 @@ TeamDetector::~TeamDetector()
   if (histogram !=0) delete histogram;
 }
 
-void TeamDetector::update(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots, int team_color_id, int max_robots, const Image<raw8> * image, CMVision::ColorRegionList * colorlist, CMVision::RegionTree & reg_tree) {
+void TeamDetector::update(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots, int team_color_id, int max_robots, const Image<raw8> * image, CMVision::ColorRegionList * colorlist, CMVision::RegionTree & reg_tree, const CameraModel & camera) {
+  _camera=&camera;
   color_id_team=team_color_id;
   _max_robots=max_robots;
   robots->Clear();
@@ -200,7 +174,7 @@ void TeamDetector::findRobotsByTeamMarkerOnly(::google::protobuf::RepeatedPtrFie
   while((reg = filter_team.getNext()) != 0) {
     vector2d reg_img_center(reg->cen_x,reg->cen_y);
     vector3d reg_center3d;
-    _camera_params.image2field(reg_center3d,reg_img_center,_robot_height);
+    _camera->image2field(reg_center3d,reg_img_center,_robot_height);
     vector2d reg_center(reg_center3d.x,reg_center3d.y);
 
     //TODO: add confidence masking:
@@ -265,8 +239,8 @@ double TeamDetector::getRegionArea(const CMVision::Region * reg, double z) const
   vector3d a,b;
   vector2d right(reg->x2+1,reg->y2+1);
   vector2d left(reg->x1,reg->y1);
-  _camera_params.image2field(a,right,z);
-  _camera_params.image2field(b,left,z);
+  _camera->image2field(a,right,z);
+  _camera->image2field(b,left,z);
   vector3d box = a-b;
 
   double box_area = fabs(box.x) * fabs(box.y);
@@ -429,7 +403,7 @@ void TeamDetector::findRobotsByModel(::google::protobuf::RepeatedPtrField< ::SSL
   while((reg = filter_team.getNext()) != 0) {
     vector2d reg_img_center(reg->cen_x,reg->cen_y);
     vector3d reg_center3d;
-    _camera_params.image2field(reg_center3d,reg_img_center,_robot_height);
+    _camera->image2field(reg_center3d,reg_img_center,_robot_height);
     vector2d reg_center(reg_center3d.x,reg_center3d.y);
     //TODO add masking:
     //if(det.mask.get(reg->cen_x,reg->cen_y) >= 0.5){
@@ -447,7 +421,7 @@ void TeamDetector::findRobotsByModel(::google::protobuf::RepeatedPtrField< ::SSL
         if(filter_others.check(*mreg) && model.usesColor(mreg->color)) {
           vector2d marker_img_center(mreg->cen_x,mreg->cen_y);
           vector3d marker_center3d;
-          _camera_params.image2field(marker_center3d,marker_img_center,_robot_height);
+          _camera->image2field(marker_center3d,marker_img_center,_robot_height);
           Marker &m = markers[num_markers];
 
           m.set(mreg,marker_center3d,getRegionArea(mreg,_robot_height));
@@ -479,7 +453,7 @@ void TeamDetector::findRobotsByModel(::google::protobuf::RepeatedPtrField< ::SSL
           markers[i].next_angle_dist = angle_pos(angle_diff(markers[i].angle,markers[j].angle));
         }
 
-        if (model.findPattern(res,markers,num_markers,_pattern_fit_params,_camera_params)) {
+        if (model.findPattern(res,markers,num_markers,_pattern_fit_params,*_camera)) {
               robot=addRobot(robots,res.conf,_max_robots*2);
               if (robot!=0) {
                 //setup robot:
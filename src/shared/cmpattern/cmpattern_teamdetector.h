@@ -21,149 +21,83 @@
 //========================================================================
 #ifndef CM_PATTERN_TEAMDETECTOR_H
 #define CM_PATTERN_TEAMDETECTOR_H
-#include "VarTypes.h"
 #include "messages_robocup_ssl_detection.pb.h"
 #include "image.h"
-#include "lut3d.h"
-#include "cmpattern_team.h"
+#include "lut3d_table.h"
 #include "cmpattern_pattern.h"
 #include "cmvision_region.h"
-#include "field.h"
-#include "camera_calibration.h"
+#include "camera_model.h"
 #include "field_filter.h"
 #include "vis_util.h"
 #include "cmvision_histogram.h"
 #include <string.h>
 #include <vector>
-#include <QObject>
 
 using namespace std;
 namespace CMPattern {
 
-class TeamDetectorInterface {
-public:
-  virtual VarList * getSettings() { return 0; };
-  virtual void update(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots) { (void)robots; };
-  virtual ~TeamDetectorInterface() {};
-};
-
-
-class TeamDetector;
-class TeamSelector;
-
-class TeamDetectorSettings : public QObject {
-Q_OBJECT
- friend class TeamDetector;
- friend class TeamSelector;
- protected:
- VarList * settings;
- VarList * teams; // a global variable, defining all teams
- VarTrigger * addTeam;
- vector<Team *> team_vector;
-signals:
-  void teamInfoChanged();
- protected slots:
-   void slotTeamNodeAdded(VarType * node);
-   void slotAddPressed();
- public:
- vector<Team *> getTeams() const;
- Team * getTeam(int idx) const;
- TeamDetectorSettings(string external_file="");
- VarList * getSettings() {
-   return settings;
- }
- //TODO: add notifier factory.
-
-};
-
+/*!
+  \struct TeamSettings
+  \brief  The detection settings of a team, as plain values
 
-class TeamSelector : public QObject {
-Q_OBJECT
-signals:
-  void signalTeamDataChanged();
-protected:
-  TeamDetectorSettings * _detector_settings;
-  VarList * _settings;
-  VarStringEnum * _selector;
-  VarInt * _num_robots;
-  Team * current_team;
-  void update() {
-    vector<Team *> teams = _detector_settings->getTeams();
-    _selector->setSize(teams.size(), "");
-    int old_select_index = _selector->getIndex();
-    for (unsigned int i=0;i<teams.size();i++) {
-      _selector->setLabel(i,teams[i]-> _team_name->getString());
-    }
-    Team * new_team=0;
-    if (teams.size() > 0) {
-      if (old_select_index >= 0 && old_select_index < (int)teams.size()) {
-         _selector->selectIndex(old_select_index);
-      } else {
-         _selector->selectIndex(0);
-      }
-      new_team=_detector_settings->getTeam(_selector->getIndex());
-    } else {
-      new_team=0;
-    }
-    if (new_team!=current_team) {
-      if (current_team!=0) {
-        disconnect(current_team,SIGNAL(signalChangeOccured(VarType*)),this,SLOT(slotTeamDataChanged()));
-      }
-      if (new_team!=0) {
-        connect(new_team,SIGNAL(signalChangeOccured(VarType*)),this,SLOT(slotTeamDataChanged()));
-      }
-      current_team=new_team;
-    }
-    emit(signalTeamDataChanged());
-  }
-protected slots:
-  void slotTeamInfoChanged() {
-    update();
-  }
-  void slotTeamDataChanged() {
-    emit(signalTeamDataChanged());
-  }
-public:
-  TeamSelector(string label, TeamDetectorSettings * detector_settings) {
-    _detector_settings=detector_settings;
-    connect(_detector_settings,SIGNAL(teamInfoChanged()),this,SLOT(slotTeamInfoChanged()));
-    current_team=0;
-    _settings= new VarList(label);
-    _settings->addChild(_selector = new VarStringEnum("Team",""));
-    _selector->addFlags(VARTYPE_FLAG_NOLOAD_ENUM_CHILDREN);
-    _settings->addChild(_num_robots = new VarInt("Max Robots",6));
-    update();
-  }
-  VarList * getSettings() {
-    return _settings;
-  }
-  Team * getSelectedTeam() {
-    if (_selector->getIndex() == -1) {
-      update();
-    } else if (current_team!=_detector_settings->getTeam(_selector->getIndex())) {
-      update();
-    }
-    return current_team;
-  }
-  int getNumberRobots() {
-    return _num_robots->getInt();
-  }
-  ~TeamSelector() {
-    delete _settings;
-  }
+  A Team keeps these settings in VarTypes, takes their defaults from here,
+  and fills the struct with Team::compile().
+*/
+struct TeamSettings {
+  bool   unique_patterns;
+  bool   have_angle;
+  double robot_height;
+
+  double center_marker_area_mean;
+  double center_marker_area_stddev;
+  double center_marker_uniform;
+  int    center_marker_min_width;
+  int    center_marker_max_width;
+  int    center_marker_min_height;
+  int    center_marker_max_height;
+  int    center_marker_min_area;
+  int    center_marker_max_area;
+  double center_marker_duplicate_distance;
+
+  int    other_markers_min_width;
+  int    other_markers_max_width;
+  int    other_markers_min_height;
+  int    other_markers_max_height;
+  int    other_markers_min_area;
+  int    other_markers_max_area;
+
+  bool   histogram_enable;
+  int    histogram_pixel_scan_radius;
+  double histogram_min_markeryness;
+  double histogram_max_markeryness;
+  double histogram_min_field_greenness;
+  double histogram_max_field_greenness;
+  double histogram_min_black_whiteness;
+  double histogram_max_black_whiteness;
+
+  double pattern_max_dist;
+  double pattern_fitness_weight_area;
+  double pattern_fitness_weight_center_distance;
+  double pattern_fitness_weight_next_distance;
+  double pattern_fitness_weight_next_angle_distance;
+  double pattern_fitness_max_error;
+  double pattern_fitness_stddev;
+  double pattern_fitness_uniform;
+
+  TeamSettings();
 };
 
+/*!
+  \class  TeamDetector
+  \brief  Finds the robots of one team in the regions of a frame
 
-
-class TeamDetector : public TeamDetectorInterface {
+  The patterns of the team are loaded into getModel(), e.g. with
+  Team::loadPatterns(), after init().
+*/
+class TeamDetector {
 protected:
-
-  //TeamDetectorSettings * _detector_settings;
-
-  const CameraParameters& _camera_params;
-  const RoboCupField& _field;
-  Team * _team;
-  LUT3D * _lut3d;
+  const CameraModel * _camera;
+  LUT3DTable * _lut3d;
   FieldFilter field_filter;
   MultiPatternModel model;
 
@@ -172,10 +106,6 @@ protected:
   CMVision::RegionFilter filter_others;
   bool   _unique_patterns;
   bool   _have_angle;
-  bool   _load_markers_from_image_file;
-  string _marker_image_file;
-  int    _marker_image_rows;
-  int    _marker_image_cols;
 
   int    _max_robots;
   double _robot_height;
@@ -218,23 +148,24 @@ protected:
     //remove anything with a confidence of 0:
     void stripRobots(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots);
 
+    void findRobotsByModel(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots, int team_color_id, const Image<raw8> * image, CMVision::ColorRegionList * colorlist, CMVision::RegionTree & reg_tree);
+
+    void findRobotsByTeamMarkerOnly(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots, int team_color_id, const Image<raw8> * image, CMVision::ColorRegionList * colorlist);
+
 public:
-    TeamDetector(LUT3D * lut3d, const CameraParameters& camera_params, const RoboCupField& field);
+    TeamDetector(LUT3DTable * lut3d);
 
     virtual ~TeamDetector();
 
-    VarList * getSettings() {
-      return 0;
-    }
     CMVision::Histogram * histogram;
 
-    void init(Team * team);
+    void init(const TeamSettings & settings, const FieldFilter & field);
 
-    void findRobotsByModel(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots, int team_color_id, const Image<raw8> * image, CMVision::ColorRegionList * colorlist, CMVision::RegionTree & reg_tree);
-
-    void findRobotsByTeamMarkerOnly(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots, int team_color_id, const Image<raw8> * image, CMVision::ColorRegionList * colorlist);
+    MultiPatternModel & getModel() {
+      return model;
+    }
 
-    void update(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots, int team_color_id, int max_robots, const Image<raw8> * image, CMVision::ColorRegionList * colorlist, CMVision::RegionTree & reg_tree);
+    void update(::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot >* robots, int team_color_id, int max_robots, const Image<raw8> * image, CMVision::ColorRegionList * colorlist, CMVision::RegionTree & reg_tree, const CameraModel & camera);
 };
 
 }
@@ -387,7 +387,7 @@ int FindStart(rle_t *rmap,int left,int right,int x)
 #endif
 
 
-ImageProcessor::ImageProcessor(YUVLUT * _lut, int _max_regions, int _max_runs) {
+ImageProcessor::ImageProcessor(LUT3DTable * _lut, int _max_regions, int _max_runs) {
   lut=_lut;
   max_regions=_max_regions;
   max_runs=_max_runs;
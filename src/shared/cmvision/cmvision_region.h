@@ -26,7 +26,7 @@
 #include "geometry.h"
 #include "nkdtree.h"
 #include "cmvision_threshold.h"
-#include "lut3d.h"
+#include "lut3d_table.h"
 
 #define CMV_DEFAULT_MAX_RUNS 100000
 
@@ -310,7 +310,7 @@ typedef NKDTree<Region,float,2,false,CMVision::RegionTreeGetNext> RegionTree;
 
 class ImageProcessor {
 protected:
-  YUVLUT * lut;
+  LUT3DTable * lut;
   int max_regions;
   int max_runs;
   CMVision::RegionList * reglist;
@@ -318,7 +318,7 @@ protected:
   CMVision::RunList * runlist;
   Image<raw8> * img_thresholded;
 public:
-  ImageProcessor(YUVLUT * _lut, int _max_regions=10000, int _max_runs=50000);
+  ImageProcessor(LUT3DTable * _lut, int _max_regions=10000, int _max_runs=50000);
   ~ImageProcessor();
   void processYUV422_UYVY(const RawImage * image, int min_blob_area);
   void processYUV444(const ImageInterface * image, int min_blob_area);
@@ -31,7 +31,7 @@ CMVisionThreshold::~CMVisionThreshold()
 }
 
 
-void CMVisionThreshold::colorizeImageFromThresholding(rgbImage & target, const Image<raw8> & source, LUT3D * lut) {
+void CMVisionThreshold::colorizeImageFromThresholding(rgbImage & target, const Image<raw8> & source, LUT3DTable * lut) {
   target.allocate(source.getWidth(),source.getHeight());
   int n = source.getNumPixels();
 
@@ -42,7 +42,7 @@ void CMVisionThreshold::colorizeImageFromThresholding(rgbImage & target, const I
   }
 }
 
-bool CMVisionThreshold::thresholdImageYUV422_UYVY(Image<raw8> * target, const RawImage * source, YUVLUT * lut) {
+bool CMVisionThreshold::thresholdImageYUV422_UYVY(Image<raw8> * target, const RawImage * source, LUT3DTable * lut) {
   if (source->getColorFormat()!=COLOR_YUV422_UYVY) {
     //TODO add YUV444 and maybe even 411 mode
     fprintf(stderr,"CMVision thresholdImageYUV422_UYVY assumes YUV422 as input, but found %s\n", Colors::colorFormatToString(source->getColorFormat()).c_str());
@@ -79,7 +79,7 @@ bool CMVisionThreshold::thresholdImageYUV422_UYVY(Image<raw8> * target, const Ra
   return true;
 }
 
-bool CMVisionThreshold::thresholdImageYUV444(Image<raw8> * target, const ImageInterface * source, YUVLUT * lut) {
+bool CMVisionThreshold::thresholdImageYUV444(Image<raw8> * target, const ImageInterface * source, LUT3DTable * lut) {
   if (source->getColorFormat()!=COLOR_YUV444) {
     fprintf(stderr,"CMVision thresholdImageYUV444 assumes YUV444 as input, but found %s\n", Colors::colorFormatToString(source->getColorFormat()).c_str());
     return false;
@@ -114,7 +114,7 @@ bool CMVisionThreshold::thresholdImageYUV444(Image<raw8> * target, const ImageIn
 
 
 
-bool CMVisionThreshold::thresholdImageRGB(Image<raw8> * target, const ImageInterface * source, RGBLUT * lut) {
+bool CMVisionThreshold::thresholdImageRGB(Image<raw8> * target, const ImageInterface * source, LUT3DTable * lut) {
   if (source->getColorFormat()!=COLOR_RGB8) {
     fprintf(stderr,"CMVision RGB thresholding assumes RGB8 as input, but found %s\n", Colors::colorFormatToString(source->getColorFormat()).c_str());
     return false;
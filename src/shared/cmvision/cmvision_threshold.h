@@ -22,7 +22,7 @@
 #ifndef CMVISIONTHRESHOLD_H
 #define CMVISIONTHRESHOLD_H
 
-#include "lut3d.h"
+#include "lut3d_table.h"
 #include "image_interface.h"
 #include "image.h"
 #include "colors.h"
@@ -38,11 +38,11 @@ public:
 
     ~CMVisionThreshold();
 
-    static bool thresholdImageYUV422_UYVY(Image<raw8> * target, const RawImage * source, YUVLUT * lut);
-    static bool thresholdImageYUV444(Image<raw8> * target, const ImageInterface * source, YUVLUT * lut);
-    static bool thresholdImageRGB(Image<raw8> * target, const ImageInterface * source, RGBLUT * lut);
+    static bool thresholdImageYUV422_UYVY(Image<raw8> * target, const RawImage * source, LUT3DTable * lut);
+    static bool thresholdImageYUV444(Image<raw8> * target, const ImageInterface * source, LUT3DTable * lut);
+    static bool thresholdImageRGB(Image<raw8> * target, const ImageInterface * source, LUT3DTable * lut);
 
-    static void colorizeImageFromThresholding(rgbImage & target, const Image<raw8> & source, LUT3D * lut);
+    static void colorizeImageFromThresholding(rgbImage & target, const Image<raw8> & source, LUT3DTable * lut);
 
     //static void thresholdImage(Image * target, const Image<yuv> * source, const YUVLUT * lut);
 
@@ -192,6 +192,39 @@ bool UDP::send(const void *data,int length,const Address &dest)
   return(len == length);
 }
 
+int UDP::sendBatch(const void * const *data,const int *length,int count,const Address &dest)
+{
+  static const int MaxBatch = 64;
+  mmsghdr msgs[MaxBatch];
+  iovec iovs[MaxBatch];
+  int sent = 0;
+
+  while(sent < count){
+    int n = count - sent;
+    if(n > MaxBatch) n = MaxBatch;
+    for(int i=0; i<n; i++){
+      iovs[i].iov_base = (void*)data[sent+i];
+      iovs[i].iov_len = length[sent+i];
+      memset(&msgs[i],0,sizeof(msgs[i]));
+      msgs[i].msg_hdr.msg_name = (void*)&dest.addr;
+      msgs[i].msg_hdr.msg_namelen = dest.addr_len;
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int r = sendmmsg(fd,msgs,n,0);
+    if(r <= 0) break;
+    for(int i=0; i<r; i++){
+      if((int)msgs[i].msg_len != length[sent+i]) return(sent + i);
+      sent_packets++;
+      sent_bytes += msgs[i].msg_len;
+    }
+    sent += r;
+    if(r < n) break;
+  }
+
+  return(sent);
+}
+
 int UDP::recv(void *data,int length,Address &src)
 {
   src.addr_len = sizeof(src.addr);
@@ -205,6 +238,43 @@ int UDP::recv(void *data,int length,Address &src)
   return(len);
 }
 
+int UDP::recvBatch(void * const *data,int length,int *sizes,int count,bool dont_wait)
+{
+  static const int MaxBatch = 64;
+  mmsghdr msgs[MaxBatch];
+  iovec iovs[MaxBatch];
+  if(count > MaxBatch) count = MaxBatch;
+
+  for(int i=0; i<count; i++){
+    iovs[i].iov_base = data[i];
+    iovs[i].iov_len = length;
+    memset(&msgs[i],0,sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  int r = recvmmsg(fd,msgs,count,(dont_wait ? MSG_DONTWAIT : MSG_WAITFORONE),NULL);
+  if(r < 0) return(0);
+
+  for(int i=0; i<r; i++){
+    sizes[i] = msgs[i].msg_len;
+    recv_packets++;
+    recv_bytes += msgs[i].msg_len;
+  }
+  return(r);
+}
+
+int UDP::setRecvBuffer(int size)
+{
+  if(setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size))!=0) {
+    fprintf(stderr,"ERROR WHEN SETTING SO_RCVBUF ON UDP SOCKET\n");
+    fflush(stderr);
+  }
+  int result = 0;
+  socklen_t length = sizeof(result);
+  if(getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &result, &length)!=0) return(0);
+  return(result);
+}
+
 bool UDP::wait(int timeout_ms) const
 {
   pollfd pfd;
@@ -69,8 +69,19 @@ public:
     {return(fd >= 0);}
 
   bool send(const void *data,int length,const Address &dest);
+  // sends count datagrams with as few system calls as possible (sendmmsg),
+  // returns the number of datagrams that were sent completely
+  int  sendBatch(const void * const *data,const int *length,int count,const Address &dest);
   int  recv(void *data,int length,Address &src);
+  // receives up to count datagrams of at most length bytes with one system
+  // call (recvmmsg). A blocking socket waits for the first datagram only,
+  // unless dont_wait is set. Returns the number of datagrams and stores
+  // their sizes in sizes.
+  int  recvBatch(void * const *data,int length,int *sizes,int count,bool dont_wait=false);
   bool wait(int timeout_ms = -1) const;
+  // requests a kernel receive buffer of size bytes (limited by
+  // net.core.rmem_max), returns the size that the socket got
+  int  setRecvBuffer(int size);
   bool havePendingData() const
     {return(wait(0));}
 
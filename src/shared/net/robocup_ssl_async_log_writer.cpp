@@ -0,0 +1,96 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_async_log_writer.cpp
+  \brief   C++ Implementation: RoboCupSSLAsyncLogWriter
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_async_log_writer.h"
+
+RoboCupSSLAsyncLogWriter::RoboCupSSLAsyncLogWriter(size_t chunk_size) : RoboCupSSLLogWriter(chunk_size)
+{
+  spare_capacity=chunk_capacity;
+  spare=new char[spare_capacity];
+  pending=0;
+  pending_size=0;
+  running=true;
+  failed=false;
+  stalls=0;
+  thread=new WriterThread(this);
+  thread->start();
+}
+
+RoboCupSSLAsyncLogWriter::~RoboCupSSLAsyncLogWriter()
+{
+  //the base class would close with its own writeData():
+  close();
+  mutex.lock();
+  running=false;
+  wakeup.wakeOne();
+  mutex.unlock();
+  thread->wait();
+  delete thread;
+  delete[] spare;
+}
+
+void RoboCupSSLAsyncLogWriter::runWriter() {
+  mutex.lock();
+  while (running) {
+    if (pending==0) {
+      wakeup.wait(&mutex);
+      continue;
+    }
+    const char * data=pending;
+    size_t size=pending_size;
+    mutex.unlock();
+    bool ok=(fwrite(data,1,size,f)==size && fflush(f)==0);
+    mutex.lock();
+    if (ok==false) failed=true;
+    pending=0;
+    written.wakeAll();
+  }
+  mutex.unlock();
+}
+
+bool RoboCupSSLAsyncLogWriter::writeData(const char * data, size_t size) {
+  QMutexLocker locker(&mutex);
+  if (pending!=0) {
+    if (data==chunk) stalls++;
+    while (pending!=0) written.wait(&mutex);
+  }
+  //the file header starts a new file:
+  if (offset==0) failed=false;
+  if (failed) return false;
+  if (data!=chunk) {
+    //the header, the index and the trailer, while the thread is idle:
+    return fwrite(data,1,size,f)==size;
+  }
+  //hand the chunk to the thread and continue in the other buffer:
+  pending=chunk;
+  pending_size=size;
+  chunk=spare;
+  spare=(char *)pending;
+  size_t capacity=chunk_capacity;
+  chunk_capacity=spare_capacity;
+  spare_capacity=capacity;
+  wakeup.wakeOne();
+  return true;
+}
+
+long long RoboCupSSLAsyncLogWriter::getStalls() {
+  QMutexLocker locker(&mutex);
+  return stalls;
+}
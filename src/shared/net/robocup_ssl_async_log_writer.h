@@ -0,0 +1,79 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_async_log_writer.h
+  \brief   C++ Interface: RoboCupSSLAsyncLogWriter
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_ASYNC_LOG_WRITER_H
+#define ROBOCUP_SSL_ASYNC_LOG_WRITER_H
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include "robocup_ssl_log_writer.h"
+
+/*!
+  \class   RoboCupSSLAsyncLogWriter
+  \brief   A RoboCupSSLLogWriter whose chunks are written by a dedicated thread
+
+  The writer has two chunk buffers. A full chunk is handed to the writer
+  thread, and the records are written into the other buffer meanwhile, so
+  that writing a record never waits for the disk unless the previous chunk
+  is still being written. Such waits are counted in getStalls().
+
+  The file header, the index and the trailer are written by the calling
+  thread after the writer thread has finished, so open() and close() are
+  synchronous. A failed chunk write is reported by the next write() that
+  starts a chunk, or by close().
+*/
+class RoboCupSSLAsyncLogWriter : public RoboCupSSLLogWriter {
+protected:
+  class WriterThread : public QThread {
+  protected:
+    RoboCupSSLAsyncLogWriter * writer;
+  public:
+    WriterThread(RoboCupSSLAsyncLogWriter * _writer) {
+      writer=_writer;
+    }
+    virtual void run() {
+      writer->runWriter();
+    }
+  };
+  friend class WriterThread;
+
+  char * spare;                //the buffer of the chunk that is written
+  size_t spare_capacity;
+  QMutex mutex;
+  QWaitCondition wakeup;       //a chunk is pending
+  QWaitCondition written;      //the pending chunk was written
+  const char * pending;
+  size_t pending_size;
+  bool running;
+  bool failed;
+  long long stalls;
+  WriterThread * thread;
+
+  void runWriter();
+  virtual bool writeData(const char * data, size_t size);
+public:
+  RoboCupSSLAsyncLogWriter(size_t chunk_size=1048576);
+  virtual ~RoboCupSSLAsyncLogWriter();
+
+  /// the number of chunks that had to wait for the previous one
+  long long getStalls();
+};
+
+#endif
@@ -0,0 +1,237 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_async_server.cpp
+  \brief   C++ Implementation: RoboCupSSLAsyncServer
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_async_server.h"
+#include <sys/eventfd.h>
+#include <sys/poll.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "timer.h"
+#include "tracer.h"
+
+RoboCupSSLAsyncServer::RoboCupSSLAsyncServer(int port,
+                     string net_address,
+                     string net_interface,
+                     AffinityManager * _affinity) : RoboCupSSLServer(port,net_address,net_interface)
+{
+  affinity=_affinity;
+  for (int i=0;i<MaxQueues;i++) queues[i]=0;
+  num_queues=0;
+  pthread_key_create(&queue_key,0);
+  batch_window=0.0;
+  enabled=true;
+  running=true;
+  sender_sleeping=0;
+  dropped_reported=0;
+  dest_port=-1;
+  sender=0;
+  wakeup_fd=eventfd(0,EFD_NONBLOCK | EFD_CLOEXEC);
+  asynchronous=(wakeup_fd >= 0);
+  if (wakeup_fd < 0) {
+    fprintf(stderr,"Unable to create the wakeup of the network sender thread, sending synchronously.\n");
+    return;
+  }
+  sender=new SenderThread(this);
+  sender->start();
+}
+
+RoboCupSSLAsyncServer::~RoboCupSSLAsyncServer()
+{
+  if (sender!=0) {
+    running=false;
+    __sync_synchronize();
+    wakeSender();
+    sender->wait();
+    delete sender;
+  }
+  if (wakeup_fd >= 0) ::close(wakeup_fd);
+  for (int i=0;i<num_queues;i++) delete queues[i];
+  pthread_key_delete(queue_key);
+}
+
+void RoboCupSSLAsyncServer::setAsynchronous(bool enable) {
+  asynchronous=(enable && sender!=0);
+}
+
+void RoboCupSSLAsyncServer::setEnabled(bool enable) {
+  enabled=enable;
+}
+
+void RoboCupSSLAsyncServer::setBatchWindow(double seconds) {
+  batch_window=seconds;
+}
+
+RoboCupSSLAsyncServer::Queue * RoboCupSSLAsyncServer::getQueue() {
+  Queue * q=(Queue *)pthread_getspecific(queue_key);
+  if (q==0) {
+    //the first packet of this thread:
+    queues_mutex.lock();
+    if (num_queues < MaxQueues) {
+      q=new Queue();
+      queues[num_queues]=q;
+      __sync_synchronize();
+      num_queues=num_queues+1;
+    }
+    queues_mutex.unlock();
+    if (q!=0) pthread_setspecific(queue_key,q);
+  }
+  return q;
+}
+
+bool RoboCupSSLAsyncServer::queuesEmpty() {
+  int n=num_queues;
+  for (int i=0;i<n;i++) {
+    if (queues[i]->head!=queues[i]->tail) return false;
+  }
+  return true;
+}
+
+void RoboCupSSLAsyncServer::wakeSender() {
+  uint64_t one=1;
+  ssize_t result=write(wakeup_fd,&one,sizeof(one));
+  (void)result;
+}
+
+bool RoboCupSSLAsyncServer::sendData(const char * data, int size) {
+  if (enabled==false) return false;
+  //more than MaxQueues sending threads are served synchronously:
+  Queue * q=(asynchronous ? getQueue() : 0);
+  if (q==0) return RoboCupSSLServer::sendData(data,size);
+
+  unsigned int head=q->head;
+  if (head-q->tail >= (unsigned int)Queue::SIZE) {
+    q->dropped=q->dropped+1;
+    return false;
+  }
+  Slot & slot=q->slots[head & (Queue::SIZE-1)];
+  if (slot.capacity < size) {
+    delete[] slot.data;
+    slot.capacity=(size > 2048 ? size : 2048);
+    slot.data=new char[slot.capacity];
+  }
+  memcpy(slot.data,data,size);
+  slot.size=size;
+  slot.t_queued=GetTimeSec();
+  //the slot is complete before the head moves, and the head has moved
+  //before the sender is checked (which checks the heads after announcing
+  //that it sleeps), so no wakeup is lost:
+  __sync_synchronize();
+  q->head=head+1;
+  __sync_synchronize();
+  if (sender_sleeping) wakeSender();
+  return true;
+}
+
+void RoboCupSSLAsyncServer::runSender() {
+  Tracer::setThreadName("network sender");
+  if (affinity!=0) affinity->demandHousekeeping();
+  pollfd pfd;
+  pfd.fd=wakeup_fd;
+  pfd.events=POLLIN;
+  while (running) {
+    sender_sleeping=1;
+    __sync_synchronize();
+    if (running && queuesEmpty()) {
+      pfd.revents=0;
+      poll(&pfd,1,-1);
+    }
+    sender_sleeping=0;
+    uint64_t wakeups;
+    ssize_t result=read(wakeup_fd,&wakeups,sizeof(wakeups));
+    (void)result;
+    double window=batch_window;
+    if (window > 0.0) usleep((useconds_t)(window*1.0E6));
+    while (sendQueued() > 0) {}
+  }
+}
+
+int RoboCupSSLAsyncServer::sendQueued() {
+  TRACE_SPAN("udp send batch");
+  int n=0;
+  int max_depth=0;
+  unsigned int tails[MaxQueues];
+  int nq=num_queues;
+  __sync_synchronize();
+  for (int i=0;i<nq;i++) {
+    Queue * q=queues[i];
+    unsigned int tail=q->tail;
+    unsigned int head=q->head;
+    __sync_synchronize();
+    if ((int)(head-tail) > max_depth) max_depth=(int)(head-tail);
+    for (;tail!=head && n < MaxBatch;tail++) {
+      const Slot & slot=q->slots[tail & (Queue::SIZE-1)];
+      batch_data[n]=slot.data;
+      batch_length[n]=slot.size;
+      batch_t_queued[n]=slot.t_queued;
+      n++;
+    }
+    tails[i]=tail;
+  }
+  if (n==0) return 0;
+
+  int sent=0;
+  mutex.lock();
+  if (mc.isOpen()) {
+    if (dest_port!=_port || dest_address!=_net_address) {
+      dest.setHost(_net_address.c_str(),_port);
+      dest_address=_net_address;
+      dest_port=_port;
+    }
+    sent=mc.sendBatch(batch_data,batch_length,n,dest);
+  }
+  mutex.unlock();
+  double t=GetTimeSec();
+
+  //the slots are free once their datagrams are sent:
+  __sync_synchronize();
+  for (int i=0;i<nq;i++) queues[i]->tail=tails[i];
+
+  if (sent < n) {
+    fprintf(stderr,"Sending %d of %d UDP datagram(s) failed.\n",n-sent,n);
+  }
+  stats_mutex.lock();
+  for (int i=0;i<sent;i++) stats.latency.add(t-batch_t_queued[i]);
+  stats.packets+=sent;
+  stats.errors+=n-sent;
+  stats.batches++;
+  if (max_depth > stats.max_depth) stats.max_depth=max_depth;
+  stats_mutex.unlock();
+  return n;
+}
+
+void RoboCupSSLAsyncServer::getStatistics(Statistics & result) {
+  long long dropped=0;
+  int n=num_queues;
+  for (int i=0;i<n;i++) dropped+=queues[i]->dropped;
+  stats_mutex.lock();
+  result=stats;
+  result.dropped=dropped-dropped_reported;
+  stats_mutex.unlock();
+}
+
+void RoboCupSSLAsyncServer::resetStatistics() {
+  long long dropped=0;
+  int n=num_queues;
+  for (int i=0;i<n;i++) dropped+=queues[i]->dropped;
+  stats_mutex.lock();
+  stats.clear();
+  dropped_reported=dropped;
+  stats_mutex.unlock();
+}
@@ -0,0 +1,180 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_async_server.h
+  \brief   C++ Interface: RoboCupSSLAsyncServer
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_ASYNC_SERVER_H
+#define ROBOCUP_SSL_ASYNC_SERVER_H
+#include <pthread.h>
+#include <QThread>
+#include "robocup_ssl_server.h"
+#include "realtime_manager.h"
+#include "affinity_manager.h"
+
+/*!
+  \class   RoboCupSSLAsyncServer
+  \brief   A RoboCupSSLServer whose datagrams are sent by a dedicated thread
+
+  In asynchronous mode, sending only copies the serialized packet into a
+  queue of the calling thread (one per camera) and wakes the sender thread.
+  Each queue is a single-producer, single-consumer ring, so a producer never
+  waits for another camera, the socket, or the sender. If a queue is full,
+  the packet is dropped and counted.
+
+  The sender drains all queues at once and sends everything queued with a
+  single sendmmsg(). An optional batch window delays the send after a
+  wakeup, so that cameras which finish at nearly the same time share a
+  system call. The socket is non-blocking: a full socket buffer or a send
+  error is counted and the datagrams are dropped.
+
+  With asynchronous mode off, packets are sent on the calling thread, as by
+  a RoboCupSSLServer.
+
+  If an AffinityManager is given, the sender thread pins itself to the
+  housekeeping cpus, so it does not compete with the camera threads.
+
+  A disabled server drops all packets without queuing them, so that an
+  optional output can be switched off, and be closed and reopened, while
+  the camera threads keep sending to it.
+*/
+class RoboCupSSLAsyncServer : public RoboCupSSLServer {
+public:
+  /// the statistics of the sender since the last reset
+  class Statistics {
+  public:
+    LatencyHistogram latency; //from send() to the return of sendmmsg
+    long long packets;
+    long long batches;
+    long long dropped; //at full queues
+    long long errors;  //datagrams that the socket did not accept
+    int max_depth;     //the most packets waiting in one queue
+    Statistics() {
+      clear();
+    }
+    void clear() {
+      latency.clear();
+      packets=batches=dropped=errors=0;
+      max_depth=0;
+    }
+  };
+
+protected:
+  /// one queued datagram. The buffer grows to the largest packet of its
+  /// queue and is reused afterwards.
+  class Slot {
+  public:
+    char * data;
+    int capacity;
+    int size;
+    double t_queued;
+    Slot() {
+      data=0;
+      capacity=0;
+      size=0;
+      t_queued=0.0;
+    }
+    ~Slot() {
+      delete[] data;
+    }
+  };
+
+  /// the ring of one producing thread. \p head is only written by the
+  /// producer, \p tail only by the sender.
+  class Queue {
+  public:
+    static const int SIZE=16; //must be a power of two
+    Slot slots[SIZE];
+    volatile unsigned int head;
+    volatile unsigned int tail;
+    volatile long long dropped;
+    Queue() {
+      head=0;
+      tail=0;
+      dropped=0;
+    }
+  };
+
+  class SenderThread : public QThread {
+  protected:
+    RoboCupSSLAsyncServer * server;
+  public:
+    SenderThread(RoboCupSSLAsyncServer * _server) {
+      server=_server;
+    }
+    virtual void run() {
+      server->runSender();
+    }
+  };
+  friend class SenderThread;
+
+  static const int MaxQueues=16;
+  static const int MaxBatch=64;
+
+  Queue * queues[MaxQueues];
+  volatile int num_queues;
+  QMutex queues_mutex;
+  pthread_key_t queue_key;
+
+  volatile bool asynchronous;
+  volatile bool enabled;
+  volatile double batch_window;
+  volatile bool running;
+  volatile int sender_sleeping;
+  int wakeup_fd; //an eventfd
+  SenderThread * sender;
+  AffinityManager * affinity;
+
+  QMutex stats_mutex;
+  Statistics stats;
+  long long dropped_reported;
+
+  //owned by the sender thread:
+  Net::Address dest;
+  string dest_address;
+  int dest_port;
+  const void * batch_data[MaxBatch];
+  int batch_length[MaxBatch];
+  double batch_t_queued[MaxBatch];
+
+  Queue * getQueue();
+  bool queuesEmpty();
+  void wakeSender();
+  void runSender();
+  int sendQueued();
+  virtual bool sendData(const char * data, int size);
+
+public:
+  RoboCupSSLAsyncServer(int port = 10002,
+                        string net_ref_address="224.5.23.2",
+                        string net_ref_interface="",
+                        AffinityManager * _affinity=0);
+  virtual ~RoboCupSSLAsyncServer();
+
+  void setAsynchronous(bool enable);
+  void setEnabled(bool enable);
+  bool isEnabled() const {
+    return enabled;
+  }
+  /// the time that the sender waits for further packets after a wakeup
+  void setBatchWindow(double seconds);
+
+  void getStatistics(Statistics & result);
+  void resetStatistics();
+};
+
+#endif
@@ -28,12 +28,20 @@ RoboCupSSLClient::RoboCupSSLClient(int port,
   _net_address=net_address;
   _net_interface=net_interface;
   in_buffer=new char[65536];
+  //the batch buffers are allocated by the first receiveBatch():
+  for (int i=0;i<MaxBatch;i++) batch_data[i]=0;
+  for (int i=0;i<=MaxBatch;i++) packets[i]=0;
+  num_packets=0;
+  dropped=0;
+  for (int i=0;i<MaxCameras;i++) last_t_capture[i]=-1.0;
 }
 
 
 RoboCupSSLClient::~RoboCupSSLClient()
 {
   delete[] in_buffer;
+  for (int i=0;i<MaxBatch;i++) delete[] batch_data[i];
+  for (int i=0;i<=MaxBatch;i++) delete packets[i];
 }
 
 void RoboCupSSLClient::close() {
@@ -65,6 +73,10 @@ bool RoboCupSSLClient::open(bool blocking) {
   return(true);
 }
 
+bool RoboCupSSLClient::wait(int timeout_ms) const {
+  return mc.wait(timeout_ms);
+}
+
 bool RoboCupSSLClient::receive(SSL_WrapperPacket & packet) {
   Net::Address src;
   int r=0;
@@ -77,3 +89,77 @@ bool RoboCupSSLClient::receive(SSL_WrapperPacket & packet) {
   return false;
 }
 
+bool RoboCupSSLClient::receiveCompact(SSL_DetectionFrame & frame) {
+  Net::Address src;
+  int r = mc.recv(in_buffer,MaxDataGramSize,src);
+  if (r<=0 || compact.ParseFromArray(in_buffer,r)==false) return false;
+  return RoboCupSSLCompact::decode(compact,frame);
+}
+
+
+bool RoboCupSSLClient::parseBatchPacket(int index, bool latest_per_camera, int * camera_slot, int & geometry_slot) {
+  SSL_WrapperPacket * packet=packets[MaxBatch];
+  if (packet->ParseFromArray(batch_data[index],batch_sizes[index])==false) return false;
+  int slot=num_packets;
+  if (latest_per_camera) {
+    if (packet->has_detection()) {
+      const SSL_DetectionFrame & detection=packet->detection();
+      int camera=detection.camera_id();
+      if (camera >= 0 && camera < MaxCameras) {
+        if (detection.t_capture() <= last_t_capture[camera]) {
+          dropped++;
+          return false;
+        }
+        last_t_capture[camera]=detection.t_capture();
+        if (camera_slot[camera] >= 0) {
+          slot=camera_slot[camera];
+          dropped++;
+        }
+        camera_slot[camera]=slot;
+      }
+    } else if (packet->has_geometry()) {
+      if (geometry_slot >= 0) {
+        slot=geometry_slot;
+        dropped++;
+      }
+      geometry_slot=slot;
+    }
+  }
+  if (slot==MaxBatch) {
+    dropped++;
+    return false;
+  }
+  //keep the packet by exchanging it with the one of its slot:
+  packets[MaxBatch]=packets[slot];
+  packets[slot]=packet;
+  if (slot==num_packets) num_packets++;
+  return true;
+}
+
+int RoboCupSSLClient::receiveBatch(bool latest_per_camera) {
+  if (batch_data[0]==0) {
+    for (int i=0;i<MaxBatch;i++) batch_data[i]=new char[MaxDataGramSize];
+  }
+  if (packets[0]==0) {
+    for (int i=0;i<=MaxBatch;i++) packets[i]=new SSL_WrapperPacket();
+  }
+  num_packets=0;
+  int camera_slot[MaxCameras];
+  for (int i=0;i<MaxCameras;i++) camera_slot[i]=-1;
+  int geometry_slot=-1;
+  for (int batch=0; batch < (latest_per_camera ? MaxBatchesLatest : 1); batch++) {
+    int n=mc.recvBatch((void * const *)batch_data,MaxDataGramSize,batch_sizes,MaxBatch,batch > 0);
+    for (int i=0;i<n;i++) parseBatchPacket(i,latest_per_camera,camera_slot,geometry_slot);
+    //a full batch means that more datagrams may be pending. These are only
+    //read at once in latest mode, where the packets do not pile up:
+    if (n < MaxBatch) break;
+  }
+  return num_packets;
+}
+
+int RoboCupSSLClient::receiveRawBatch() {
+  if (batch_data[0]==0) {
+    for (int i=0;i<MaxBatch;i++) batch_data[i]=new char[MaxDataGramSize];
+  }
+  return mc.recvBatch((void * const *)batch_data,MaxDataGramSize,batch_sizes,MaxBatch,false);
+}
@@ -27,15 +27,50 @@
 #include "messages_robocup_ssl_geometry.pb.h"
 #include "messages_robocup_ssl_wrapper.pb.h"
 #include "messages_robocup_ssl_refbox_log.pb.h"
+#include "robocup_ssl_compact.h"
 using namespace std;
 /**
 	@author Author Name
+
+	receive() reads and parses one datagram into a packet of the caller.
+
+	receiveBatch() reads all pending datagrams with one recvmmsg() and
+	parses them into packets owned by the client, which are reused by the
+	next call, so that a warmed-up client receives without allocating. The
+	packets are read through getPacket() and are valid until the next call.
+	With \p latest_per_camera, only the newest detection of every camera
+	and the newest geometry are returned. Detections that are older than
+	one that was returned before are dropped as well, and all drops are
+	counted in getDropped().
+
+	receiveRawBatch() reads the pending datagrams in the same way but does
+	not parse them. Their bytes are read through getData(), e.g. to store
+	them unchanged.
+
+	A client on the port of the compact output (see "Network Output/Compact
+	Output" in vision) receives with receiveCompact() instead, which decodes
+	the SSL_CompactDetectionFrames to standard frames.
 */
 
 class RoboCupSSLClient{
 protected:
   static const int MaxDataGramSize = 65536;
+  static const int MaxBatch = 64;
+  static const int MaxCameras = 32;
+  static const int MaxBatchesLatest = 16; //recvmmsg calls per receiveBatch(true)
   char * in_buffer;
+
+  //receiveBatch():
+  char * batch_data[MaxBatch];
+  int batch_sizes[MaxBatch];
+  SSL_WrapperPacket * packets[MaxBatch+1]; //the last one is parsed into before it is kept
+  int num_packets;
+  long long dropped;
+  double last_t_capture[MaxCameras];
+
+  SSL_CompactDetectionFrame compact; //reused by receiveCompact()
+
+  bool parseBatchPacket(int index, bool latest_per_camera, int * camera_slot, int & geometry_slot);
   Net::UDP mc; // multicast client
   QMutex mutex;
   int _port;
@@ -50,6 +85,33 @@ public:
     bool open(bool blocking=false);
     void close();
     bool receive(SSL_WrapperPacket & packet);
+    /// receives one SSL_CompactDetectionFrame and decodes it into \p frame
+    bool receiveCompact(SSL_DetectionFrame & frame);
+    /// waits up to \p timeout_ms (forever if negative) for a packet
+    bool wait(int timeout_ms=-1) const;
+    /// sets the kernel receive buffer of an open client, see Net::UDP
+    int setReceiveBuffer(int size) {
+      return mc.setRecvBuffer(size);
+    }
+
+    /// receives all pending packets and returns their number
+    int receiveBatch(bool latest_per_camera=false);
+    const SSL_WrapperPacket & getPacket(int i) const {
+      return *packets[i];
+    }
+    long long getDropped() const {
+      return dropped;
+    }
+
+    /// receives all pending datagrams without parsing them and returns
+    /// their number
+    int receiveRawBatch();
+    const char * getData(int i) const {
+      return batch_data[i];
+    }
+    int getDataSize(int i) const {
+      return batch_sizes[i];
+    }
 
 };
 
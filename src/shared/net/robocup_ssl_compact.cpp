@@ -0,0 +1,170 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_compact.cpp
+  \brief   C++ Implementation: RoboCupSSLCompact
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_compact.h"
+#include <math.h>
+
+typedef ::google::protobuf::RepeatedField< ::google::protobuf::int32 > Int32List;
+
+static inline int quantize(double value, double scale) {
+  double v=value*scale;
+  //keep garbage from overflowing the difference of two values:
+  if (v > 1.0E9) v=1.0E9;
+  if (v < -1.0E9) v=-1.0E9;
+  return (int)lrint(v);
+}
+
+static inline unsigned int quantizeConfidence(float confidence) {
+  if (confidence <= 0.0f) return 0;
+  if (confidence >= 1.0f) return RoboCupSSLCompact::ConfidenceSteps;
+  return (unsigned int)lrintf(confidence*RoboCupSSLCompact::ConfidenceSteps);
+}
+
+static inline unsigned int quantizeOrientation(float orientation) {
+  int steps=quantize(orientation,RoboCupSSLCompact::OrientationSteps/(2.0*M_PI)) % RoboCupSSLCompact::OrientationSteps;
+  if (steps < 0) steps+=RoboCupSSLCompact::OrientationSteps;
+  return steps;
+}
+
+/// appends \p value as the difference to the previous value of the list
+static inline void addDelta(Int32List * list, int value, int & previous) {
+  list->Add(value - previous);
+  previous=value;
+}
+
+static void encodeBalls(const SSL_DetectionFrame & frame, SSL_CompactBalls * compact) {
+  int n=frame.balls_size();
+  bool area=false;
+  bool z=false;
+  for (int i=0;i<n;i++) {
+    area|=frame.balls(i).has_area();
+    z|=frame.balls(i).has_z();
+  }
+  int x=0,y=0,px=0,py=0;
+  for (int i=0;i<n;i++) {
+    const SSL_DetectionBall & ball=frame.balls(i);
+    compact->add_confidence(quantizeConfidence(ball.confidence()));
+    if (area) compact->add_area(ball.area());
+    addDelta(compact->mutable_x(),quantize(ball.x(),1.0),x);
+    addDelta(compact->mutable_y(),quantize(ball.y(),1.0),y);
+    if (z) compact->add_z(quantize(ball.z(),1.0));
+    addDelta(compact->mutable_pixel_x(),quantize(ball.pixel_x(),RoboCupSSLCompact::PixelScale),px);
+    addDelta(compact->mutable_pixel_y(),quantize(ball.pixel_y(),RoboCupSSLCompact::PixelScale),py);
+  }
+}
+
+static void encodeRobots(const ::google::protobuf::RepeatedPtrField<SSL_DetectionRobot> & robots, SSL_CompactRobots * compact) {
+  int n=robots.size();
+  bool height=false;
+  for (int i=0;i<n;i++) height|=robots.Get(i).has_height();
+  int x=0,y=0,px=0,py=0,h=0;
+  for (int i=0;i<n;i++) {
+    const SSL_DetectionRobot & robot=robots.Get(i);
+    compact->add_confidence(quantizeConfidence(robot.confidence()));
+    compact->add_robot_id(robot.has_robot_id() ? robot.robot_id()+1 : 0);
+    addDelta(compact->mutable_x(),quantize(robot.x(),1.0),x);
+    addDelta(compact->mutable_y(),quantize(robot.y(),1.0),y);
+    compact->add_orientation(robot.has_orientation() ? quantizeOrientation(robot.orientation()) : RoboCupSSLCompact::OrientationSteps);
+    addDelta(compact->mutable_pixel_x(),quantize(robot.pixel_x(),RoboCupSSLCompact::PixelScale),px);
+    addDelta(compact->mutable_pixel_y(),quantize(robot.pixel_y(),RoboCupSSLCompact::PixelScale),py);
+    if (height) addDelta(compact->mutable_height(),quantize(robot.height(),1.0),h);
+  }
+}
+
+void RoboCupSSLCompact::encode(const SSL_DetectionFrame & frame, SSL_CompactDetectionFrame & compact) {
+  //Clear() keeps the sub-messages and the capacity of the lists:
+  compact.Clear();
+  compact.set_frame_number(frame.frame_number());
+  compact.set_t_capture(frame.t_capture());
+  double t_processing=(frame.t_sent() - frame.t_capture())*1.0E6;
+  compact.set_t_processing(t_processing > 0.0 ? quantize(t_processing,1.0) : 0);
+  compact.set_camera_id(frame.camera_id());
+  if (frame.balls_size() > 0) encodeBalls(frame,compact.mutable_balls());
+  if (frame.robots_yellow_size() > 0) encodeRobots(frame.robots_yellow(),compact.mutable_robots_yellow());
+  if (frame.robots_blue_size() > 0) encodeRobots(frame.robots_blue(),compact.mutable_robots_blue());
+}
+
+static bool decodeBalls(const SSL_CompactBalls & compact, SSL_DetectionFrame & frame) {
+  int n=compact.confidence_size();
+  if (compact.x_size()!=n || compact.y_size()!=n || compact.pixel_x_size()!=n || compact.pixel_y_size()!=n ||
+      (compact.area_size()!=0 && compact.area_size()!=n) || (compact.z_size()!=0 && compact.z_size()!=n)) return false;
+  bool area=(compact.area_size() > 0);
+  bool z=(compact.z_size() > 0);
+  int x=0,y=0,px=0,py=0;
+  for (int i=0;i<n;i++) {
+    SSL_DetectionBall * ball=frame.add_balls();
+    x+=compact.x(i);
+    y+=compact.y(i);
+    px+=compact.pixel_x(i);
+    py+=compact.pixel_y(i);
+    ball->set_confidence(compact.confidence(i)*(1.0f/RoboCupSSLCompact::ConfidenceSteps));
+    if (area) ball->set_area(compact.area(i));
+    ball->set_x(x);
+    ball->set_y(y);
+    if (z) ball->set_z(compact.z(i));
+    ball->set_pixel_x(px*(1.0f/RoboCupSSLCompact::PixelScale));
+    ball->set_pixel_y(py*(1.0f/RoboCupSSLCompact::PixelScale));
+  }
+  return true;
+}
+
+static bool decodeRobots(const SSL_CompactRobots & compact, ::google::protobuf::RepeatedPtrField<SSL_DetectionRobot> * robots) {
+  int n=compact.confidence_size();
+  if (compact.robot_id_size()!=n || compact.x_size()!=n || compact.y_size()!=n || compact.orientation_size()!=n ||
+      compact.pixel_x_size()!=n || compact.pixel_y_size()!=n || (compact.height_size()!=0 && compact.height_size()!=n)) return false;
+  bool height=(compact.height_size() > 0);
+  int x=0,y=0,px=0,py=0,h=0;
+  for (int i=0;i<n;i++) {
+    SSL_DetectionRobot * robot=robots->Add();
+    x+=compact.x(i);
+    y+=compact.y(i);
+    px+=compact.pixel_x(i);
+    py+=compact.pixel_y(i);
+    robot->set_confidence(compact.confidence(i)*(1.0f/RoboCupSSLCompact::ConfidenceSteps));
+    if (compact.robot_id(i)!=0) robot->set_robot_id(compact.robot_id(i)-1);
+    robot->set_x(x);
+    robot->set_y(y);
+    unsigned int orientation=compact.orientation(i);
+    if (orientation < (unsigned int)RoboCupSSLCompact::OrientationSteps) {
+      double angle=orientation*(2.0*M_PI/RoboCupSSLCompact::OrientationSteps);
+      if (angle > M_PI) angle-=2.0*M_PI;
+      robot->set_orientation(angle);
+    }
+    robot->set_pixel_x(px*(1.0f/RoboCupSSLCompact::PixelScale));
+    robot->set_pixel_y(py*(1.0f/RoboCupSSLCompact::PixelScale));
+    if (height) {
+      h+=compact.height(i);
+      robot->set_height(h);
+    }
+  }
+  return true;
+}
+
+bool RoboCupSSLCompact::decode(const SSL_CompactDetectionFrame & compact, SSL_DetectionFrame & frame) {
+  frame.Clear();
+  frame.set_frame_number(compact.frame_number());
+  frame.set_t_capture(compact.t_capture());
+  frame.set_t_sent(compact.t_capture() + compact.t_processing()*1.0E-6);
+  frame.set_camera_id(compact.camera_id());
+  if (compact.has_balls() && decodeBalls(compact.balls(),frame)==false) return false;
+  if (compact.has_robots_yellow() && decodeRobots(compact.robots_yellow(),frame.mutable_robots_yellow())==false) return false;
+  if (compact.has_robots_blue() && decodeRobots(compact.robots_blue(),frame.mutable_robots_blue())==false) return false;
+  return true;
+}
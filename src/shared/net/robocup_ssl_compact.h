@@ -0,0 +1,50 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_compact.h
+  \brief   C++ Interface: RoboCupSSLCompact
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_COMPACT_H
+#define ROBOCUP_SSL_COMPACT_H
+#include "messages_robocup_ssl_detection.pb.h"
+#include "messages_robocup_ssl_detection_compact.pb.h"
+
+/*!
+  \class   RoboCupSSLCompact
+  \brief   Converts between SSL_DetectionFrame and the quantized SSL_CompactDetectionFrame
+
+  The compact frame keeps positions to 1 mm, pixel coordinates to 1/4
+  pixel, orientations to 1/4096 turn, confidences to 1/255 and times to
+  1 microsecond (see messages_robocup_ssl_detection_compact.proto). A
+  decoded frame therefore differs from the original by at most half of
+  these steps, and has the same balls and robots in the same order.
+
+  Both functions reuse the messages they write to, so encoding and
+  decoding into the same message again does not allocate.
+*/
+class RoboCupSSLCompact {
+public:
+  static const int PixelScale=4;        //steps per pixel
+  static const int OrientationSteps=4096; //steps per turn
+  static const int ConfidenceSteps=255;
+
+  static void encode(const SSL_DetectionFrame & frame, SSL_CompactDetectionFrame & compact);
+  /// returns false if the lists of \p compact do not have matching sizes
+  static bool decode(const SSL_CompactDetectionFrame & compact, SSL_DetectionFrame & frame);
+};
+
+#endif
@@ -0,0 +1,99 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_log.h
+  \brief   C++ Interface: RoboCupSSLLog
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_LOG_H
+#define ROBOCUP_SSL_LOG_H
+#include <stdint.h>
+#include <stddef.h>
+
+/*!
+  \class   RoboCupSSLLog
+  \brief   The layout of the indexed log files, shared by their writer and reader
+
+  A log file is a header, a sequence of chunks, the index of the chunks
+  and a trailer:
+
+    Header | Chunk | Chunk | ... | IndexEntry[chunks] | Trailer
+
+  A chunk is a ChunkHeader followed by its records. Every record is a
+  RecordHeader with its time, type and size, followed by the serialized
+  message, padded to 8 bytes.
+
+  The index holds the offset, the number of the first record and the time
+  range of every chunk, so that a reader seeks by record number or time
+  with a binary search and a scan of one chunk. A file without a trailer
+  (e.g. of a recorder that was killed) is read by following the chunk
+  headers instead, up to the last complete chunk.
+
+  All fields are little-endian and have fixed sizes.
+*/
+class RoboCupSSLLog {
+public:
+  static const uint32_t Magic=0x474f4c53;      //"SLOG"
+  static const uint32_t ChunkMagic=0x4b4e4843; //"CHNK"
+  static const uint32_t IndexMagic=0x58444e49; //"INDX"
+  static const uint32_t Version=1;
+
+  enum RecordType {
+    RecordWrapperPacket=1, //an SSL_WrapperPacket, at its time of reception
+    RecordLogFrame=2       //a Log_Frame of a Refbox_Log, at its t_capture
+  };
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint8_t reserved[8];
+  };
+
+  struct ChunkHeader {
+    uint32_t magic;
+    uint32_t records;
+    uint64_t size;      //bytes of the records that follow
+    double t_first;
+    double t_last;
+  };
+
+  struct RecordHeader {
+    double t;
+    uint32_t type;
+    uint32_t size;      //bytes of the message, without the padding
+  };
+
+  struct IndexEntry {
+    uint64_t offset;    //of the ChunkHeader
+    uint64_t first_record;
+    double t_first;
+    double t_last;
+  };
+
+  struct Trailer {
+    uint32_t magic;
+    uint32_t chunks;
+    uint64_t records;
+    uint64_t index_offset;
+    uint8_t reserved[8];
+  };
+
+  static size_t recordStride(uint32_t size) {
+    return sizeof(RecordHeader) + ((size + 7) & ~(size_t)7);
+  }
+};
+
+#endif
@@ -0,0 +1,213 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_log_reader.cpp
+  \brief   C++ Implementation: RoboCupSSLLogReader
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_log_reader.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+RoboCupSSLLogReader::RoboCupSSLLogReader()
+{
+  fd=-1;
+  data=0;
+  size=0;
+  records=0;
+  cursor_record=0;
+  cursor_offset=0;
+  cursor_chunk=-1;
+}
+
+RoboCupSSLLogReader::~RoboCupSSLLogReader()
+{
+  close();
+}
+
+bool RoboCupSSLLogReader::isLogFile(const string & filename) {
+  FILE * f=fopen(filename.c_str(),"rb");
+  if (f==0) return false;
+  RoboCupSSLLog::Header header;
+  bool result=(fread(&header,sizeof(header),1,f)==1 && header.magic==RoboCupSSLLog::Magic);
+  fclose(f);
+  return result;
+}
+
+bool RoboCupSSLLogReader::open(const string & filename) {
+  close();
+  fd=::open(filename.c_str(),O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd,&st)!=0 || (size_t)st.st_size < sizeof(RoboCupSSLLog::Header)) {
+    fprintf(stderr,"Unable to read log file %s\n",filename.c_str());
+    close();
+    return false;
+  }
+  size=st.st_size;
+  void * p=mmap(0,size,PROT_READ,MAP_SHARED,fd,0);
+  if (p==MAP_FAILED) {
+    fprintf(stderr,"Unable to map log file %s\n",filename.c_str());
+    close();
+    return false;
+  }
+  data=(const char *)p;
+  const RoboCupSSLLog::Header * header=(const RoboCupSSLLog::Header *)data;
+  if (header->magic!=RoboCupSSLLog::Magic || header->version!=RoboCupSSLLog::Version) {
+    fprintf(stderr,"%s is not a log file of version %d\n",filename.c_str(),RoboCupSSLLog::Version);
+    close();
+    return false;
+  }
+  if (readIndex()==false) {
+    rebuildIndex();
+    fprintf(stderr,"Log file %s has no index, found %lld record(s) in %d complete chunk(s)\n",
+            filename.c_str(),(long long)records,(int)index.size());
+  }
+  return true;
+}
+
+void RoboCupSSLLogReader::close() {
+  if (data!=0) munmap((void *)data,size);
+  data=0;
+  size=0;
+  if (fd >= 0) ::close(fd);
+  fd=-1;
+  index.clear();
+  records=0;
+  cursor_chunk=-1;
+}
+
+bool RoboCupSSLLogReader::readIndex() {
+  if (size < sizeof(RoboCupSSLLog::Header) + sizeof(RoboCupSSLLog::Trailer)) return false;
+  const RoboCupSSLLog::Trailer * trailer=(const RoboCupSSLLog::Trailer *)(data + size - sizeof(RoboCupSSLLog::Trailer));
+  if (trailer->magic!=RoboCupSSLLog::IndexMagic ||
+      trailer->index_offset + (uint64_t)trailer->chunks*sizeof(RoboCupSSLLog::IndexEntry) + sizeof(RoboCupSSLLog::Trailer)!=size) return false;
+  const RoboCupSSLLog::IndexEntry * entries=(const RoboCupSSLLog::IndexEntry *)(data + trailer->index_offset);
+  index.assign(entries,entries + trailer->chunks);
+  records=trailer->records;
+  for (unsigned int i=0;i<index.size();i++) {
+    if (index[i].offset + sizeof(RoboCupSSLLog::ChunkHeader) > trailer->index_offset) {
+      index.clear();
+      records=0;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RoboCupSSLLogReader::rebuildIndex() {
+  index.clear();
+  records=0;
+  size_t offset=sizeof(RoboCupSSLLog::Header);
+  while (offset + sizeof(RoboCupSSLLog::ChunkHeader) <= size) {
+    const RoboCupSSLLog::ChunkHeader * chunk=(const RoboCupSSLLog::ChunkHeader *)(data + offset);
+    if (chunk->magic!=RoboCupSSLLog::ChunkMagic || chunk->size > size - offset - sizeof(RoboCupSSLLog::ChunkHeader)) break;
+    RoboCupSSLLog::IndexEntry entry;
+    entry.offset=offset;
+    entry.first_record=records;
+    entry.t_first=chunk->t_first;
+    entry.t_last=chunk->t_last;
+    index.push_back(entry);
+    records+=chunk->records;
+    offset+=sizeof(RoboCupSSLLog::ChunkHeader) + chunk->size;
+  }
+  return index.empty()==false;
+}
+
+double RoboCupSSLLogReader::getStartTime() const {
+  return index.empty() ? 0.0 : index.front().t_first;
+}
+
+double RoboCupSSLLogReader::getEndTime() const {
+  return index.empty() ? 0.0 : index.back().t_last;
+}
+
+bool RoboCupSSLLogReader::seek(uint64_t n) {
+  if (n >= records) return false;
+  if (cursor_chunk >= 0 && n==cursor_record) return true;
+  const RoboCupSSLLog::IndexEntry * entry;
+  uint64_t record;
+  size_t offset;
+  if (cursor_chunk >= 0 && n > cursor_record) {
+    //continue from the cursor if n is in its chunk:
+    entry=&index[cursor_chunk];
+    const RoboCupSSLLog::ChunkHeader * chunk=(const RoboCupSSLLog::ChunkHeader *)(data + entry->offset);
+    if (n >= entry->first_record + chunk->records) entry=0;
+    record=cursor_record;
+    offset=cursor_offset;
+  } else {
+    entry=0;
+  }
+  if (entry==0) {
+    //the last chunk that starts at or before n:
+    int lo=0;
+    int hi=(int)index.size() - 1;
+    while (lo < hi) {
+      int mid=(lo + hi + 1)/2;
+      if (index[mid].first_record <= n) lo=mid; else hi=mid - 1;
+    }
+    entry=&index[lo];
+    record=entry->first_record;
+    offset=entry->offset + sizeof(RoboCupSSLLog::ChunkHeader);
+  }
+  const RoboCupSSLLog::ChunkHeader * chunk=(const RoboCupSSLLog::ChunkHeader *)(data + entry->offset);
+  size_t end=entry->offset + sizeof(RoboCupSSLLog::ChunkHeader) + chunk->size;
+  if (chunk->magic!=RoboCupSSLLog::ChunkMagic || end > size || n >= entry->first_record + chunk->records) return false;
+  while (true) {
+    if (offset + sizeof(RoboCupSSLLog::RecordHeader) > end) return false;
+    const RoboCupSSLLog::RecordHeader * header=(const RoboCupSSLLog::RecordHeader *)(data + offset);
+    size_t stride=RoboCupSSLLog::recordStride(header->size);
+    if (stride > end - offset) return false;
+    if (record==n) break;
+    offset+=stride;
+    record++;
+  }
+  cursor_chunk=entry - &index[0];
+  cursor_record=record;
+  cursor_offset=offset;
+  return true;
+}
+
+long long RoboCupSSLLogReader::findTime(double t) {
+  //the first chunk that ends at or after t:
+  int lo=0;
+  int hi=(int)index.size();
+  while (lo < hi) {
+    int mid=(lo + hi)/2;
+    if (index[mid].t_last < t) lo=mid + 1; else hi=mid;
+  }
+  if (lo==(int)index.size()) return records;
+  long long n=index[lo].first_record;
+  double t_record;
+  int type;
+  const char * message;
+  int message_size;
+  while (read(n,t_record,type,message,message_size) && t_record < t) n++;
+  return n;
+}
+
+bool RoboCupSSLLogReader::read(long long n, double & t, int & type, const char * & message, int & message_size) {
+  if (n < 0 || seek(n)==false) return false;
+  const RoboCupSSLLog::RecordHeader * header=(const RoboCupSSLLog::RecordHeader *)(data + cursor_offset);
+  t=header->t;
+  type=header->type;
+  message=data + cursor_offset + sizeof(RoboCupSSLLog::RecordHeader);
+  message_size=header->size;
+  return true;
+}
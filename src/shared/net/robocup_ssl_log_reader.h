@@ -0,0 +1,82 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_log_reader.h
+  \brief   C++ Interface: RoboCupSSLLogReader
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_LOG_READER_H
+#define ROBOCUP_SSL_LOG_READER_H
+#include <string>
+#include <vector>
+#include "robocup_ssl_log.h"
+using namespace std;
+
+/*!
+  \class   RoboCupSSLLogReader
+  \brief   Reads the records of an indexed log file (see RoboCupSSLLog)
+
+  The file is mapped into memory, and only the chunk index is read by
+  open(), so a log of any size opens at once and is read with constant
+  memory. The messages are not copied: read() returns a pointer into the
+  mapping, which is valid until close().
+
+  Reading the next or the previous record continues from the last one. Any
+  other record is found with a binary search of the index and a scan of
+  its chunk.
+*/
+class RoboCupSSLLogReader {
+protected:
+  int fd;
+  const char * data;
+  size_t size;
+  vector<RoboCupSSLLog::IndexEntry> index;
+  uint64_t records;
+  //the last record that was read:
+  uint64_t cursor_record;
+  size_t cursor_offset;
+  int cursor_chunk;
+
+  bool readIndex();
+  bool rebuildIndex();
+  /// finds record \p n and sets the cursor to it
+  bool seek(uint64_t n);
+public:
+  RoboCupSSLLogReader();
+  ~RoboCupSSLLogReader();
+
+  bool open(const string & filename);
+  void close();
+  bool isOpen() const {
+    return data!=0;
+  }
+  /// true if \p filename starts like an indexed log file
+  static bool isLogFile(const string & filename);
+
+  long long getRecordCount() const {
+    return records;
+  }
+  double getStartTime() const;
+  double getEndTime() const;
+  /// the number of the first record at or after \p t, or the number of
+  /// records if there is none
+  long long findTime(double t);
+
+  /// gets record \p n, or returns false if it does not exist
+  bool read(long long n, double & t, int & type, const char * & message, int & message_size);
+};
+
+#endif
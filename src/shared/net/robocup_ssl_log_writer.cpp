@@ -0,0 +1,214 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_log_writer.cpp
+  \brief   C++ Implementation: RoboCupSSLLogWriter
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_log_writer.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/wire_format_lite.h>
+
+using google::protobuf::uint8;
+using google::protobuf::uint32;
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::FileInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+RoboCupSSLLogWriter::RoboCupSSLLogWriter(size_t chunk_size)
+{
+  f=0;
+  chunk_capacity=(chunk_size > 4096 ? chunk_size : 4096);
+  chunk=new char[chunk_capacity];
+  chunk_used=sizeof(RoboCupSSLLog::ChunkHeader);
+  offset=0;
+  records=0;
+}
+
+RoboCupSSLLogWriter::~RoboCupSSLLogWriter()
+{
+  close();
+  delete[] chunk;
+}
+
+bool RoboCupSSLLogWriter::open(const string & filename) {
+  close();
+  f=fopen(filename.c_str(),"wb");
+  if (f==0) {
+    fprintf(stderr,"Unable to create log file %s\n",filename.c_str());
+    return false;
+  }
+  _filename=filename;
+  chunk_used=sizeof(RoboCupSSLLog::ChunkHeader);
+  records=0;
+  index.clear();
+  RoboCupSSLLog::Header header;
+  memset(&header,0,sizeof(header));
+  header.magic=RoboCupSSLLog::Magic;
+  header.version=RoboCupSSLLog::Version;
+  offset=0;
+  if (writeData((const char *)&header,sizeof(header))==false) {
+    fprintf(stderr,"Writing log file %s failed\n",filename.c_str());
+    fclose(f);
+    f=0;
+    return false;
+  }
+  offset=sizeof(header);
+  return true;
+}
+
+bool RoboCupSSLLogWriter::close() {
+  if (f==0) return true;
+  bool result=writeChunk();
+  RoboCupSSLLog::Trailer trailer;
+  memset(&trailer,0,sizeof(trailer));
+  trailer.magic=RoboCupSSLLog::IndexMagic;
+  trailer.chunks=index.size();
+  trailer.records=records;
+  trailer.index_offset=offset;
+  if (result && index.empty()==false) {
+    result=writeData((const char *)&index[0],index.size()*sizeof(RoboCupSSLLog::IndexEntry));
+  }
+  if (result) result=writeData((const char *)&trailer,sizeof(trailer));
+  if (fclose(f)!=0) result=false;
+  f=0;
+  if (result==false) fprintf(stderr,"Writing log file %s failed\n",_filename.c_str());
+  return result;
+}
+
+bool RoboCupSSLLogWriter::writeData(const char * data, size_t size) {
+  return fwrite(data,1,size,f)==size;
+}
+
+bool RoboCupSSLLogWriter::writeChunk() {
+  size_t size=chunk_used - sizeof(RoboCupSSLLog::ChunkHeader);
+  if (size==0) return true;
+  RoboCupSSLLog::ChunkHeader * header=(RoboCupSSLLog::ChunkHeader *)chunk;
+  RoboCupSSLLog::IndexEntry entry;
+  entry.offset=offset;
+  entry.first_record=records - header->records;
+  entry.t_first=header->t_first;
+  entry.t_last=header->t_last;
+  header->magic=RoboCupSSLLog::ChunkMagic;
+  header->size=size;
+  chunk_used=sizeof(RoboCupSSLLog::ChunkHeader);
+  if (writeData(chunk,sizeof(RoboCupSSLLog::ChunkHeader) + size)==false) {
+    fprintf(stderr,"Writing log file %s failed\n",_filename.c_str());
+    return false;
+  }
+  index.push_back(entry);
+  offset+=sizeof(RoboCupSSLLog::ChunkHeader) + size;
+  return true;
+}
+
+char * RoboCupSSLLogWriter::beginRecord(double t, int type, int size) {
+  if (f==0 || size < 0) return 0;
+  size_t stride=RoboCupSSLLog::recordStride(size);
+  if (chunk_used + stride > chunk_capacity) {
+    if (writeChunk()==false) return 0;
+    //a record that is larger than a chunk gets a chunk of its own:
+    if (sizeof(RoboCupSSLLog::ChunkHeader) + stride > chunk_capacity) {
+      delete[] chunk;
+      chunk_capacity=sizeof(RoboCupSSLLog::ChunkHeader) + stride;
+      chunk=new char[chunk_capacity];
+    }
+  }
+  RoboCupSSLLog::ChunkHeader * header=(RoboCupSSLLog::ChunkHeader *)chunk;
+  if (chunk_used==sizeof(RoboCupSSLLog::ChunkHeader)) {
+    header->records=0;
+    header->t_first=t;
+  }
+  header->records++;
+  header->t_last=t;
+  RoboCupSSLLog::RecordHeader * record=(RoboCupSSLLog::RecordHeader *)(chunk + chunk_used);
+  record->t=t;
+  record->type=type;
+  record->size=size;
+  char * data=chunk + chunk_used + sizeof(RoboCupSSLLog::RecordHeader);
+  //zero the padding, so that files are reproducible:
+  memset(data + size,0,stride - sizeof(RoboCupSSLLog::RecordHeader) - size);
+  chunk_used+=stride;
+  records++;
+  return data;
+}
+
+bool RoboCupSSLLogWriter::write(double t, int type, const char * data, int size) {
+  char * buffer=beginRecord(t,type,size);
+  if (buffer==0) return false;
+  memcpy(buffer,data,size);
+  return true;
+}
+
+bool RoboCupSSLLogWriter::write(double t, const SSL_WrapperPacket & packet) {
+  int size=packet.ByteSize();
+  char * buffer=beginRecord(t,RoboCupSSLLog::RecordWrapperPacket,size);
+  if (buffer==0) return false;
+  packet.SerializeWithCachedSizesToArray((uint8 *)buffer);
+  return true;
+}
+
+bool RoboCupSSLLogWriter::write(const Log_Frame & frame) {
+  int size=frame.ByteSize();
+  char * buffer=beginRecord(frame.frame().t_capture(),RoboCupSSLLog::RecordLogFrame,size);
+  if (buffer==0) return false;
+  frame.SerializeWithCachedSizesToArray((uint8 *)buffer);
+  return true;
+}
+
+long long RoboCupSSLLogWriter::convertRefboxLog(const string & filename) {
+  int fd=::open(filename.c_str(),O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr,"Unable to open %s\n",filename.c_str());
+    return -1;
+  }
+  //a Refbox_Log is a sequence of its field 1, one for every Log_Frame:
+  const uint32 frame_tag=WireFormatLite::MakeTag(Refbox_Log::kLogFieldNumber,WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  FileInputStream input(fd);
+  Log_Frame frame;
+  long long frames=0;
+  bool ok=true;
+  while (ok) {
+    //a new stream for every frame keeps the total byte limit of
+    //CodedInputStream from ending the conversion of large files:
+    CodedInputStream coded(&input);
+    uint32 tag=coded.ReadTag();
+    if (tag==0) break;
+    if (tag!=frame_tag) {
+      ok=WireFormatLite::SkipField(&coded,tag);
+      continue;
+    }
+    uint32 length;
+    if (coded.ReadVarint32(&length)==false) {
+      ok=false;
+      break;
+    }
+    CodedInputStream::Limit limit=coded.PushLimit(length);
+    ok=frame.ParseFromCodedStream(&coded) && coded.ConsumedEntireMessage();
+    coded.PopLimit(limit);
+    if (ok) ok=write(frame);
+    if (ok) frames++;
+  }
+  ::close(fd);
+  if (ok==false) {
+    fprintf(stderr,"%s is not a complete Refbox_Log, converted %lld frame(s)\n",filename.c_str(),frames);
+    return -1;
+  }
+  return frames;
+}
@@ -0,0 +1,88 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_log_writer.h
+  \brief   C++ Interface: RoboCupSSLLogWriter
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_LOG_WRITER_H
+#define ROBOCUP_SSL_LOG_WRITER_H
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "robocup_ssl_log.h"
+#include "messages_robocup_ssl_wrapper.pb.h"
+#include "messages_robocup_ssl_refbox_log.pb.h"
+using namespace std;
+
+/*!
+  \class   RoboCupSSLLogWriter
+  \brief   Writes an indexed log file (see RoboCupSSLLog)
+
+  Records are serialized directly into the current chunk, which is written
+  with writeData() once it is full, so a record costs no system call. The
+  index and the trailer are written by close().
+
+  convertRefboxLog() reads the frames of a Refbox_Log one by one, so that
+  old logs of any size are converted with constant memory.
+*/
+class RoboCupSSLLogWriter {
+protected:
+  FILE * f;
+  string _filename;
+  char * chunk;              //the ChunkHeader followed by the records
+  size_t chunk_capacity;
+  size_t chunk_used;
+  uint64_t offset;           //of the next chunk in the file
+  uint64_t records;
+  vector<RoboCupSSLLog::IndexEntry> index;
+
+  /// returns the memory for the message of a new record, or 0 on errors
+  char * beginRecord(double t, int type, int size);
+  bool writeChunk();
+  /// writes \p size bytes at the end of the file
+  virtual bool writeData(const char * data, size_t size);
+public:
+  RoboCupSSLLogWriter(size_t chunk_size=262144);
+  virtual ~RoboCupSSLLogWriter();
+
+  bool open(const string & filename);
+  /// writes the remaining records and the index, and closes the file
+  bool close();
+  bool isOpen() const {
+    return f!=0;
+  }
+
+  bool write(double t, int type, const char * data, int size);
+  /// writes \p packet as a RecordWrapperPacket at time \p t
+  bool write(double t, const SSL_WrapperPacket & packet);
+  /// writes \p frame as a RecordLogFrame at its t_capture
+  bool write(const Log_Frame & frame);
+
+  /// writes all frames of the Refbox_Log \p filename and returns their
+  /// number, or -1 if it could not be read
+  long long convertRefboxLog(const string & filename);
+
+  long long getRecordCount() const {
+    return records;
+  }
+  /// the size of the file once the current chunk is written
+  long long getSize() const {
+    return offset + chunk_used;
+  }
+};
+
+#endif
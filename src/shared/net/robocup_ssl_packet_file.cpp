@@ -0,0 +1,94 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_packet_file.cpp
+  \brief   C++ Implementation: robocup_ssl_packet_file
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_packet_file.h"
+
+RoboCupSSLPacketFile::RoboCupSSLPacketFile()
+{
+  f=0;
+  packets=0;
+}
+
+RoboCupSSLPacketFile::~RoboCupSSLPacketFile()
+{
+  closeFile();
+}
+
+bool RoboCupSSLPacketFile::openFile(const char * filename) {
+  closeFile();
+  mutex.lock();
+  f=fopen(filename,"wb");
+  mutex.unlock();
+  if (f==0) {
+    fprintf(stderr,"Unable to create packet file %s\n",filename);
+    return false;
+  }
+  return true;
+}
+
+void RoboCupSSLPacketFile::closeFile() {
+  mutex.lock();
+  if (f!=0) fclose(f);
+  f=0;
+  mutex.unlock();
+}
+
+bool RoboCupSSLPacketFile::sendData(const char * data, int size) {
+  bool result=true;
+  mutex.lock();
+  if (f!=0) {
+    unsigned char prefix[5];
+    int n=0;
+    unsigned int length=size;
+    while (length >= 0x80) {
+      prefix[n++]=(unsigned char)(length | 0x80);
+      length>>=7;
+    }
+    prefix[n++]=(unsigned char)length;
+    result=(fwrite(prefix,1,n,f)==(size_t)n && fwrite(data,1,size,f)==(size_t)size);
+    if (result) {
+      packets++;
+    } else {
+      fprintf(stderr,"Writing packet failed. Size was: %d byte(s)\n",size);
+    }
+  }
+  mutex.unlock();
+  return result;
+}
+
+long long RoboCupSSLPacketFile::getPacketCount() {
+  mutex.lock();
+  long long n=packets;
+  mutex.unlock();
+  return n;
+}
+
+bool RoboCupSSLPacketFile::readPacket(FILE * in, SSL_WrapperPacket & packet, string & buffer) {
+  unsigned int size=0;
+  int c;
+  for (int shift=0;;shift+=7) {
+    if (shift > 28 || (c=fgetc(in))==EOF) return false;
+    size|=(unsigned int)(c & 0x7f) << shift;
+    if ((c & 0x80)==0) break;
+  }
+  buffer.resize(size);
+  if (size > 0 && fread(&buffer[0],1,size,in)!=size) return false;
+  return packet.ParseFromString(buffer);
+}
@@ -0,0 +1,54 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_packet_file.h
+  \brief   C++ Interface: robocup_ssl_packet_file
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_PACKET_FILE_H
+#define ROBOCUP_SSL_PACKET_FILE_H
+#include <stdio.h>
+#include "robocup_ssl_server.h"
+
+/*!
+  \class   RoboCupSSLPacketFile
+  \brief   A RoboCupSSLServer that writes its packets to a file instead of the network
+
+  Each SSL_WrapperPacket is stored length-delimited: its size as a base-128
+  varint followed by the serialized packet (the same framing as protobuf's
+  writeDelimitedTo / parseDelimitedFrom).
+  If no file is open, packets are discarded.
+*/
+class RoboCupSSLPacketFile : public RoboCupSSLServer {
+protected:
+  FILE * f;
+  long long packets;
+  virtual bool sendData(const char * data, int size);
+public:
+  RoboCupSSLPacketFile();
+  virtual ~RoboCupSSLPacketFile();
+
+  bool openFile(const char * filename);
+  void closeFile();
+
+  /// number of packets written so far
+  long long getPacketCount();
+
+  /// reads the next length-delimited packet from \p in. returns false at the end of the file.
+  static bool readPacket(FILE * in, SSL_WrapperPacket & packet, string & buffer);
+};
+
+#endif
@@ -19,6 +19,41 @@
 */
 //========================================================================
 #include "robocup_ssl_server.h"
+#include "robocup_ssl_shm_server.h"
+#include "tracer.h"
+#include <pthread.h>
+#include <google/protobuf/io/coded_stream.h>
+
+using google::protobuf::uint8;
+using google::protobuf::uint32;
+using google::protobuf::io::CodedOutputStream;
+
+//the serialization buffers of the sending threads. A buffer holds the
+//largest UDP datagram, so it is only reallocated for larger file output,
+//and it is freed when its thread exits:
+static __thread char * send_buffer=0;
+static __thread int send_buffer_size=0;
+static pthread_key_t send_buffer_key;
+static pthread_once_t send_buffer_once=PTHREAD_ONCE_INIT;
+
+static void deleteSendBuffer(void * buffer) {
+  delete[] (char *)buffer;
+}
+
+static void createSendBufferKey() {
+  pthread_key_create(&send_buffer_key,deleteSendBuffer);
+}
+
+char * RoboCupSSLServer::getSendBuffer(int size) {
+  if (size > send_buffer_size) {
+    pthread_once(&send_buffer_once,createSendBufferKey);
+    delete[] send_buffer;
+    send_buffer_size=(size > 65536 ? size : 65536);
+    send_buffer=new char[send_buffer_size];
+    pthread_setspecific(send_buffer_key,send_buffer);
+  }
+  return send_buffer;
+}
 
 RoboCupSSLServer::RoboCupSSLServer(int port,
                      string net_address,
@@ -27,7 +62,7 @@ RoboCupSSLServer::RoboCupSSLServer(int port,
   _port=port;
   _net_address=net_address;
   _net_interface=net_interface;
-
+  shm_output=0;
 }
 
 
@@ -65,26 +100,49 @@ bool RoboCupSSLServer::open() {
   return(true);
 }
 
-bool RoboCupSSLServer::send(const SSL_WrapperPacket & packet) {
-  string buffer;
-  packet.SerializeToString(&buffer);
+void RoboCupSSLServer::setSharedMemoryOutput(RoboCupSSLShmServer * output) {
+  shm_output=output;
+}
+
+bool RoboCupSSLServer::sendData(const char * data, int size) {
   Net::Address multiaddr;
   multiaddr.setHost(_net_address.c_str(),_port);
   bool result;
   mutex.lock();
-  result=mc.send(buffer.c_str(),buffer.length(),multiaddr);
+  result=mc.send(data,size,multiaddr);
   mutex.unlock();
   if (result==false) {
-    fprintf(stderr,"Sending UDP datagram failed (maybe too large?). Size was: %zu byte(s)\n",buffer.length());
+    fprintf(stderr,"Sending UDP datagram failed (maybe too large?). Size was: %d byte(s)\n",size);
   }
   return(result);
 }
 
+bool RoboCupSSLServer::sendSerialized(const char * data, int size) {
+  if (shm_output!=0) shm_output->publish(data,size);
+  return sendData(data,size);
+}
+
+bool RoboCupSSLServer::send(const SSL_WrapperPacket & packet) {
+  TRACE_SPAN("udp send");
+  int size=packet.ByteSize();
+  char * buffer=getSendBuffer(size);
+  packet.SerializeWithCachedSizesToArray((uint8 *)buffer);
+  return sendSerialized(buffer,size);
+}
+
 bool RoboCupSSLServer::send(const SSL_DetectionFrame & frame) {
-  SSL_WrapperPacket pkt;
-  SSL_DetectionFrame * nframe = pkt.mutable_detection();
-  nframe->CopyFrom(frame);
-  return send(pkt);
+  TRACE_SPAN("udp send");
+  //the bytes of an SSL_WrapperPacket that only has its detection set: the
+  //tag of field 1 with wire type 2 (length-delimited), the size of the
+  //frame as a varint, and the frame:
+  int frame_size=frame.ByteSize();
+  uint32 tag=(SSL_WrapperPacket::kDetectionFieldNumber << 3) | 2;
+  int size=CodedOutputStream::VarintSize32(tag)+CodedOutputStream::VarintSize32(frame_size)+frame_size;
+  char * buffer=getSendBuffer(size);
+  uint8 * p=CodedOutputStream::WriteVarint32ToArray(tag,(uint8 *)buffer);
+  p=CodedOutputStream::WriteVarint32ToArray(frame_size,p);
+  frame.SerializeWithCachedSizesToArray(p);
+  return sendSerialized(buffer,size);
 }
 
 bool RoboCupSSLServer::send(const SSL_GeometryData & geometry) {
@@ -94,3 +152,18 @@ bool RoboCupSSLServer::send(const SSL_GeometryData & geometry) {
   return send(pkt);
 }
 
+bool RoboCupSSLServer::send(const SSL_DetectionCycle & cycle) {
+  TRACE_SPAN("udp send");
+  int size=cycle.ByteSize();
+  char * buffer=getSendBuffer(size);
+  cycle.SerializeWithCachedSizesToArray((uint8 *)buffer);
+  return sendData(buffer,size);
+}
+
+bool RoboCupSSLServer::send(const SSL_CompactDetectionFrame & frame) {
+  TRACE_SPAN("udp send");
+  int size=frame.ByteSize();
+  char * buffer=getSendBuffer(size);
+  frame.SerializeWithCachedSizesToArray((uint8 *)buffer);
+  return sendData(buffer,size);
+}
@@ -26,7 +26,10 @@
 #include "messages_robocup_ssl_detection.pb.h"
 #include "messages_robocup_ssl_geometry.pb.h"
 #include "messages_robocup_ssl_wrapper.pb.h"
+#include "messages_robocup_ssl_detection_cycle.pb.h"
+#include "messages_robocup_ssl_detection_compact.pb.h"
 using namespace std;
+class RoboCupSSLShmServer;
 /**
 	@author Stefan Zickler
 */
@@ -38,18 +41,38 @@ protected:
   int _port;
   string _net_address;
   string _net_interface;
+  RoboCupSSLShmServer * shm_output;
+
+  /// the serialization buffer of the calling thread, with room for at least \p size bytes
+  static char * getSendBuffer(int size);
+  /// sends one serialized SSL_WrapperPacket; subclasses redirect the output here
+  virtual bool sendData(const char * data, int size);
 
 public:
     RoboCupSSLServer(int port = 10002,
                      string net_ref_address="224.5.23.2",
                      string net_ref_interface="");
 
-    ~RoboCupSSLServer();
+    virtual ~RoboCupSSLServer();
     bool open();
     void close();
-    bool send(const SSL_WrapperPacket & packet);
-    bool send(const SSL_DetectionFrame & frame);
+    bool isOpen() const {
+      return mc.isOpen();
+    }
+    /// also publishes every SSL_WrapperPacket to \p output (0 to stop),
+    /// from the sending thread and before the multicast
+    void setSharedMemoryOutput(RoboCupSSLShmServer * output);
+    virtual bool send(const SSL_WrapperPacket & packet);
+    /// sends \p frame as the detection of an SSL_WrapperPacket, serialized
+    /// without copying the frame and without heap allocations
+    virtual bool send(const SSL_DetectionFrame & frame);
     bool send(const SSL_GeometryData & geometry);
+    /// sends an already serialized SSL_WrapperPacket, e.g. a cached one
+    bool sendSerialized(const char * data, int size);
+    /// sends \p cycle as it is (not wrapped in an SSL_WrapperPacket)
+    bool send(const SSL_DetectionCycle & cycle);
+    /// sends \p frame as it is (not wrapped in an SSL_WrapperPacket)
+    bool send(const SSL_CompactDetectionFrame & frame);
 
 };
 
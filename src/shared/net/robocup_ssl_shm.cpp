@@ -0,0 +1,43 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_shm.cpp
+  \brief   C++ Implementation: RoboCupSSLShm
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_shm.h"
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+//the segment is shared between processes, so the futex operations must not
+//be FUTEX_PRIVATE_FLAG:
+void RoboCupSSLShm::futexWait(volatile uint32_t * word, uint32_t value, int timeout_ms) {
+  if (timeout_ms < 0) {
+    syscall(SYS_futex,word,FUTEX_WAIT,value,0,0,0);
+  } else {
+    struct timespec timeout;
+    timeout.tv_sec=timeout_ms/1000;
+    timeout.tv_nsec=(timeout_ms%1000)*1000000L;
+    syscall(SYS_futex,word,FUTEX_WAIT,value,&timeout,0,0);
+  }
+}
+
+void RoboCupSSLShm::futexWakeAll(volatile uint32_t * word) {
+  syscall(SYS_futex,word,FUTEX_WAKE,INT_MAX,0,0,0);
+}
@@ -0,0 +1,89 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_shm.h
+  \brief   C++ Interface: RoboCupSSLShm
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_SHM_H
+#define ROBOCUP_SSL_SHM_H
+#include <stdint.h>
+#include <stddef.h>
+
+/*!
+  \class   RoboCupSSLShm
+  \brief   The layout of the shared-memory output, shared by its writer and readers
+
+  The segment is a header followed by a ring of fixed-size slots. Each slot
+  holds one serialized SSL_WrapperPacket. Packet n goes to slot
+  n % slot_count, and the sequence of the slot is 2n+1 while the packet is
+  written and 2n+2 once it is complete, so a reader detects both torn reads
+  and slots that were overwritten while it was reading (a seqlock per slot).
+
+  Every packet increments the futex word. Readers that wait register as
+  waiters, so the writer only makes the wake-up system call while someone
+  sleeps.
+
+  All fields have fixed sizes, so 32 and 64 bit processes can share a
+  segment.
+*/
+class RoboCupSSLShm {
+public:
+  static const uint32_t Magic=0x5353484d; //"SSHM"
+  static const uint32_t Version=1;
+
+  struct Header {
+    volatile uint32_t magic;     //written last by the writer, after the rest of the header
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;          //bytes of packet data per slot
+    volatile uint32_t closed;    //set when the writer has replaced the segment by a new one
+    volatile uint32_t waiters;   //readers that sleep on the futex word
+    volatile uint32_t futex;     //incremented after every packet
+    uint32_t reserved0;
+    volatile uint64_t write_index; //the number of the next packet
+    uint8_t reserved1[24];
+  };
+
+  struct Slot {
+    volatile uint64_t sequence;
+    uint32_t size;
+    uint32_t reserved;
+    double t_published; //GetTimeSec() of the writer
+    uint8_t reserved1[40];
+    //followed by slot_size bytes of data
+  };
+
+  static size_t slotStride(uint32_t slot_size) {
+    return (sizeof(Slot) + slot_size + 63) & ~(size_t)63;
+  }
+  static size_t segmentSize(uint32_t slot_count, uint32_t slot_size) {
+    return sizeof(Header) + slot_count*slotStride(slot_size);
+  }
+  static Slot * getSlot(Header * header, uint64_t index) {
+    return (Slot *)((char *)header + sizeof(Header) + (size_t)(index % header->slot_count)*slotStride(header->slot_size));
+  }
+  static char * getData(Slot * slot) {
+    return (char *)slot + sizeof(Slot);
+  }
+
+  /// sleeps while \p *word equals \p value, for up to \p timeout_ms (forever if negative)
+  static void futexWait(volatile uint32_t * word, uint32_t value, int timeout_ms);
+  /// wakes all threads of all processes that sleep on \p word
+  static void futexWakeAll(volatile uint32_t * word);
+};
+
+#endif
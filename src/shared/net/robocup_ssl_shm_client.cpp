@@ -0,0 +1,153 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_shm_client.cpp
+  \brief   C++ Implementation: RoboCupSSLShmClient
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_shm_client.h"
+#include <math.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "timer.h"
+
+RoboCupSSLShmClient::RoboCupSSLShmClient(string name)
+{
+  header=0;
+  segment_size=0;
+  _name=name;
+  next=0;
+  dropped=0;
+  buffer=0;
+  buffer_size=0;
+  t_published=0.0;
+}
+
+RoboCupSSLShmClient::~RoboCupSSLShmClient()
+{
+  close();
+  delete[] buffer;
+}
+
+bool RoboCupSSLShmClient::open() {
+  close();
+  int fd=shm_open(_name.c_str(),O_RDWR,0);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd,&st)!=0 || (size_t)st.st_size < sizeof(RoboCupSSLShm::Header)) {
+    ::close(fd);
+    return false;
+  }
+  void * p=mmap(0,st.st_size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+  ::close(fd);
+  if (p==MAP_FAILED) return false;
+  RoboCupSSLShm::Header * h=(RoboCupSSLShm::Header *)p;
+  if (h->magic!=RoboCupSSLShm::Magic || h->version!=RoboCupSSLShm::Version || h->closed!=0 ||
+      RoboCupSSLShm::segmentSize(h->slot_count,h->slot_size)!=(size_t)st.st_size) {
+    munmap(p,st.st_size);
+    return false;
+  }
+  header=h;
+  segment_size=st.st_size;
+  next=header->write_index;
+  if ((int)header->slot_size > buffer_size) {
+    delete[] buffer;
+    buffer_size=header->slot_size;
+    buffer=new char[buffer_size];
+  }
+  return true;
+}
+
+void RoboCupSSLShmClient::close() {
+  if (header!=0) {
+    munmap(header,segment_size);
+    header=0;
+  }
+}
+
+bool RoboCupSSLShmClient::isClosed() const {
+  return header==0 || header->closed!=0;
+}
+
+bool RoboCupSSLShmClient::available() const {
+  if (header->closed!=0) return true;
+  if (RoboCupSSLShm::getSlot(header,next)->sequence >= 2*next+2) return true;
+  //the packet is in progress, or its writer has been lapped:
+  return header->write_index > next + header->slot_count;
+}
+
+bool RoboCupSSLShmClient::wait(int timeout_ms) {
+  if (header==0) return false;
+  double t_end=GetTimeSec() + timeout_ms*1.0E-3;
+  while (true) {
+    //read the futex word before checking, so that a packet published in
+    //between lets the futex wait return right away:
+    uint32_t value=header->futex;
+    __sync_synchronize();
+    if (available()) return header->closed==0;
+    int remaining_ms=-1;
+    if (timeout_ms >= 0) {
+      double remaining=t_end - GetTimeSec();
+      if (remaining <= 0.0) return false;
+      remaining_ms=(int)ceil(remaining*1.0E3);
+    }
+    __sync_fetch_and_add(&header->waiters,1);
+    if (available()==false) RoboCupSSLShm::futexWait(&header->futex,value,remaining_ms);
+    __sync_fetch_and_sub(&header->waiters,1);
+  }
+}
+
+int RoboCupSSLShmClient::receive(char * data, int capacity) {
+  if (isClosed()) return -1;
+  while (true) {
+    RoboCupSSLShm::Slot * slot=RoboCupSSLShm::getSlot(header,next);
+    uint64_t expected=2*next+2;
+    uint64_t sequence=slot->sequence;
+    __sync_synchronize();
+    if (sequence==expected) {
+      uint32_t size=slot->size;
+      double t=slot->t_published;
+      bool fits=(size <= header->slot_size && (int)size <= capacity);
+      if (fits) memcpy(data,RoboCupSSLShm::getData(slot),size);
+      __sync_synchronize();
+      if (slot->sequence==sequence) {
+        next++;
+        if (fits==false) return -1;
+        t_published=t;
+        return size;
+      }
+      //the writer has lapped us while we were copying
+    } else if (sequence < expected) {
+      //not written yet, unless its writer has been lapped (or has died)
+      if (header->write_index <= next + header->slot_count) return 0;
+    }
+    //skip to the oldest packet that is still in the ring:
+    uint64_t write_index=header->write_index;
+    uint64_t oldest=(write_index > header->slot_count ? write_index - header->slot_count : 0);
+    if (oldest <= next) oldest=next+1;
+    dropped+=oldest - next;
+    next=oldest;
+  }
+}
+
+bool RoboCupSSLShmClient::receive(SSL_WrapperPacket & packet) {
+  int size=receive(buffer,buffer_size);
+  if (size <= 0) return false;
+  return packet.ParseFromArray(buffer,size);
+}
@@ -0,0 +1,83 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_shm_client.h
+  \brief   C++ Interface: RoboCupSSLShmClient
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_SHM_CLIENT_H
+#define ROBOCUP_SSL_SHM_CLIENT_H
+#include <string>
+#include "robocup_ssl_shm.h"
+#include "messages_robocup_ssl_wrapper.pb.h"
+using namespace std;
+
+/*!
+  \class   RoboCupSSLShmClient
+  \brief   Reads the packets of a RoboCupSSLShmServer on the same host
+
+  The interface follows RoboCupSSLClient: wait() for a packet, then
+  receive() until it returns false. Each reader has its own position in the
+  ring and starts with the packets published after open(). A reader that
+  falls behind by more than the ring skips the lost packets and counts them
+  in getDropped().
+
+  If vision replaces the segment, receive() and wait() return false and
+  isClosed() is true; open() the client again to continue.
+
+  A client is used by one thread.
+*/
+class RoboCupSSLShmClient {
+protected:
+  RoboCupSSLShm::Header * header;
+  size_t segment_size;
+  string _name;
+  uint64_t next; //the number of the next packet to read
+  long long dropped;
+  char * buffer;
+  int buffer_size;
+  double t_published;
+
+  bool available() const;
+public:
+  RoboCupSSLShmClient(string name="/ssl-vision");
+  ~RoboCupSSLShmClient();
+
+  /// maps the segment. Fails if vision has not created it yet.
+  bool open();
+  void close();
+  bool isClosed() const;
+
+  /// waits up to \p timeout_ms (forever if negative) for a packet
+  bool wait(int timeout_ms=-1);
+  /// copies the next packet into \p data and returns its size. Returns 0 if
+  /// there is no packet, and -1 if the segment was closed or the packet is
+  /// larger than \p capacity (it is skipped).
+  int receive(char * data, int capacity);
+  /// reads and parses the next packet
+  bool receive(SSL_WrapperPacket & packet);
+
+  /// GetTimeSec() at which the last received packet was published
+  double getPublishTime() const {
+    return t_published;
+  }
+  /// the number of packets that were overwritten before they were read
+  long long getDropped() const {
+    return dropped;
+  }
+};
+
+#endif
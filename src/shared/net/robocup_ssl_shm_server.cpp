@@ -0,0 +1,176 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_shm_server.cpp
+  \brief   C++ Implementation: RoboCupSSLShmServer
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "robocup_ssl_shm_server.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "timer.h"
+#include "tracer.h"
+
+RoboCupSSLShmServer::RoboCupSSLShmServer(int slot_count, int slot_size)
+{
+  header=0;
+  segment_size=0;
+  _slot_count=slot_count;
+  _slot_size=slot_size;
+  dropped=0;
+}
+
+RoboCupSSLShmServer::~RoboCupSSLShmServer()
+{
+  close();
+}
+
+bool RoboCupSSLShmServer::map(int fd, size_t size) {
+  void * p=mmap(0,size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+  if (p==MAP_FAILED) return false;
+  header=(RoboCupSSLShm::Header *)p;
+  segment_size=size;
+  return true;
+}
+
+bool RoboCupSSLShmServer::open(const string & name) {
+  close();
+  lock.lockForWrite();
+  size_t size=RoboCupSSLShm::segmentSize(_slot_count,_slot_size);
+  //readers register as waiters in the header, so they open it for writing as well:
+  int fd=shm_open(name.c_str(),O_RDWR | O_CREAT,0666);
+  struct stat st;
+  if (fd < 0 || fstat(fd,&st)!=0) {
+    fprintf(stderr,"Unable to open the shared memory output %s\n",name.c_str());
+    if (fd >= 0) ::close(fd);
+    lock.unlock();
+    return false;
+  }
+  //reuse the segment of an earlier run if it has the same layout:
+  bool reuse=false;
+  if ((size_t)st.st_size==size && map(fd,size)) {
+    reuse=(header->magic==RoboCupSSLShm::Magic && header->version==RoboCupSSLShm::Version &&
+           header->slot_count==_slot_count && header->slot_size==_slot_size && header->closed==0);
+    if (reuse==false) {
+      munmap(header,size);
+      header=0;
+    } else {
+      //release the slots that a crashed writer left in progress:
+      for (uint32_t i=0;i<_slot_count;i++) {
+        RoboCupSSLShm::Slot * slot=RoboCupSSLShm::getSlot(header,i);
+        if ((slot->sequence & 1)!=0) slot->sequence=0;
+      }
+    }
+  }
+  if (reuse==false) {
+    //tell the readers of the old segment to reopen, and replace it:
+    if ((size_t)st.st_size >= sizeof(RoboCupSSLShm::Header)) {
+      void * p=mmap(0,sizeof(RoboCupSSLShm::Header),PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+      if (p!=MAP_FAILED) {
+        RoboCupSSLShm::Header * old=(RoboCupSSLShm::Header *)p;
+        old->closed=1;
+        __sync_fetch_and_add(&old->futex,1);
+        RoboCupSSLShm::futexWakeAll(&old->futex);
+        munmap(p,sizeof(RoboCupSSLShm::Header));
+      }
+    }
+    ::close(fd);
+    shm_unlink(name.c_str());
+    fd=shm_open(name.c_str(),O_RDWR | O_CREAT | O_EXCL,0666);
+    if (fd < 0 || ftruncate(fd,size)!=0 || map(fd,size)==false) {
+      fprintf(stderr,"Unable to create the shared memory output %s of %d bytes\n",name.c_str(),(int)size);
+      if (fd >= 0) ::close(fd);
+      lock.unlock();
+      return false;
+    }
+    //the segment is zero-filled, so every slot reads as not yet written:
+    header->version=RoboCupSSLShm::Version;
+    header->slot_count=_slot_count;
+    header->slot_size=_slot_size;
+    header->write_index=0;
+    __sync_synchronize();
+    header->magic=RoboCupSSLShm::Magic;
+  }
+  ::close(fd);
+  _name=name;
+  lock.unlock();
+  return true;
+}
+
+void RoboCupSSLShmServer::close() {
+  lock.lockForWrite();
+  if (header!=0) {
+    munmap(header,segment_size);
+    header=0;
+  }
+  lock.unlock();
+}
+
+bool RoboCupSSLShmServer::isOpen() {
+  lock.lockForRead();
+  bool result=(header!=0);
+  lock.unlock();
+  return result;
+}
+
+string RoboCupSSLShmServer::getName() {
+  lock.lockForRead();
+  string result=_name;
+  lock.unlock();
+  return result;
+}
+
+bool RoboCupSSLShmServer::publish(const char * data, int size) {
+  TRACE_SPAN("shm publish");
+  lock.lockForRead();
+  if (header==0) {
+    lock.unlock();
+    return false;
+  }
+  if (size < 0 || (uint32_t)size > _slot_size) {
+    __sync_fetch_and_add(&dropped,1);
+    lock.unlock();
+    return false;
+  }
+  uint64_t index=__sync_fetch_and_add(&header->write_index,1);
+  RoboCupSSLShm::Slot * slot=RoboCupSSLShm::getSlot(header,index);
+  //take the slot from the packet one lap earlier, once it is complete:
+  while (true) {
+    uint64_t sequence=slot->sequence;
+    if (sequence >= 2*index+1) {
+      //a packet of a later lap already has the slot
+      __sync_fetch_and_add(&dropped,1);
+      lock.unlock();
+      return false;
+    }
+    if ((sequence & 1)==0 && __sync_bool_compare_and_swap(&slot->sequence,sequence,2*index+1)) break;
+    sched_yield();
+  }
+  memcpy(RoboCupSSLShm::getData(slot),data,size);
+  slot->size=size;
+  slot->t_published=GetTimeSec();
+  __sync_synchronize();
+  slot->sequence=2*index+2;
+  __sync_fetch_and_add(&header->futex,1);
+  if (header->waiters!=0) RoboCupSSLShm::futexWakeAll(&header->futex);
+  lock.unlock();
+  return true;
+}
@@ -0,0 +1,76 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    robocup_ssl_shm_server.h
+  \brief   C++ Interface: RoboCupSSLShmServer
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef ROBOCUP_SSL_SHM_SERVER_H
+#define ROBOCUP_SSL_SHM_SERVER_H
+#include <string>
+#include <QReadWriteLock>
+#include "robocup_ssl_shm.h"
+using namespace std;
+
+/*!
+  \class   RoboCupSSLShmServer
+  \brief   Publishes serialized SSL_WrapperPackets into a POSIX shared-memory ring
+
+  A RoboCupSSLServer mirrors its packets here (see
+  RoboCupSSLServer::setSharedMemoryOutput()), so processes on the same host
+  read them with a RoboCupSSLShmClient instead of receiving the multicast.
+
+  Any number of threads may publish at the same time: each packet claims
+  its slot with an atomic increment, and nobody waits for a reader. Readers
+  that fall behind by more than the ring lose the oldest packets. A packet
+  only waits for the slot if the previous packet in it is still being
+  copied, which needs a thread that stalls while the ring wraps around.
+
+  The segment is kept when the server closes, so that readers continue
+  seamlessly when vision restarts with the same ring size. If the size
+  differs, the old segment is marked as closed and replaced.
+*/
+class RoboCupSSLShmServer {
+protected:
+  QReadWriteLock lock; //written only to map or unmap the segment
+  RoboCupSSLShm::Header * header;
+  size_t segment_size;
+  string _name;
+  uint32_t _slot_count;
+  uint32_t _slot_size;
+  volatile long long dropped;
+
+  bool map(int fd, size_t size);
+public:
+  RoboCupSSLShmServer(int slot_count=64, int slot_size=16384);
+  ~RoboCupSSLShmServer();
+
+  /// creates or reuses the segment \p name (e.g. "/ssl-vision")
+  bool open(const string & name);
+  void close();
+  bool isOpen();
+  string getName();
+
+  /// copies one serialized packet into the ring and wakes the waiting readers
+  bool publish(const char * data, int size);
+  /// the number of packets that were not published: larger than a slot,
+  /// or overtaken by a newer packet while their thread stalled
+  long long getDropped() const {
+    return dropped;
+  }
+};
+
+#endif
@@ -20,12 +20,17 @@
 //========================================================================
 #include "affinity_manager.h"
 
-AffinityManager::AffinityManager()
+AffinityManager::AffinityManager(const Options & _options)
 {
   _mutex=new pthread_mutex_t;
   pthread_mutex_init((pthread_mutex_t*)_mutex, NULL);
+  options=_options;
   max_cpu_id=0;
-  parseCpuInfo();
+  num_nodes=1;
+  planned=false;
+  if (parseSysfsTopology()==false) {
+    parseCpuInfo();
+  }
 }
 
 AffinityManager::~AffinityManager()
@@ -34,43 +39,291 @@ AffinityManager::~AffinityManager()
   delete _mutex;
 }
 
-void AffinityManager::demandCore(int core) {
+bool AffinityManager::parseCpuList(const char * s, vector<int> & cpus) {
+  cpus.clear();
+  if (s==0) return false;
+  const char * p=s;
+  while (*p!=0 && *p!='\n') {
+    char * end=0;
+    long first=strtol(p,&end,10);
+    if (end==p) return false;
+    long last=first;
+    p=end;
+    if (*p=='-') {
+      p++;
+      last=strtol(p,&end,10);
+      if (end==p) return false;
+      p=end;
+    }
+    for (long i=first;i<=last;i++) cpus.push_back((int)i);
+    if (*p==',') p++;
+  }
+  sort(cpus.begin(),cpus.end());
+  cpus.erase(unique(cpus.begin(),cpus.end()),cpus.end());
+  return true;
+}
+
+bool AffinityManager::readIntFile(const char * path, int & value) {
+  FILE * f=fopen(path,"r");
+  if (f==0) return false;
+  bool ok=(fscanf(f,"%d",&value)==1);
+  fclose(f);
+  return ok;
+}
 
+bool AffinityManager::readCpuListFile(const char * path, vector<int> & cpus) {
+  cpus.clear();
+  FILE * f=fopen(path,"r");
+  if (f==0) return false;
+  char buf[4096];
+  bool ok=false;
+  if (fgets(buf,sizeof(buf),f)!=0) {
+    ok=parseCpuList(buf,cpus);
+  } else {
+    //an empty file is a valid, empty list
+    ok=true;
+  }
+  fclose(f);
+  return ok;
+}
+
+bool AffinityManager::parseSysfsTopology() {
+  vector<int> online;
+  if (readCpuListFile("/sys/devices/system/cpu/online",online)==false || online.size()==0) return false;
   DT_LOCK;
-  unsigned int tid=(long int)syscall(__NR_gettid);
-  printf("The ID of this thread is: %d\n", tid);
-  cpu_set_t cpu_set;
-  //int n = max_cpu_id+1;
-  sched_getaffinity(tid, sizeof(cpu_set), &cpu_set);
-  for (int i=0;i<CPU_SETSIZE;i++) {
-    CPU_CLR(i, &cpu_set);
+  cores.clear();
+  char path[256];
+
+  //map each cpu to its NUMA node:
+  vector<int> cpu_node(online.back()+1,0);
+  num_nodes=0;
+  for (int n=0;n<256;n++) {
+    vector<int> node_cpus;
+    snprintf(path,sizeof(path),"/sys/devices/system/node/node%d/cpulist",n);
+    if (readCpuListFile(path,node_cpus)==false) continue;
+    num_nodes=n+1;
+    for (unsigned int i=0;i<node_cpus.size();i++) {
+      if (node_cpus[i] < (int)cpu_node.size()) cpu_node[node_cpus[i]]=n;
+    }
   }
-  int max_cores=cores.size();
- 
+  if (num_nodes==0) num_nodes=1;
 
-  if (core < 0) core=0;
-  int modded_core=core % max_cores;
+  //group cpus into physical cores:
+  for (unsigned int i=0;i<online.size();i++) {
+    int cpu=online[i];
+    int core_id=cpu;
+    int package_id=0;
+    snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d/topology/core_id",cpu);
+    readIntFile(path,core_id);
+    snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d/topology/physical_package_id",cpu);
+    readIntFile(path,package_id);
+    if (cpu > max_cpu_id) max_cpu_id=cpu;
+    unsigned int j=0;
+    for (;j<cores.size();j++) {
+      if (cores[j].package_id==package_id && cores[j].core_id==core_id) break;
+    }
+    if (j==cores.size()) {
+      PhysicalCore core;
+      core.enabled=true;
+      core.package_id=package_id;
+      core.core_id=core_id;
+      core.node=cpu_node[cpu];
+      cores.push_back(core);
+    }
+    cores[j].processor_ids.push_back(cpu);
+  }
+
+  readCpuListFile("/sys/devices/system/cpu/isolated",isolated_cpus);
 
-  /* This commented code could be used to set affinity for hyperthreading
-     For now, we leave this up to the system scheduler...
-    int wraps=core/max_cores;
-    if (wraps > 0) {
-      int ht_channel=wraps % cores[modded_core].processor_ids.size();
+  printf("== Affinity Manager CPU Detection Results =========================\n");
+  printf(" Found %zu core(s) on %d NUMA node(s):\n", cores.size(), num_nodes);
+  for (unsigned int i=0;i< cores.size(); i++) {
+    printf(" - Core %d (package %d, node %d) with %zu HT Processor(s) (IDs: ",i,cores[i].package_id,cores[i].node,cores[i].processor_ids.size());
+    for (unsigned j=0;j< cores[i].processor_ids.size(); j++) {
+      printf("[%d] ",cores[i].processor_ids[j]);
     }
-  */
+    printf(")\n");
+  }
+  if (isolated_cpus.size() > 0) {
+    printf(" Isolated CPUs:");
+    for (unsigned int i=0;i<isolated_cpus.size();i++) printf(" %d",isolated_cpus[i]);
+    printf("\n");
+  }
+  printf("==================================================================\n");
+  DT_UNLOCK;
+  return cores.size() > 0;
+}
+
+static bool containsCpu(const vector<int> & list, int cpu) {
+  return find(list.begin(),list.end(),cpu)!=list.end();
+}
 
-  for (unsigned int i=0; i < cores[modded_core].processor_ids.size(); i++) {
-    CPU_SET(cores[modded_core].processor_ids[i],&cpu_set);
+void AffinityManager::planPlacement(int cameras) {
+  DT_LOCK;
+  camera_plan.clear();
+  camera_nodes.clear();
+  housekeeping_plan.clear();
+  visualization_plan.clear();
+
+  vector<int> all;
+  for (unsigned int i=0;i<cores.size();i++) {
+    if (cores[i].enabled) all.insert(all.end(),cores[i].processor_ids.begin(),cores[i].processor_ids.end());
   }
-  if (sched_setaffinity(tid, sizeof(cpu_set), &cpu_set) == 0) {
-    printf("Affinity set successfully\n");
-    for (int i=0;i<CPU_SETSIZE;i++) {
-      if (CPU_ISSET(i,&cpu_set)) printf("Set CPU: %d\n",i);
+  sort(all.begin(),all.end());
+
+  //select candidate cpus for the cameras:
+  vector<int> camera_cpus;
+  if (options.camera_cpus.empty()==false) {
+    if (parseCpuList(options.camera_cpus.c_str(),camera_cpus)==false) {
+      fprintf(stderr,"AffinityManager: invalid camera cpu list '%s'\n",options.camera_cpus.c_str());
+      camera_cpus.clear();
+    }
+  }
+  if (camera_cpus.empty()) camera_cpus=isolated_cpus;
+
+  //select housekeeping cpus:
+  if (options.housekeeping_cpus.empty()==false) {
+    if (parseCpuList(options.housekeeping_cpus.c_str(),housekeeping_plan)==false) {
+      fprintf(stderr,"AffinityManager: invalid housekeeping cpu list '%s'\n",options.housekeeping_cpus.c_str());
+      housekeeping_plan.clear();
     }
+  }
+
+  if (camera_cpus.empty()) {
+    //no isolated cpus: keep the first physical core (which usually also
+    //serves most interrupts) for housekeeping, if we can afford to.
+    camera_cpus=all;
+    if (housekeeping_plan.empty() && cores.size() > 1 && (int)cores.size() > cameras) {
+      for (unsigned int i=0;i<cores[0].processor_ids.size();i++) {
+        camera_cpus.erase(remove(camera_cpus.begin(),camera_cpus.end(),cores[0].processor_ids[i]),camera_cpus.end());
+      }
+    }
+  }
+  if (housekeeping_plan.empty()) {
+    for (unsigned int i=0;i<all.size();i++) {
+      if (containsCpu(camera_cpus,all[i])==false) housekeeping_plan.push_back(all[i]);
+    }
+    if (housekeeping_plan.empty()) housekeeping_plan=all;
+  }
+
+  //collect cores which have candidate cpus, grouped by node:
+  vector<vector<int> > node_cores(num_nodes);
+  for (unsigned int i=0;i<cores.size();i++) {
+    if (cores[i].enabled==false) continue;
+    for (unsigned int j=0;j<cores[i].processor_ids.size();j++) {
+      if (containsCpu(camera_cpus,cores[i].processor_ids[j])) {
+        node_cores[cores[i].node < num_nodes ? cores[i].node : 0].push_back(i);
+        break;
+      }
+    }
+  }
+  vector<int> nodes;
+  for (int n=0;n<num_nodes;n++) {
+    if (node_cores[n].size() > 0) nodes.push_back(n);
+  }
+
+  //assign cameras round-robin over nodes, one physical core each:
+  vector<unsigned int> next_core(num_nodes,0);
+  for (int c=0;c<cameras;c++) {
+    vector<int> cpus;
+    int node=0;
+    if (nodes.size() > 0) {
+      node=nodes[c % nodes.size()];
+      int core=node_cores[node][next_core[node] % node_cores[node].size()];
+      next_core[node]++;
+      const vector<int> & ids=cores[core].processor_ids;
+      for (unsigned int j=0;j<ids.size();j++) {
+        if (containsCpu(camera_cpus,ids[j])==false) continue;
+        if (options.smt_visualization && cpus.size() > 0) {
+          //leave the SMT siblings to the visualization
+          if (containsCpu(visualization_plan,ids[j])==false) visualization_plan.push_back(ids[j]);
+        } else {
+          cpus.push_back(ids[j]);
+        }
+      }
+    }
+    camera_plan.push_back(cpus);
+    camera_nodes.push_back(node);
+  }
+
+  for (unsigned int i=0;i<housekeeping_plan.size();i++) {
+    if (containsCpu(visualization_plan,housekeeping_plan[i])==false) visualization_plan.push_back(housekeeping_plan[i]);
+  }
+  sort(visualization_plan.begin(),visualization_plan.end());
+  planned=true;
+  DT_UNLOCK;
+  printPlan();
+}
+
+static void printCpus(FILE * f, const vector<int> & cpus) {
+  if (cpus.empty()) {
+    fprintf(f,"(any)");
+  }
+  for (unsigned int i=0;i<cpus.size();i++) {
+    fprintf(f,"%s%d",i==0 ? "" : ",",cpus[i]);
+  }
+  fprintf(f,"\n");
+}
+
+void AffinityManager::printPlan(FILE * f) {
+  DT_LOCK;
+  fprintf(f,"== Affinity Manager Thread Placement ==============================\n");
+  if (planned==false) {
+    fprintf(f," No placement planned yet.\n");
   } else {
-    printf("Error while setting affinity\n");
-  }	
+    for (unsigned int i=0;i<camera_plan.size();i++) {
+      fprintf(f," Camera %d (node %d): ",i,camera_nodes[i]);
+      printCpus(f,camera_plan[i]);
+    }
+    fprintf(f," Housekeeping (GUI, network): ");
+    printCpus(f,housekeeping_plan);
+    fprintf(f," Visualization: ");
+    printCpus(f,visualization_plan);
+  }
+  fprintf(f,"==================================================================\n");
+  DT_UNLOCK;
+}
+
+void AffinityManager::pinCurrentThread(const vector<int> & cpus, const char * role) {
+  unsigned int tid=(long int)syscall(__NR_gettid);
+  if (cpus.empty()) {
+    printf("Affinity: no cpus planned for %s thread %d, leaving it to the scheduler\n",role,tid);
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (unsigned int i=0;i<cpus.size();i++) {
+    CPU_SET(cpus[i],&cpu_set);
+  }
+  if (sched_setaffinity(tid, sizeof(cpu_set), &cpu_set) == 0) {
+    printf("Affinity set successfully for %s thread %d: ",role,tid);
+    printCpus(stdout,cpus);
+  } else {
+    printf("Error while setting affinity for %s thread %d\n",role,tid);
+  }
+}
 
+void AffinityManager::demandCore(int core) {
+  if (planned==false) planPlacement(core+1);
+  DT_LOCK;
+  if (core < 0) core=0;
+  vector<int> cpus;
+  if (camera_plan.size() > 0) cpus=camera_plan[core % camera_plan.size()];
+  pinCurrentThread(cpus,"camera");
+  DT_UNLOCK;
+}
+
+void AffinityManager::demandHousekeeping() {
+  if (planned==false) planPlacement(0);
+  DT_LOCK;
+  pinCurrentThread(housekeeping_plan,"housekeeping");
+  DT_UNLOCK;
+}
+
+void AffinityManager::demandVisualization() {
+  if (planned==false) planPlacement(0);
+  DT_LOCK;
+  pinCurrentThread(visualization_plan,"visualization");
   DT_UNLOCK;
 }
 
@@ -24,6 +24,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <vector>
+#include <string>
+#include <algorithm>
 #include <unistd.h>
 #include <asm/unistd.h>
 #include <syscall.h>
@@ -36,28 +38,79 @@ using namespace std;
 
 /**
 	@author Stefan Zickler
+
+  The AffinityManager pins threads to processors.
+  It reads the CPU topology from sysfs (falling back to /proc/cpuinfo) and
+  builds a placement plan with planPlacement(...):
+   - each camera thread gets its own physical core. Cameras are spread
+     round-robin over NUMA nodes. Since the capture thread pins itself before
+     it first touches its frame buffers, first-touch allocation keeps those
+     buffers on the camera's own node.
+   - isolated cpus (isolcpus) are preferred for cameras.
+   - GUI and network threads run on the remaining housekeeping cpus.
+   - optionally, the SMT siblings of camera cores are used for visualization.
 */
 class AffinityManager{
 public:
   class PhysicalCore {
     public:
     bool enabled;
+    int package_id;
+    int core_id;
+    int node;
     vector<int> processor_ids;
     PhysicalCore() {
       enabled=false;
+      package_id=0;
+      core_id=0;
+      node=0;
       processor_ids.clear();
     }
   };
+  /// placement options, usually set from the command line
+  class Options {
+    public:
+    string camera_cpus;       //cpus to use for cameras (empty: isolcpus or all)
+    string housekeeping_cpus; //cpus to use for GUI and network (empty: automatic)
+    bool smt_visualization;   //allow visualization on SMT siblings of camera cores
+    Options() {
+      smt_visualization=false;
+    }
+  };
 protected:
     pthread_mutex_t * _mutex;
+    Options options;
     vector<PhysicalCore> cores;
+    vector<int> isolated_cpus;
+    int num_nodes;
     int max_cpu_id;
+    bool planned;
+    vector<vector<int> > camera_plan;
+    vector<int> camera_nodes;
+    vector<int> housekeeping_plan;
+    vector<int> visualization_plan;
     int parseFileUpTo(FILE * f, char * output, int len, char end);
     void parseCpuInfo();
+    bool parseSysfsTopology();
+    static bool readIntFile(const char * path, int & value);
+    static bool readCpuListFile(const char * path, vector<int> & cpus);
+    void pinCurrentThread(const vector<int> & cpus, const char * role);
 public:
+    /// parses a cpu list such as "0-3,8,10-11"
+    static bool parseCpuList(const char * s, vector<int> & cpus);
+
+    /// computes the placement of \p cameras camera threads and the housekeeping threads
+    void planPlacement(int cameras);
+    void printPlan(FILE * f=stdout);
 
+    /// pins the calling camera thread
     void demandCore(int core);
-    AffinityManager();
+    /// pins the calling GUI or network thread to the housekeeping cpus
+    void demandHousekeeping();
+    /// pins the calling visualization thread (e.g. the GUI)
+    void demandVisualization();
+
+    AffinityManager(const Options & _options=Options());
 
     ~AffinityManager();
 
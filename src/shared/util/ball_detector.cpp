@@ -0,0 +1,253 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    ball_detector.cpp
+  \brief   C++ Implementation: BallDetector
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include <list>
+#include "ball_detector.h"
+#include "vis_util.h"
+
+using namespace std;
+
+BallDetector::Settings::Settings() {
+  max_balls=10;
+  color_label="Orange";
+  z_height=30.0;
+  min_width=3;
+  max_width=30;
+  min_height=3;
+  max_height=30;
+  min_area=9;
+  max_area=1000;
+  filter_gauss=true;
+  exp_area_min=30;
+  exp_area_max=40;
+  exp_area_stddev=10.0;
+  near_robot_filter=true;
+  near_robot_dist=70.0;
+  filter_ball_histogram=true;
+  min_greenness=0.5;
+  max_markeryness=2.0;
+  filter_ball_in_field=true;
+  filter_ball_on_field_filter_threshold=30.0;
+  filter_ball_in_goal=true;
+}
+
+BallDetector::BallDetector ( LUT3DTable * lut ) {
+  _lut=lut;
+  color_id_ball = -1;
+  filter_ball_histogram = false;
+  exp_area_var = 1.0;
+  near_robot_dist_sq = 0.0;
+
+  //read-out important LUT data:
+  histogram = new CMVision::Histogram ( _lut->getChannelCount() );
+  color_id_orange = _lut->getChannelID ( "Orange" );
+  if ( color_id_orange == -1 ) printf ( "WARNING color label 'Orange' not defined in LUT!!!\n" );
+  color_id_pink = _lut->getChannelID ( "Pink" );
+  if ( color_id_pink == -1 ) printf ( "WARNING color label 'Pink' not defined in LUT!!!\n" );
+  color_id_yellow = _lut->getChannelID ( "Yellow" );
+  if ( color_id_yellow == -1 ) printf ( "WARNING color label 'Yellow' not defined in LUT!!!\n" );
+  color_id_field = _lut->getChannelID ( "Field Green" );
+  if ( color_id_field == -1 ) printf ( "WARNING color label 'Field Green' not defined in LUT!!!\n" );
+}
+
+BallDetector::~BallDetector() {
+  delete histogram;
+}
+
+void BallDetector::init ( const Settings & _settings, const FieldFilter & field ) {
+  settings = _settings;
+  color_id_ball = _lut->getChannelID ( settings.color_label );
+  exp_area_var = sq ( settings.exp_area_stddev );
+  near_robot_dist_sq = sq ( settings.near_robot_dist );
+
+  filter.setWidth ( settings.min_width,settings.max_width );
+  filter.setHeight ( settings.min_height,settings.max_height );
+  filter.setArea ( settings.min_area,settings.max_area );
+  field_filter = field;
+
+  filter_ball_histogram = settings.filter_ball_histogram;
+  if ( filter_ball_histogram ) {
+    if ( color_id_ball != color_id_orange ) {
+      printf ( "Warning: ball histogram check is only configured for orange balls!\n" );
+      printf ( "Please disable the histogram check in the Ball Detection Plugin settings\n" );
+    }
+    if ( color_id_pink==-1 || color_id_orange==-1 || color_id_yellow==-1 || color_id_field==-1 ) {
+      printf ( "WARNING: some LUT color labels where undefined for the ball detection plugin\n" );
+      printf ( "         Disabling histogram check!\n" );
+      filter_ball_histogram=false;
+    }
+  }
+}
+
+bool BallDetector::checkHistogram ( const Image<raw8> * image, const CMVision::Region * reg, double min_greenness, double max_markeryness ) {
+  static const int PixelRadius = 4;
+
+  histogram->clear();
+
+  int num = histogram->addBox ( image, reg->x1 - PixelRadius, reg->y1 - PixelRadius,
+                                reg->x2 + PixelRadius, reg->y2 + PixelRadius );
+
+
+  float pf = ( float ) ( histogram->getChannel ( color_id_pink ) ) / ( float ) ( histogram->getChannel ( color_id_orange ) );
+  float yf = ( float ) ( histogram->getChannel ( color_id_yellow ) ) / ( float ) ( histogram->getChannel ( color_id_orange ) );
+  float markeryness = ( pf + 1 ) * ( yf + 1 ) - 1;
+  float greenness = ( float ) ( histogram->getChannel ( color_id_field ) ) / ( ( ( float ) ( num - histogram->getChannel ( color_id_orange ) ) ) + 1E-6 );
+
+  if ( greenness   > min_greenness ) return ( true );
+  if ( markeryness > max_markeryness ) return ( false );
+  return ( true );
+}
+
+//Data structure for storing and sorting the filtered regions
+class BallDetectResult
+{
+public:
+  const CMVision::Region* reg;
+  float conf;
+
+  BallDetectResult(const CMVision::Region* reg, float conf) {
+    this->reg = reg;
+    this->conf = conf;
+  }
+
+  bool operator< (BallDetectResult a) {
+    return conf < a.conf;
+  }
+};
+
+bool BallDetector::update ( SSL_DetectionFrame * detection_frame, CMVision::ColorRegionList * colorlist, const Image<raw8> * image, const CameraModel & camera ) {
+  if ( color_id_ball == -1 ) {
+    printf ( "Unknown Ball Detection Color Label: '%s'\nAborting Plugin!\n",settings.color_label.c_str() );
+    return false;
+  }
+
+  //delete any previous detection results:
+  detection_frame->clear_balls();
+
+  const CMVision::Region * reg = colorlist->getRegionList ( color_id_ball ).getInitialElement();
+
+  int robots_blue_n=detection_frame->robots_blue_size();
+  int robots_yellow_n=detection_frame->robots_yellow_size();
+  bool use_near_robot_filter=settings.near_robot_filter;
+  if (robots_blue_n==0 && robots_yellow_n==0) use_near_robot_filter=false;
+
+  if ( settings.max_balls > 0 ) {
+    list<BallDetectResult> result;
+    filter.init ( reg );
+
+    while ( ( reg = filter.getNext() ) != 0 ) {
+      float conf = 1.0;
+
+      if ( settings.filter_gauss==true ) {
+        int a = reg->area - bound ( reg->area,settings.exp_area_min,settings.exp_area_max );
+        conf = gaussian ( a / exp_area_var );
+      }
+
+      //TODO: add a plugin for confidence masking... possibly multi-layered.
+      //      to replace the commented det.mask.get(...) below:
+      //if (filter_conf_mask) conf*=det.mask.get(reg->cen_x,reg->cen_y));
+
+      //convert from image to field coordinates:
+      vector2d pixel_pos ( reg->cen_x,reg->cen_y );
+      vector3d field_pos_3d;
+      camera.image2field ( field_pos_3d,pixel_pos,settings.z_height );
+      vector2d field_pos ( field_pos_3d.x,field_pos_3d.y );
+
+      //filter points that are outside of the field:
+      if ( settings.filter_ball_in_field==true && field_filter.isInFieldPlusThreshold ( field_pos, max(0.0,settings.filter_ball_on_field_filter_threshold) ) ==false ) {
+        conf = 0.0;
+      }
+
+      //filter out points that are deep inside the goal-box
+      if ( settings.filter_ball_in_goal==true && field_filter.isFarInGoal ( field_pos ) ==true ) {
+        conf = 0.0;
+      }
+
+      //TODO add ball-too-near-robot filter
+      if ( use_near_robot_filter && conf > 0.0 ) {
+        int robots_n=0;
+        for (int team = 0; team < 2; team++) {
+          if (team==0) {
+            robots_n=robots_blue_n;
+          } else {
+            robots_n=robots_yellow_n;
+          }
+          if (robots_n > 0) {
+            ::google::protobuf::RepeatedPtrField< ::SSL_DetectionRobot > * robots;
+            if (team==0) {
+              robots = detection_frame->mutable_robots_blue();
+            } else {
+              robots = detection_frame->mutable_robots_yellow();
+            }
+            for (int r = 0; r < robots_n; r++) {
+              const SSL_DetectionRobot & robot = robots->Get(r);
+              if (robot.confidence() > 0.0) {
+                if ((sq((double)(robot.x())-(double)(field_pos.x)) + sq((double)(robot.y())-(double)(field_pos.y))) < near_robot_dist_sq) {
+                  conf = 0.0;
+                  break;
+                }
+              }
+            }
+            if (conf==0.0) break;
+          }
+        }
+      }
+
+      // histogram check if enabled
+      if ( filter_ball_histogram && conf > 0.0 && checkHistogram ( image, reg, settings.min_greenness, settings.max_markeryness ) ==false ) {
+        conf = 0.0;
+      }
+
+      // add filtered region to the region list
+      if(conf > 0) {
+        result.push_back(BallDetectResult(reg,conf));
+      }
+
+    }
+
+    // sort result by confidence and output first max_balls region(s)
+    result.sort();
+
+    int num_ball = 0;
+    list<BallDetectResult>::reverse_iterator it;
+    for(it=result.rbegin(); it!=result.rend(); it++) {
+      if(++num_ball > settings.max_balls)
+        break;
+
+      //update result:
+      SSL_DetectionBall* ball = detection_frame->add_balls();
+
+      ball->set_confidence ( it->conf );
+
+      vector2d pixel_pos ( it->reg->cen_x,it->reg->cen_y );
+      vector3d field_pos_3d;
+      camera.image2field ( field_pos_3d,pixel_pos,settings.z_height );
+
+      ball->set_area ( it->reg->area );
+      ball->set_x ( field_pos_3d.x );
+      ball->set_y ( field_pos_3d.y );
+      ball->set_pixel_x ( it->reg->cen_x );
+      ball->set_pixel_y ( it->reg->cen_y );
+    }
+
+  }
+
+  return true;
+}
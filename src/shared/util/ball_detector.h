@@ -0,0 +1,95 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    ball_detector.h
+  \brief   C++ Interface: BallDetector
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef BALL_DETECTOR_H
+#define BALL_DETECTOR_H
+#include <string>
+#include "messages_robocup_ssl_detection.pb.h"
+#include "cmvision_region.h"
+#include "cmvision_histogram.h"
+#include "camera_model.h"
+#include "field_filter.h"
+#include "lut3d_table.h"
+
+/*!
+  \class   BallDetector
+  \brief   Finds the balls in the regions of a frame
+
+  The robots of the frame are used by the near robot filter, so the robots
+  should be detected first. The settings are plain values; the vision stack
+  keeps them in PluginDetectBallsSettings, which takes its defaults from
+  Settings.
+*/
+class BallDetector {
+public:
+  struct Settings {
+    int max_balls;
+    std::string color_label;
+    double z_height;
+    int min_width;
+    int max_width;
+    int min_height;
+    int max_height;
+    int min_area;
+    int max_area;
+    bool filter_gauss;
+    int exp_area_min;
+    int exp_area_max;
+    double exp_area_stddev;
+    bool near_robot_filter;
+    double near_robot_dist;
+    bool filter_ball_histogram;
+    double min_greenness;
+    double max_markeryness;
+    bool filter_ball_in_field;
+    double filter_ball_on_field_filter_threshold;
+    bool filter_ball_in_goal;
+
+    Settings();
+  };
+protected:
+  LUT3DTable * _lut;
+  Settings settings;
+  double exp_area_var;
+  double near_robot_dist_sq;
+  int color_id_ball;
+  bool filter_ball_histogram;
+  int color_id_orange;
+  int color_id_pink;
+  int color_id_yellow;
+  int color_id_field;
+
+  CMVision::Histogram * histogram;
+  CMVision::RegionFilter filter;
+  FieldFilter field_filter;
+
+  bool checkHistogram(const Image<raw8> * image, const CMVision::Region * reg, double min_greenness=0.5, double max_markeryness=2.0);
+public:
+  BallDetector(LUT3DTable * lut);
+  ~BallDetector();
+
+  void init(const Settings & _settings, const FieldFilter & field);
+
+  /// replaces the balls of \p detection_frame with the ones found in
+  /// \p colorlist. Returns false if the ball color is not in the LUT.
+  bool update(SSL_DetectionFrame * detection_frame, CMVision::ColorRegionList * colorlist, const Image<raw8> * image, const CameraModel & camera);
+};
+
+#endif
@@ -48,35 +48,25 @@ CameraParameters::~CameraParameters()
   delete additional_calibration_information;
 }
 
+CameraModel CameraParameters::getModel() const {
+  CameraModel model;
+  model.focal_length=focal_length->getDouble();
+  model.principal_point_x=principal_point_x->getDouble();
+  model.principal_point_y=principal_point_y->getDouble();
+  model.distortion=distortion->getDouble();
+  model.q0=q0->getDouble();
+  model.q1=q1->getDouble();
+  model.q2=q2->getDouble();
+  model.q3=q3->getDouble();
+  model.tx=tx->getDouble();
+  model.ty=ty->getDouble();
+  model.tz=tz->getDouble();
+  return model;
+}
+
 #ifndef NO_PROTOBUFFERS
 void CameraParameters::toProtoBuffer(SSL_GeometryCameraCalibration & buffer, int camera_id) const {
-  buffer.set_focal_length(focal_length->getDouble());
-  buffer.set_principal_point_x(principal_point_x->getDouble());
-  buffer.set_principal_point_y(principal_point_y->getDouble());
-  buffer.set_distortion(distortion->getDouble());
-  buffer.set_q0(q0->getDouble());
-  buffer.set_q1(q1->getDouble());
-  buffer.set_q2(q2->getDouble());
-  buffer.set_q3(q3->getDouble());
-  buffer.set_tx(tx->getDouble());
-  buffer.set_ty(ty->getDouble());
-  buffer.set_tz(tz->getDouble());
-  buffer.set_camera_id(camera_id);
-
-  //--Set derived parameters:
-  //compute camera world coordinates:
-  Quaternion<double> q;
-  q.set(q0->getDouble(),q1->getDouble(),q2->getDouble(),q3->getDouble());
-  q.invert();
-
-  GVector::vector3d<double> v_in(tx->getDouble(),ty->getDouble(),tz->getDouble());
-  v_in=(-(v_in));
-
-  GVector::vector3d<double> v_out = q.rotateVectorByQuaternion(v_in);
-  buffer.set_derived_camera_world_tx(v_out.x);
-  buffer.set_derived_camera_world_ty(v_out.y);
-  buffer.set_derived_camera_world_tz(v_out.z);
-
+  getModel().toProtoBuffer(buffer,camera_id);
 }
 
 void CameraParameters::fromProtoBuffer(const SSL_GeometryCameraCalibration & buffer) {
@@ -111,32 +101,12 @@ void CameraParameters::addSettingsToList(VarList& list)
 
 double CameraParameters::radialDistortion(double ru) const
 {
-  if((distortion->getDouble())<=DBL_MIN)
-    return ru;
-  double rd = 0;
-  double a = distortion->getDouble();
-  double b = -9.0*a*a*ru + a*sqrt(a*(12.0 + 81.0*a*ru*ru));
-  //Pre-computing numerical constants to optimize for speed...
-  //b = b<0.0?-pow(b,1.0/3.0):pow(b,1.0/3.0);
-  //rd = pow(2.0/3.0,1.0/3.0)/b - b/(pow(2.0*3.0*3.0,1.0/3.0)*a);
-  b = b<0.0?-pow(-b,0.33333333333333333333333333333333333333333333333333):pow(b,0.33333333333333333333333333333333333333333333333333);
-  rd = 0.87358046473629886904722042681399875674647588190788/b - b/(2.62074139420889660714166128044199627023942764572363*a);
-  return rd;
+  return CameraModel::radialDistortion(ru,distortion->getDouble());
 }
 
 double CameraParameters::radialDistortion(double ru, double dist) const
 {
-  if(dist<=DBL_MIN)
-    return ru;
-  double rd = 0;
-  double a = dist;
-  double b = -9.0*a*a*ru + a*sqrt(a*(12.0 + 81.0*a*ru*ru));
-  //Pre-computing numerical constants to optimize for speed...
-  //b = b<0.0?-pow(b,1.0/3.0):pow(b,1.0/3.0);
-  //rd = pow(2.0/3.0,1.0/3.0)/b - b/(pow(2.0*3.0*3.0,1.0/3.0)*a);
-  b = b<0.0?-pow(-b,0.33333333333333333333333333333333333333333333333333):pow(b,0.33333333333333333333333333333333333333333333333333);
-  rd = 0.87358046473629886904722042681399875674647588190788/b - b/(2.62074139420889660714166128044199627023942764572363*a);
-  return rd;
+  return CameraModel::radialDistortion(ru,dist);
 }
 
 double CameraParameters::radialDistortionInv(double rd) const
@@ -168,21 +138,7 @@ void CameraParameters::radialDistortion(const GVector::vector2d<double> pu, GVec
 
 void CameraParameters::field2image(const GVector::vector3d<double> &p_f, GVector::vector2d<double> &p_i) const
 {
-  Quaternion<double> q_field2cam = Quaternion<double>(q0->getDouble(),q1->getDouble(),q2->getDouble(),q3->getDouble());
-  q_field2cam.norm();
-  GVector::vector3d<double> translation = GVector::vector3d<double>(tx->getDouble(),ty->getDouble(),tz->getDouble());
-
-  // First transform the point from the field into the coordinate system of the camera
-  GVector::vector3d<double> p_c = q_field2cam.rotateVectorByQuaternion(p_f) + translation;
-  GVector::vector2d<double> p_un = GVector::vector2d<double>(p_c.x/p_c.z, p_c.y/p_c.z);
-
-  // Apply distortion
-  GVector::vector2d<double> p_d;
-  radialDistortion(p_un,p_d);
-  
-  // Then project from the camera coordinate system onto the image plane using the instrinsic parameters
-  p_i = focal_length->getDouble() * p_d +
-      GVector::vector2d<double>(principal_point_x->getDouble(), principal_point_y->getDouble());
+  getModel().field2image(p_f,p_i);
 }
 
 void CameraParameters::field2image(GVector::vector3d<double> &p_f, GVector::vector2d<double> &p_i, Eigen::VectorXd &p)
@@ -213,32 +169,7 @@ void CameraParameters::field2image(GVector::vector3d<double> &p_f, GVector::vect
 
 void CameraParameters::image2field(GVector::vector3d<double> &p_f, GVector::vector2d<double> &p_i, double z) const
 {
-  // Undo scaling and offset
-  GVector::vector2d<double> p_d((p_i.x - principal_point_x->getDouble()) / focal_length->getDouble(),
-                                  (p_i.y - principal_point_y->getDouble()) / focal_length->getDouble());
-  
-  // Compensate for distortion (undistort)
-  GVector::vector2d<double> p_un;
-  radialDistortionInv(p_un,p_d);
-  
-  // Now we got a ray on the z axis
-  GVector::vector3d<double> v(p_un.x, p_un.y, 1);
-
-  // Transform this ray into world coordinates
-  Quaternion<double> q_field2cam = Quaternion<double>(q0->getDouble(),q1->getDouble(),q2->getDouble(),q3->getDouble());
-  q_field2cam.norm();
-  GVector::vector3d<double> translation = GVector::vector3d<double>(tx->getDouble(),ty->getDouble(),tz->getDouble());
-
-  Quaternion<double> q_field2cam_inv = q_field2cam;
-  q_field2cam_inv.invert();
-  GVector::vector3d<double> v_in_w = q_field2cam_inv.rotateVectorByQuaternion(v);
-  GVector::vector3d<double> zero_in_w = q_field2cam_inv.rotateVectorByQuaternion(GVector::vector3d<double>(0,0,0) - translation);
-
-  // Compute the the point where the rays intersects the field
-  double t = GVector::ray_plane_intersect(GVector::vector3d<double>(0,0,z), GVector::vector3d<double>(0,0,1).norm(), zero_in_w, v_in_w.norm());
-
-  // Set p_f
-  p_f = zero_in_w + v_in_w.norm() * t;
+  getModel().image2field(p_f,p_i,z);
 }
 
 
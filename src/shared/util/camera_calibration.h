@@ -25,6 +25,7 @@
 #include <Eigen/Core>
 #include "field.h"
 #include "timer.h"
+#include "camera_model.h"
 
 #ifndef CAMERA_CALIBRATION_H
 #define CAMERA_CALIBRATION_H
@@ -78,7 +79,10 @@ public:
   //GVector::vector3d<double> translation;  
   
   AdditionalCalibrationInformation* additional_calibration_information;
-  
+
+  /// a plain copy of the current parameters, for the detection code
+  CameraModel getModel() const;
+
   void field2image(const GVector::vector3d<double> &p_f, GVector::vector2d<double> &p_i) const;
   void image2field(GVector::vector3d<double> &p_f, GVector::vector2d<double> &p_i, double z) const;
   void calibrate(std::vector<GVector::vector3d<double> > &p_f, std::vector<GVector::vector2d<double> > &p_i, int cal_type);
@@ -0,0 +1,157 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    camera_model.cpp
+  \brief   C++ Implementation: CameraModel
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "camera_model.h"
+#include <float.h>
+
+CameraModel::CameraModel()
+{
+  //the defaults of CameraParameters:
+  focal_length=500.0;
+  principal_point_x=390.0;
+  principal_point_y=290.0;
+  distortion=0.0;
+  q0=0.7;
+  q1=-0.7;
+  q2=0.0;
+  q3=0.0;
+  tx=0.0;
+  ty=1250.0;
+  tz=3500.0;
+}
+
+double CameraModel::radialDistortion(double ru) const
+{
+  return radialDistortion(ru,distortion);
+}
+
+double CameraModel::radialDistortion(double ru, double dist)
+{
+  if(dist<=DBL_MIN)
+    return ru;
+  double rd = 0;
+  double a = dist;
+  double b = -9.0*a*a*ru + a*sqrt(a*(12.0 + 81.0*a*ru*ru));
+  //Pre-computing numerical constants to optimize for speed...
+  //b = b<0.0?-pow(b,1.0/3.0):pow(b,1.0/3.0);
+  //rd = pow(2.0/3.0,1.0/3.0)/b - b/(pow(2.0*3.0*3.0,1.0/3.0)*a);
+  b = b<0.0?-pow(-b,0.33333333333333333333333333333333333333333333333333):pow(b,0.33333333333333333333333333333333333333333333333333);
+  rd = 0.87358046473629886904722042681399875674647588190788/b - b/(2.62074139420889660714166128044199627023942764572363*a);
+  return rd;
+}
+
+double CameraModel::radialDistortionInv(double rd) const
+{
+  double ru = rd*(1.0+rd*rd*distortion);
+  return ru;
+}
+
+void CameraModel::radialDistortionInv(GVector::vector2d<double> &pu, const GVector::vector2d<double> &pd) const
+{
+  double ru = radialDistortionInv(pd.length());
+  pu = pd;
+  pu = pu.norm(ru);
+}
+
+void CameraModel::radialDistortion(const GVector::vector2d<double> pu, GVector::vector2d<double> &pd) const
+{
+  double rd = radialDistortion(pu.length());
+  pd = pu;
+  pd = pd.norm(rd);
+}
+
+void CameraModel::field2image(const GVector::vector3d<double> &p_f, GVector::vector2d<double> &p_i) const
+{
+  Quaternion<double> q_field2cam = Quaternion<double>(q0,q1,q2,q3);
+  q_field2cam.norm();
+  GVector::vector3d<double> translation = GVector::vector3d<double>(tx,ty,tz);
+
+  // First transform the point from the field into the coordinate system of the camera
+  GVector::vector3d<double> p_c = q_field2cam.rotateVectorByQuaternion(p_f) + translation;
+  GVector::vector2d<double> p_un = GVector::vector2d<double>(p_c.x/p_c.z, p_c.y/p_c.z);
+
+  // Apply distortion
+  GVector::vector2d<double> p_d;
+  radialDistortion(p_un,p_d);
+
+  // Then project from the camera coordinate system onto the image plane using the instrinsic parameters
+  p_i = focal_length * p_d + GVector::vector2d<double>(principal_point_x, principal_point_y);
+}
+
+void CameraModel::image2field(GVector::vector3d<double> &p_f, const GVector::vector2d<double> &p_i, double z) const
+{
+  // Undo scaling and offset
+  GVector::vector2d<double> p_d((p_i.x - principal_point_x) / focal_length,
+                                (p_i.y - principal_point_y) / focal_length);
+
+  // Compensate for distortion (undistort)
+  GVector::vector2d<double> p_un;
+  radialDistortionInv(p_un,p_d);
+
+  // Now we got a ray on the z axis
+  GVector::vector3d<double> v(p_un.x, p_un.y, 1);
+
+  // Transform this ray into world coordinates
+  Quaternion<double> q_field2cam = Quaternion<double>(q0,q1,q2,q3);
+  q_field2cam.norm();
+  GVector::vector3d<double> translation = GVector::vector3d<double>(tx,ty,tz);
+
+  Quaternion<double> q_field2cam_inv = q_field2cam;
+  q_field2cam_inv.invert();
+  GVector::vector3d<double> v_in_w = q_field2cam_inv.rotateVectorByQuaternion(v);
+  GVector::vector3d<double> zero_in_w = q_field2cam_inv.rotateVectorByQuaternion(GVector::vector3d<double>(0,0,0) - translation);
+
+  // Compute the the point where the rays intersects the field
+  double t = GVector::ray_plane_intersect(GVector::vector3d<double>(0,0,z), GVector::vector3d<double>(0,0,1).norm(), zero_in_w, v_in_w.norm());
+
+  // Set p_f
+  p_f = zero_in_w + v_in_w.norm() * t;
+}
+
+#ifndef NO_PROTOBUFFERS
+void CameraModel::toProtoBuffer(SSL_GeometryCameraCalibration & buffer, int camera_id) const {
+  buffer.set_focal_length(focal_length);
+  buffer.set_principal_point_x(principal_point_x);
+  buffer.set_principal_point_y(principal_point_y);
+  buffer.set_distortion(distortion);
+  buffer.set_q0(q0);
+  buffer.set_q1(q1);
+  buffer.set_q2(q2);
+  buffer.set_q3(q3);
+  buffer.set_tx(tx);
+  buffer.set_ty(ty);
+  buffer.set_tz(tz);
+  buffer.set_camera_id(camera_id);
+
+  //--Set derived parameters:
+  //compute camera world coordinates:
+  Quaternion<double> q;
+  q.set(q0,q1,q2,q3);
+  q.invert();
+
+  GVector::vector3d<double> v_in(tx,ty,tz);
+  v_in=(-(v_in));
+
+  GVector::vector3d<double> v_out = q.rotateVectorByQuaternion(v_in);
+  buffer.set_derived_camera_world_tx(v_out.x);
+  buffer.set_derived_camera_world_ty(v_out.y);
+  buffer.set_derived_camera_world_tz(v_out.z);
+}
+#endif
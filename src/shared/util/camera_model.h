@@ -0,0 +1,75 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    camera_model.h
+  \brief   C++ Interface: CameraModel
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef CAMERA_MODEL_H
+#define CAMERA_MODEL_H
+#include "geometry.h"
+#include "quaternion.h"
+#ifndef NO_PROTOBUFFERS
+  #include "messages_robocup_ssl_geometry.pb.h"
+#endif
+
+/*!
+  \class CameraModel
+
+  \brief The projection between image and field of a calibrated camera
+
+  A plain copy of the intrinsic and extrinsic parameters of
+  CameraParameters, which keeps them in VarTypes and fits them during
+  calibration. The detection code takes a CameraModel, so that a frame is
+  processed with one consistent set of parameters that are read once.
+**/
+class CameraModel
+{
+public:
+  double focal_length;
+  double principal_point_x;
+  double principal_point_y;
+  double distortion;
+
+  //rotation from field to camera coordinates:
+  double q0;
+  double q1;
+  double q2;
+  double q3;
+
+  //translation from field to camera coordinates:
+  double tx;
+  double ty;
+  double tz;
+
+  CameraModel();
+
+  void field2image(const GVector::vector3d<double> &p_f, GVector::vector2d<double> &p_i) const;
+  void image2field(GVector::vector3d<double> &p_f, const GVector::vector2d<double> &p_i, double z) const;
+
+  double radialDistortion(double ru) const;  //apply radial distortion to (undistorted) radius ru and return distorted radius
+  double radialDistortionInv(double rd) const;  //invert radial distortion from (distorted) radius rd and return undistorted radius
+  void radialDistortionInv(GVector::vector2d<double> &pu, const GVector::vector2d<double> &pd) const;
+  void radialDistortion(const GVector::vector2d<double> pu, GVector::vector2d<double> &pd) const;
+
+  static double radialDistortion(double ru, double dist);
+
+  #ifndef NO_PROTOBUFFERS
+  void toProtoBuffer(SSL_GeometryCameraCalibration & buffer, int camera_id) const;
+  #endif
+};
+
+#endif
@@ -24,6 +24,9 @@
 
 
 #include "conversions.h"
+#ifndef NO_DC1394_CONVERSIONS
+  #include <dc1394/conversions.h>
+#endif
 
 using namespace std;
 // The following #define is there for the users who experience green/purple
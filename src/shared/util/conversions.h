@@ -24,9 +24,6 @@
 
 #include "util.h"
 #include "colors.h"
-#ifndef NO_DC1394_CONVERSIONS
-  #include <dc1394/conversions.h>
-#endif
 
 //#include "ccvt.h"
 
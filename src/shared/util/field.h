@@ -22,6 +22,7 @@
 #ifndef FIELD_H
 #define FIELD_H
 #include "field_default_constants.h"
+#include "field_filter.h"
 
 #include "VarTypes.h"
 #include <QObject>
@@ -82,6 +83,13 @@ public:
   VarInt * half_field_total_surface_length;
   VarInt * half_field_total_surface_width;
 
+  ///copy the dimensions that the detection code filters by into \p filter
+  void updateFilter(FieldFilter & filter) const {
+    filter.set((double)(half_field_length->getInt()), (double)(half_field_width->getInt()),
+               (double)(half_goal_width->getInt()), (double)(goal_depth->getInt()),
+               (double)(boundary_width->getInt()));
+  }
+
   #ifndef NO_PROTOBUFFERS
   void toProtoBuffer(SSL_GeometryFieldSize & buffer) const {
     buffer.set_line_width(line_width->getInt());
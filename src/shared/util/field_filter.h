@@ -22,7 +22,7 @@
 #ifndef FIELD_FILTER_H
 #define FIELD_FILTER_H
 
-#include "field.h"
+#include "geometry.h"
 
 /*!
   \class Field Filter
@@ -49,32 +49,33 @@ public:
     boundary_width=0.0;
   }
 
-  void update(const RoboCupField & field) {
-    half_field_width  = (double)(field.half_field_width->getInt());
-    half_field_length = (double)(field.half_field_length->getInt());
-    half_goal_width   = (double)(field.half_goal_width->getInt());
-    goal_depth   = (double)(field.goal_depth->getInt());
-    boundary_width = (double)(field.boundary_width->getInt());
+  ///set the field dimensions in mm, see RoboCupField::updateFilter()
+  void set(double _half_field_length, double _half_field_width, double _half_goal_width, double _goal_depth, double _boundary_width) {
+    half_field_length = _half_field_length;
+    half_field_width  = _half_field_width;
+    half_goal_width   = _half_goal_width;
+    goal_depth        = _goal_depth;
+    boundary_width    = _boundary_width;
   }
 
   ///check whether a point is within the legal field or the boundary (but not the referee walking area)
-  bool isInFieldOrPlayableBoundary(const vector2d & pos) {
+  bool isInFieldOrPlayableBoundary(const vector2d & pos) const {
     return (fabs(pos.x) <= (half_field_length+boundary_width) &&  fabs(pos.y) <= (half_field_width+boundary_width));
   }
 
   ///check whether a point is within the legal field (excluding all boundary areas) plus some threshold
-  bool isInFieldPlusThreshold(const vector2d & pos, double threshold) {
+  bool isInFieldPlusThreshold(const vector2d & pos, double threshold) const {
     return (fabs(pos.x) <= (half_field_length+threshold) &&  fabs(pos.y) <= (half_field_width+threshold));
   }
 
   ///check whether a point is within the legal field (excluding all boundary areas)
-  bool isInField(const vector2d & pos) {
+  bool isInField(const vector2d & pos) const {
     return (fabs(pos.x) <= half_field_length && fabs(pos.y) <= half_field_width);
   }
 
   ///checks whether a point is very far in the goal (more than half-way)
   ///this is mostly used for vision filtering
-  bool isFarInGoal(const vector2d & pos) {
+  bool isFarInGoal(const vector2d & pos) const {
     return (fabs(pos.y) < half_goal_width &&
             fabs(pos.x) > half_field_length + (goal_depth/2));
   }
@@ -28,13 +28,13 @@
 #ifdef IMAGE_IO_USE_LIBPNG
   #include "png.h"
 #endif
-#include <QColor>
 
 /*!
   \class ImageIO
   \brief A class containing helper functions for reading and writing image data to/from files
 
-  This class relies on QT4's image i/o functions
+  This class relies on QT4's image i/o functions.
+  Qt is only used in the implementation, QRgb pixels are passed as unsigned int.
 
 */
 class ImageIO {
@@ -44,10 +44,10 @@ protected:
   static void copyBGRtoRGBA(rgba * dst,unsigned char * src,unsigned int size);
   static void copyRGBtoRGBA(rgba * dst,unsigned char * src,unsigned int size);
   static void copyBGRAtoRGB(rgb * dst,unsigned char * src,unsigned int size);
-  static void copyQRGBtoRGB(rgb * dst,QRgb * src,unsigned int size);
-  static void copyQRGBtoRGBA(rgba * dst,QRgb * src,unsigned int size);
-  static void copyRGBtoQRGB(QRgb * dst, rgb * src,unsigned int size);
-  static void copyRGBAtoQRGB(QRgb * dst, rgba * src,unsigned int size);
+  static void copyQRGBtoRGB(rgb * dst,unsigned int * src,unsigned int size);
+  static void copyQRGBtoRGBA(rgba * dst,unsigned int * src,unsigned int size);
+  static void copyRGBtoQRGB(unsigned int * dst, rgb * src,unsigned int size);
+  static void copyRGBAtoQRGB(unsigned int * dst, rgba * src,unsigned int size);
   static void copyARGBtoRGB(rgb * dst,unsigned char * src,unsigned int size);
   static void copyARGBtoRGBA(rgba * dst,unsigned char * src,unsigned int size);
   #ifdef IMAGE_IO_USE_LIBPNG
@@ -43,6 +43,7 @@ public:
     void addShortOptSwitch( char s, const QString &lname, bool *b, bool def=false);
 
     // options (with arguments, sometimes optional)
+    // the add*() functions reset *v, so defaults are applied after parse()
     void addOption( char s, const QString &l, QString *v );
     void addVarLengthOption( const QString &l, QStringList *v );
     void addRepeatableOption( char s, QStringList *v );
@@ -0,0 +1,111 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    rawframe_file.cpp
+  \brief   C++ Implementation: RawFrameFile
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "rawframe_file.h"
+#include <string.h>
+
+const char * RawFrameFile::MAGIC="SSLRAWF1";
+
+RawFrameFile::RawFrameFile()
+{
+  f=0;
+  writing=false;
+}
+
+RawFrameFile::~RawFrameFile()
+{
+  close();
+}
+
+bool RawFrameFile::openRead(const char * filename) {
+  close();
+  if ((f=fopen(filename,"rb"))==0) {
+    fprintf(stderr,"Unable to open raw frame file %s\n",filename);
+    return false;
+  }
+  char magic[8];
+  if (fread(magic,1,8,f)!=8 || memcmp(magic,MAGIC,8)!=0) {
+    fprintf(stderr,"%s is not a raw frame file\n",filename);
+    close();
+    return false;
+  }
+  writing=false;
+  return true;
+}
+
+bool RawFrameFile::openWrite(const char * filename) {
+  close();
+  if ((f=fopen(filename,"wb"))==0) {
+    fprintf(stderr,"Unable to create raw frame file %s\n",filename);
+    return false;
+  }
+  if (fwrite(MAGIC,1,8,f)!=8) {
+    fprintf(stderr,"Unable to write raw frame file %s\n",filename);
+    close();
+    return false;
+  }
+  writing=true;
+  return true;
+}
+
+void RawFrameFile::close() {
+  if (f!=0) fclose(f);
+  f=0;
+}
+
+bool RawFrameFile::isOpen() const {
+  return (f!=0);
+}
+
+bool RawFrameFile::readFrame(RawImage & img, int & camera_id) {
+  if (f==0 || writing) return false;
+  Header h;
+  if (fread(&h,sizeof(h),1,f)!=1) return false;
+  ColorFormat fmt=(ColorFormat)h.color_format;
+  if (h.width <= 0 || h.height <= 0 || h.data_bytes!=RawImage::computeImageSize(fmt,h.width*h.height)) {
+    fprintf(stderr,"Damaged raw frame record (%dx%d, %d bytes)\n",h.width,h.height,h.data_bytes);
+    return false;
+  }
+  img.ensure_allocation(fmt,h.width,h.height);
+  if (fread(img.getData(),1,h.data_bytes,f)!=(size_t)h.data_bytes) {
+    fprintf(stderr,"Truncated raw frame record\n");
+    return false;
+  }
+  img.setTime(h.time);
+  camera_id=h.camera_id;
+  return true;
+}
+
+bool RawFrameFile::writeFrame(const RawImage & img, int camera_id) {
+  if (f==0 || writing==false || img.getData()==0) return false;
+  Header h;
+  memset(&h,0,sizeof(h));
+  h.camera_id=camera_id;
+  h.color_format=img.getColorFormat();
+  h.width=img.getWidth();
+  h.height=img.getHeight();
+  h.data_bytes=img.getNumBytes();
+  h.time=img.getTime();
+  if (fwrite(&h,sizeof(h),1,f)!=1 || fwrite(img.getData(),1,h.data_bytes,f)!=(size_t)h.data_bytes) {
+    fprintf(stderr,"Unable to write raw frame\n");
+    return false;
+  }
+  return true;
+}
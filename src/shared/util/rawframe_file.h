@@ -0,0 +1,67 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    rawframe_file.h
+  \brief   C++ Interface: RawFrameFile
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef RAWFRAME_FILE_H
+#define RAWFRAME_FILE_H
+#include <stdio.h>
+#include <stdint.h>
+#include "rawimage.h"
+
+/*!
+  \class   RawFrameFile
+  \brief   A container of uncompressed video frames, as delivered by the capture drivers
+
+  The file starts with the 8 byte magic "SSLRAWF1", followed by one record per
+  frame: a RawFrameFile::Header and data_bytes bytes of image data in the
+  header's color format. All fields are stored in host byte order.
+*/
+class RawFrameFile {
+public:
+  class Header {
+    public:
+    int32_t camera_id;
+    int32_t color_format; //a ColorFormat
+    int32_t width;
+    int32_t height;
+    int32_t data_bytes;
+    int32_t reserved;
+    double time;          //capture time as reported by the driver
+  };
+  static const char * MAGIC;
+protected:
+  FILE * f;
+  bool writing;
+public:
+  RawFrameFile();
+  ~RawFrameFile();
+
+  bool openRead(const char * filename);
+  bool openWrite(const char * filename);
+  void close();
+  bool isOpen() const;
+
+  /// reads the next frame into \p img, reallocating it as needed.
+  /// returns false at the end of the file or on a damaged record.
+  bool readFrame(RawImage & img, int & camera_id);
+
+  bool writeFrame(const RawImage & img, int camera_id);
+};
+
+#endif
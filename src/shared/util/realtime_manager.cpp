@@ -0,0 +1,251 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    realtime_manager.cpp
+  \brief   C++ Implementation: realtime_manager
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "realtime_manager.h"
+#include <math.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+LatencyHistogram::LatencyHistogram() {
+  clear();
+}
+
+void LatencyHistogram::clear() {
+  memset(buckets,0,sizeof(buckets));
+  count=0;
+  sum=0.0;
+  max=0.0;
+}
+
+double LatencyHistogram::bucketUpperBound(int bucket) {
+  return pow(2.0,bucket/4.0)*1.0E-6;
+}
+
+void LatencyHistogram::add(double seconds) {
+  if (seconds < 0.0) seconds=0.0;
+  double us=seconds*1.0E6;
+  int bucket=0;
+  if (us > 1.0) bucket=(int)ceil(log2(us)*4.0);
+  if (bucket >= BUCKETS) bucket=BUCKETS-1;
+  buckets[bucket]++;
+  count++;
+  sum+=seconds;
+  if (seconds > max) max=seconds;
+}
+
+double LatencyHistogram::percentile(double p) const {
+  if (count==0) return 0.0;
+  long long target=(long long)ceil(p*(double)count);
+  if (target < 1) target=1;
+  long long n=0;
+  for (int i=0;i<BUCKETS;i++) {
+    n+=buckets[i];
+    if (n >= target) {
+      double bound=bucketUpperBound(i);
+      return (bound < max ? bound : max);
+    }
+  }
+  return max;
+}
+
+double LatencyHistogram::mean() const {
+  return (count==0 ? 0.0 : sum/(double)count);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram & other) {
+  for (int i=0;i<BUCKETS;i++) {
+    buckets[i]+=other.buckets[i];
+  }
+  count+=other.count;
+  sum+=other.sum;
+  if (other.max > max) max=other.max;
+}
+
+void LatencyHistogram::print(FILE * f, const char * label) const {
+  if (count==0) {
+    fprintf(f,"    %-20s no samples\n",label);
+    return;
+  }
+  fprintf(f,"    %-20s n=%lld  mean %.3fms  p50 %.3fms  p90 %.3fms  p99 %.3fms  p99.9 %.3fms  max %.3fms\n",
+    label,count,mean()*1.0E3,percentile(0.5)*1.0E3,percentile(0.9)*1.0E3,percentile(0.99)*1.0E3,percentile(0.999)*1.0E3,max*1.0E3);
+}
+
+RealTimeManager::ThreadStats::ThreadStats(const string & _name) {
+  name=_name;
+  priority=0;
+  realtime=false;
+  inversions=0;
+  worst_inversion=0.0;
+  prefaulted_bytes=0;
+  minor_faults=0;
+  major_faults=0;
+  steady=false;
+}
+
+void RealTimeManager::ThreadStats::lockWaited(double seconds, const char * lock, double inversion_threshold) {
+  lock_wait.add(seconds);
+  //only the capture thread itself runs at real-time priority, so whoever
+  //held the lock for this long had a lower priority than we do:
+  if (realtime && seconds > inversion_threshold) {
+    inversions++;
+    if (seconds > worst_inversion) {
+      worst_inversion=seconds;
+      worst_inversion_lock=lock;
+    }
+  }
+}
+
+void RealTimeManager::ThreadStats::beginSteadyState() {
+  long minor, major;
+  if (getThreadFaults(minor,major)==false) return;
+  minor_faults=-minor;
+  major_faults=-major;
+  steady=true;
+}
+
+void RealTimeManager::ThreadStats::endSteadyState() {
+  long minor, major;
+  if (steady==false || getThreadFaults(minor,major)==false) return;
+  minor_faults+=minor;
+  major_faults+=major;
+}
+
+bool RealTimeManager::getThreadFaults(long & minor, long & major) {
+  struct rusage usage;
+  if (getrusage(RUSAGE_THREAD,&usage)!=0) return false;
+  minor=usage.ru_minflt;
+  major=usage.ru_majflt;
+  return true;
+}
+
+RealTimeManager::RealTimeManager(const Options & _options)
+{
+  _mutex=new pthread_mutex_t;
+  pthread_mutex_init((pthread_mutex_t*)_mutex, NULL);
+  options=_options;
+  if (options.capture_priorities.empty()) options.capture_priorities.push_back(Options().capture_priorities[0]);
+  memory_locked=false;
+}
+
+RealTimeManager::~RealTimeManager()
+{
+  for (unsigned int i=0;i<threads.size();i++) {
+    delete threads[i];
+  }
+  pthread_mutex_destroy((pthread_mutex_t*)_mutex);
+  delete _mutex;
+}
+
+bool RealTimeManager::parsePriorityList(const char * s, vector<int> & priorities) {
+  priorities.clear();
+  while (*s!=0) {
+    char * end;
+    long p=strtol(s,&end,10);
+    if (end==s || p < sched_get_priority_min(SCHED_FIFO) || p > sched_get_priority_max(SCHED_FIFO)) return false;
+    priorities.push_back((int)p);
+    s=end;
+    if (*s==',') {
+      s++;
+    } else if (*s!=0) {
+      return false;
+    }
+  }
+  return (priorities.empty()==false);
+}
+
+size_t RealTimeManager::prefault(void * data, size_t bytes) {
+  if (data==0 || bytes==0) return 0;
+  size_t page=(size_t)sysconf(_SC_PAGESIZE);
+  volatile unsigned char * p=(volatile unsigned char *)data;
+  //write back what we read, so that copy-on-write and zero-page mappings
+  //are resolved as well:
+  for (size_t i=0;i<bytes;i+=page) {
+    p[i]=p[i];
+  }
+  p[bytes-1]=p[bytes-1];
+  return bytes;
+}
+
+bool RealTimeManager::lockMemory() {
+  if (options.lock_memory==false) return false;
+  if (mlockall(MCL_CURRENT | MCL_FUTURE)!=0) {
+    fprintf(stderr,"Real-time: mlockall failed: %s\n",strerror(errno));
+    fprintf(stderr,"Real-time: raise the memlock limit (ulimit -l) or grant CAP_IPC_LOCK to lock memory.\n");
+    return false;
+  }
+  memory_locked=true;
+  return true;
+}
+
+RealTimeManager::ThreadStats * RealTimeManager::registerThread(const string & name) {
+  ThreadStats * stats=new ThreadStats(name);
+  DT_LOCK;
+  threads.push_back(stats);
+  DT_UNLOCK;
+  return stats;
+}
+
+bool RealTimeManager::demandCapturePriority(int camera, ThreadStats * stats) {
+  int idx=camera;
+  if (idx >= (int)options.capture_priorities.size()) idx=options.capture_priorities.size()-1;
+  if (idx < 0) idx=0;
+  struct sched_param param;
+  memset(&param,0,sizeof(param));
+  param.sched_priority=options.capture_priorities[idx];
+  int err=pthread_setschedparam(pthread_self(),SCHED_FIFO,&param);
+  if (stats!=0) stats->priority=param.sched_priority;
+  if (err!=0) {
+    fprintf(stderr,"Real-time: unable to set SCHED_FIFO priority %d for camera %d: %s\n",param.sched_priority,camera,strerror(err));
+    return false;
+  }
+  if (stats!=0) stats->realtime=true;
+  return true;
+}
+
+double RealTimeManager::getInversionThreshold() const {
+  return options.inversion_threshold;
+}
+
+void RealTimeManager::printReport(FILE * f) {
+  DT_LOCK;
+  fprintf(f,"Real-time latency report (memory %s):\n",(memory_locked ? "locked" : "NOT locked"));
+  for (unsigned int i=0;i<threads.size();i++) {
+    ThreadStats * s=threads[i];
+    if (s->realtime) {
+      fprintf(f,"  %s (SCHED_FIFO %d):\n",s->name.c_str(),s->priority);
+    } else {
+      fprintf(f,"  %s (SCHED_OTHER, real-time priority %d was denied):\n",s->name.c_str(),s->priority);
+    }
+    s->processing.print(f,"processing");
+    s->end_to_end.print(f,"end-to-end");
+    s->lock_wait.print(f,"lock waits");
+    if (s->inversions > 0) {
+      fprintf(f,"    priority inversions: %lld (worst %.3fms on '%s')\n",s->inversions,s->worst_inversion*1.0E3,s->worst_inversion_lock.c_str());
+    } else {
+      fprintf(f,"    priority inversions: 0\n");
+    }
+    fprintf(f,"    prefaulted: %.1fMB\n",(double)s->prefaulted_bytes/(1024.0*1024.0));
+    if (s->steady) {
+      fprintf(f,"    page faults after prefault: %ld minor, %ld major\n",s->minor_faults,s->major_faults);
+    }
+  }
+  DT_UNLOCK;
+}
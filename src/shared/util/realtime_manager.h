@@ -0,0 +1,158 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    realtime_manager.h
+  \brief   C++ Interface: realtime_manager
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef REALTIME_MANAGER_H
+#define REALTIME_MANAGER_H
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <string>
+#include <unistd.h>
+#include <sched.h>
+#include "pthread.h"
+#define DT_LOCK pthread_mutex_lock((pthread_mutex_t*)_mutex);
+#define DT_UNLOCK pthread_mutex_unlock((pthread_mutex_t*)_mutex);
+
+using namespace std;
+
+/*!
+  \class   LatencyHistogram
+  \brief   A fixed-size, allocation-free latency histogram
+
+  Buckets are spaced logarithmically (four buckets per octave, starting at 1us),
+  so percentiles are reported with an error of at most 19%.
+*/
+class LatencyHistogram {
+public:
+  static const int BUCKETS=112;
+protected:
+  long long buckets[BUCKETS];
+  static double bucketUpperBound(int bucket);
+public:
+  long long count;
+  double sum;
+  double max;
+  LatencyHistogram();
+  void clear();
+  /// adds a sample of \p seconds
+  void add(double seconds);
+  /// returns the upper bound of the \p p quantile (0.0 to 1.0) in seconds
+  double percentile(double p) const;
+  double mean() const;
+  /// adds all samples of \p other
+  void merge(const LatencyHistogram & other);
+  void print(FILE * f, const char * label) const;
+};
+
+/*!
+  \class   RealTimeManager
+  \brief   Opt-in real-time mode for the capture threads
+
+  The RealTimeManager:
+   - locks all current and future memory of the process (mlockall),
+   - switches the capture threads to SCHED_FIFO with a configurable priority
+     per camera (the GUI thread keeps the default scheduler),
+   - provides prefault(...) to touch buffers before the match starts,
+   - and collects per-thread latency statistics that are printed by
+     printReport() at shutdown.
+
+  QMutex does not support priority inheritance, so priority inversions can
+  not be prevented. They are detected instead: a real-time thread that
+  blocks on a stack mutex for longer than the inversion threshold is waiting
+  for a lower-priority thread (usually the GUI), which is counted and
+  reported per lock.
+*/
+class RealTimeManager {
+public:
+  /// real-time options, usually set from the command line
+  class Options {
+    public:
+    vector<int> capture_priorities; //SCHED_FIFO priority per camera. the last entry is used for all further cameras
+    bool lock_memory;               //call mlockall at startup
+    double inversion_threshold;     //blocked lock waits longer than this [s] are reported as priority inversions
+    Options() {
+      capture_priorities.push_back(80);
+      lock_memory=true;
+      inversion_threshold=0.0005;
+    }
+  };
+
+  /// statistics of one real-time thread. Each object is only written by its own thread.
+  class ThreadStats {
+    public:
+    string name;
+    int priority;
+    bool realtime;
+    LatencyHistogram processing; //from frame dequeue until the stack has finished the frame
+    LatencyHistogram end_to_end; //from the driver's frame timestamp until the stack has finished the frame
+    LatencyHistogram lock_wait;  //time spent blocked on a contended stack mutex
+    long long inversions;
+    double worst_inversion;
+    string worst_inversion_lock;
+    long long prefaulted_bytes;
+    long minor_faults;
+    long major_faults;
+    bool steady;
+    ThreadStats(const string & _name);
+    /// records a blocked wait of \p seconds for the lock named \p lock
+    void lockWaited(double seconds, const char * lock, double inversion_threshold);
+    /// starts counting page faults of the calling thread
+    void beginSteadyState();
+    /// stops counting page faults of the calling thread
+    void endSteadyState();
+  };
+
+protected:
+  pthread_mutex_t * _mutex;
+  Options options;
+  bool memory_locked;
+  vector<ThreadStats *> threads;
+  static bool getThreadFaults(long & minor, long & major);
+public:
+  /// parses a priority list such as "80,70"
+  static bool parsePriorityList(const char * s, vector<int> & priorities);
+
+  /// touches every page of [\p data, \p data + \p bytes) so that it is resident.
+  /// the contents are not modified. Returns the number of bytes touched.
+  static size_t prefault(void * data, size_t bytes);
+
+  /// locks all current and future pages of the process into RAM
+  bool lockMemory();
+
+  /// creates the statistics of a new real-time thread
+  ThreadStats * registerThread(const string & name);
+
+  /// switches the calling camera thread to SCHED_FIFO
+  bool demandCapturePriority(int camera, ThreadStats * stats);
+
+  double getInversionThreshold() const;
+
+  /// prints the latency report of all registered threads.
+  /// all real-time threads need to be stopped before calling this.
+  void printReport(FILE * f=stdout);
+
+  RealTimeManager(const Options & _options=Options());
+
+  ~RealTimeManager();
+
+};
+
+#endif
@@ -0,0 +1,164 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    tracer.cpp
+  \brief   C++ Implementation: Tracer
+  \author  Author Name, 2026
+*/
+//========================================================================
+#include "tracer.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <vector>
+
+volatile int Tracer::enabled=0;
+
+static pthread_mutex_t trace_mutex=PTHREAD_MUTEX_INITIALIZER;
+static vector<TraceBuffer *> trace_buffers;
+static __thread TraceBuffer * trace_thread_buffer=0;
+static __thread char trace_thread_name[64]={0};
+
+//conversion of trace ticks to microseconds:
+static uint64_t trace_tick0=0;
+static double trace_ticks_per_us=0.0;
+
+TraceBuffer::TraceBuffer()
+{
+  head=0;
+  tid=(int)syscall(SYS_gettid);
+  thread_name[0]=0;
+}
+
+static double monotonicUSec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return (double)ts.tv_sec*1.0E6 + ts.tv_nsec*1.0E-3;
+}
+
+void Tracer::calibrate() {
+  //measure the tick rate against the monotonic clock over 20ms:
+  double t0=monotonicUSec();
+  uint64_t c0=now();
+  usleep(20000);
+  double t1=monotonicUSec();
+  uint64_t c1=now();
+  trace_tick0=c0;
+  trace_ticks_per_us=(double)(c1-c0)/(t1-t0);
+  if (trace_ticks_per_us <= 0.0) trace_ticks_per_us=1.0;
+}
+
+void Tracer::setEnabled(bool enable) {
+  pthread_mutex_lock(&trace_mutex);
+  if (enable && trace_ticks_per_us==0.0) calibrate();
+  enabled=(enable ? 1 : 0);
+  pthread_mutex_unlock(&trace_mutex);
+}
+
+TraceBuffer * Tracer::createBuffer() {
+  TraceBuffer * b=new TraceBuffer();
+  memcpy(b->thread_name,trace_thread_name,sizeof(b->thread_name));
+  pthread_mutex_lock(&trace_mutex);
+  trace_buffers.push_back(b);
+  pthread_mutex_unlock(&trace_mutex);
+  return b;
+}
+
+void Tracer::setThreadName(const string & name) {
+  strncpy(trace_thread_name,name.c_str(),sizeof(trace_thread_name)-1);
+  if (trace_thread_buffer!=0) {
+    pthread_mutex_lock(&trace_mutex);
+    memcpy(trace_thread_buffer->thread_name,trace_thread_name,sizeof(trace_thread_buffer->thread_name));
+    pthread_mutex_unlock(&trace_mutex);
+  }
+}
+
+void Tracer::add(const char * name, uint64_t begin, uint64_t end) {
+  //the buffer is only allocated once a thread records its first span:
+  if (trace_thread_buffer==0) trace_thread_buffer=createBuffer();
+  trace_thread_buffer->add(name,begin,end);
+}
+
+static void writeJSONString(FILE * f, const char * s) {
+  fputc('"',f);
+  for (;*s!=0;s++) {
+    if (*s=='"' || *s=='\\') {
+      fputc('\\',f);
+      fputc(*s,f);
+    } else if ((unsigned char)*s < 0x20) {
+      fputc(' ',f);
+    } else {
+      fputc(*s,f);
+    }
+  }
+  fputc('"',f);
+}
+
+bool Tracer::dump(const char * filename, double window) {
+  FILE * f=fopen(filename,"w");
+  if (f==0) {
+    fprintf(stderr,"Unable to write trace file %s\n",filename);
+    return false;
+  }
+  int pid=(int)getpid();
+  uint64_t t_now=now();
+  uint64_t t_min=0;
+  if (window > 0.0 && trace_ticks_per_us > 0.0) {
+    uint64_t w=(uint64_t)(window*1.0E6*trace_ticks_per_us);
+    if (w < t_now) t_min=t_now-w;
+  }
+  long long written=0;
+  vector<TraceBuffer::Event> copy;
+  fprintf(f,"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  pthread_mutex_lock(&trace_mutex);
+  bool first=true;
+  for (unsigned int i=0;i<trace_buffers.size();i++) {
+    TraceBuffer * b=trace_buffers[i];
+    fprintf(f,"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",(first ? "" : ",\n"),pid,b->tid);
+    writeJSONString(f,(b->thread_name[0]!=0 ? b->thread_name : "thread"));
+    fprintf(f,"}}");
+    first=false;
+
+    //copy the events, then drop whatever the owner overwrote meanwhile:
+    __sync_synchronize();
+    uint64_t h0=b->head;
+    uint64_t start=(h0 > TraceBuffer::SIZE ? h0-TraceBuffer::SIZE : 0);
+    copy.resize(h0-start);
+    for (uint64_t n=start;n<h0;n++) {
+      copy[n-start]=b->events[n & (TraceBuffer::SIZE-1)];
+    }
+    __sync_synchronize();
+    uint64_t h1=b->head;
+    uint64_t valid=(h1 >= TraceBuffer::SIZE ? h1-TraceBuffer::SIZE+1 : 0);
+    for (uint64_t n=start;n<h0;n++) {
+      if (n < valid) continue;
+      const TraceBuffer::Event & e=copy[n-start];
+      if (e.begin < t_min || e.begin < trace_tick0) continue;
+      fprintf(f,",\n{\"name\":");
+      writeJSONString(f,e.name);
+      fprintf(f,",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",pid,b->tid,
+        (double)(e.begin-trace_tick0)/trace_ticks_per_us,(double)(e.end-e.begin)/trace_ticks_per_us);
+      written++;
+    }
+  }
+  pthread_mutex_unlock(&trace_mutex);
+  fprintf(f,"\n]}\n");
+  fclose(f);
+  printf("Wrote %lld trace spans to %s\n",written,filename);
+  return true;
+}
@@ -0,0 +1,138 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    tracer.h
+  \brief   C++ Interface: Tracer
+  \author  Author Name, 2026
+*/
+//========================================================================
+#ifndef TRACER_H
+#define TRACER_H
+#include <stdint.h>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+#else
+  #include <time.h>
+#endif
+
+using namespace std;
+
+/*!
+  \class   TraceBuffer
+  \brief   The span ring-buffer of a single thread
+
+  Only the owning thread writes to a buffer. It publishes an event by
+  incrementing \p head after the event has been written, so a reader never
+  needs a lock; events that were overwritten while reading are dropped.
+*/
+class TraceBuffer {
+public:
+  class Event {
+    public:
+    const char * name;
+    uint64_t begin;
+    uint64_t end;
+  };
+  static const unsigned int SIZE=32768; //must be a power of two
+  Event events[SIZE];
+  volatile uint64_t head;
+  int tid;
+  char thread_name[64];
+  TraceBuffer();
+  void add(const char * name, uint64_t begin, uint64_t end) {
+    Event & e=events[head & (SIZE-1)];
+    e.name=name;
+    e.begin=begin;
+    e.end=end;
+#if defined(__x86_64__) || defined(__i386__)
+    //x86 does not reorder stores, so a compiler barrier is sufficient:
+    __asm__ __volatile__("" ::: "memory");
+#else
+    __sync_synchronize();
+#endif
+    head=head+1;
+  }
+};
+
+/*!
+  \class   Tracer
+  \brief   Low-overhead tracing of per-frame pipeline spans
+
+  Spans are recorded with TRACE_SPAN(name) into per-thread ring-buffers,
+  timestamped with the CPU's time-stamp counter. dump() writes the buffered
+  spans in the Chrome trace-event JSON format, which can be loaded in
+  Perfetto (ui.perfetto.dev) or chrome://tracing.
+
+  While tracing is disabled, a span costs a single load and branch.
+  Span names are not copied: they must stay valid until the last dump().
+*/
+class Tracer {
+protected:
+  static volatile int enabled;
+  static TraceBuffer * createBuffer();
+  static void calibrate();
+public:
+  static inline bool isEnabled() {
+    return (enabled!=0);
+  }
+  static void setEnabled(bool enable);
+
+  static inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (uint64_t)ts.tv_sec*1000000000ULL + ts.tv_nsec;
+#endif
+  }
+
+  /// names the calling thread in the trace
+  static void setThreadName(const string & name);
+
+  /// records a span of the calling thread
+  static void add(const char * name, uint64_t begin, uint64_t end);
+
+  /// writes all buffered spans of the last \p window seconds
+  /// (all buffered spans if \p window is 0) to \p filename.
+  /// this can be called while other threads keep tracing.
+  static bool dump(const char * filename, double window=0.0);
+};
+
+/*!
+  \class   TraceSpan
+  \brief   Records a span from its construction until its destruction
+*/
+class TraceSpan {
+protected:
+  const char * name;
+  uint64_t begin;
+public:
+  TraceSpan(const char * _name) {
+    name=_name;
+    begin=(Tracer::isEnabled() ? Tracer::now() : 0);
+  }
+  ~TraceSpan() {
+    if (begin!=0) Tracer::add(name,begin,Tracer::now());
+  }
+};
+
+#define TRACE_CONCAT_(a,b) a##b
+#define TRACE_CONCAT(a,b) TRACE_CONCAT_(a,b)
+/// traces the rest of the enclosing scope as a span called \p name
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(_trace_span_,__LINE__)(name)
+
+#endif
@@ -0,0 +1,70 @@
+//========================================================================
+//  This software is free: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License Version 3,
+//  as published by the Free Software Foundation.
+//
+//  This software is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  Version 3 in the file COPYING that came with this distribution.
+//  If not, see <http://www.gnu.org/licenses/>.
+//========================================================================
+/*!
+  \file    main.cpp
+  \brief   An example client of the shared-memory output
+  \author  Author Name, 2026
+*/
+//========================================================================
+
+#include <stdio.h>
+#include <unistd.h>
+#include "robocup_ssl_shm_client.h"
+#include "timer.h"
+
+#include "messages_robocup_ssl_detection.pb.h"
+#include "messages_robocup_ssl_geometry.pb.h"
+#include "messages_robocup_ssl_wrapper.pb.h"
+
+int main(int argc, char *argv[])
+{
+    //the name of the segment, as set in "Network Output/Shared Memory Name":
+    RoboCupSSLShmClient client(argc > 1 ? argv[1] : "/ssl-vision");
+    SSL_WrapperPacket packet;
+    long long dropped = 0;
+
+    while(true) {
+        if (client.isClosed()) {
+            if (client.open()==false) {
+                //vision is not running, or its shared memory output is disabled
+                sleep(1);
+                continue;
+            }
+            printf("Reading from shared memory %s\n", argc > 1 ? argv[1] : "/ssl-vision");
+        }
+        if (client.wait(1000)==false) continue;
+
+        while (client.receive(packet)) {
+            double t_now = GetTimeSec();
+            if (packet.has_detection()) {
+                const SSL_DetectionFrame & detection = packet.detection();
+                printf("Camera ID=%d FRAME=%d BALLS=%d BLUE=%d YELLOW=%d ",detection.camera_id(),detection.frame_number(),
+                       detection.balls_size(),detection.robots_blue_size(),detection.robots_yellow_size());
+                printf("Processing %7.3fms Transfer %7.3fms Total %7.3fms\n",(detection.t_sent()-detection.t_capture())*1000.0,
+                       (t_now-client.getPublishTime())*1000.0,(t_now-detection.t_capture())*1000.0);
+            }
+            if (packet.has_geometry()) {
+                const SSL_GeometryData & geom = packet.geometry();
+                printf("Geometry: field %dx%d (mm), %d camera calibration(s)\n",geom.field().field_length(),geom.field().field_width(),geom.calib_size());
+            }
+        }
+        if (client.getDropped()!=dropped) {
+            printf("Dropped %lld packet(s): the client was too slow\n",client.getDropped()-dropped);
+            dropped = client.getDropped();
+        }
+    }
+
+    return 0;
+}